@@ -0,0 +1,223 @@
+#pragma once
+
+#include "parsers/statistics.hpp"
+#include "parsers/thread_pool.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace alga {
+namespace statistics {
+
+/**
+ * @brief Tuning knobs for parallel_frequency_count
+ */
+struct parallel_count_options {
+    thread_pool* pool = nullptr;       // nullptr: default_thread_pool()
+    size_t parallel_threshold = 8192;  // Smaller inputs run on the caller only
+};
+
+/**
+ * @brief Count a random-access range on a thread pool
+ *
+ * Each thread of the pool counts one slice into a counter of its own,
+ * without any locking, and the partial counters are merged at the end.
+ * The result is the counter add_all would have built, so most_common and
+ * top_n agree with it exactly.
+ */
+template<typename Storage = void, std::ranges::random_access_range Range>
+auto parallel_frequency_count(Range const& elements, parallel_count_options const& options = {}) {
+    using T = std::ranges::range_value_t<Range>;
+    using storage_type = std::conditional_t<std::is_void_v<Storage>, flat_hash_map<T, size_t>, Storage>;
+    using counter_type = FrequencyCounter<T, storage_type>;
+
+    const size_t n = static_cast<size_t>(std::ranges::size(elements));
+    auto first = std::ranges::begin(elements);
+    auto count_slice = [&](counter_type& counter, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            counter.add(first[static_cast<std::ptrdiff_t>(i)]);
+        }
+    };
+
+    if (n == 0 || n < options.parallel_threshold) {
+        counter_type counter;
+        count_slice(counter, 0, n);
+        return counter;
+    }
+
+    thread_pool& pool = options.pool ? *options.pool : default_thread_pool();
+    const size_t slices = pool.concurrency();
+    const size_t grain = (n + slices - 1) / slices;
+    std::vector<counter_type> partial((n + grain - 1) / grain);
+    pool.parallel_for(n, grain, [&](size_t begin, size_t end) {
+        count_slice(partial[begin / grain], begin, end);
+    });
+
+    // Merge into the partial with the most distinct elements
+    auto largest = std::max_element(partial.begin(), partial.end(), [](auto const& a, auto const& b) {
+        return a.unique_count() < b.unique_count();
+    });
+    counter_type result = std::move(*largest);
+    for (auto& part : partial) {
+        if (&part != &*largest) result.merge(part);
+    }
+    return result;
+}
+
+/**
+ * @brief Frequency counter that many threads can add to at once
+ *
+ * Elements are spread over shards by hash, each shard a FrequencyCounter
+ * behind its own mutex on its own cache line, so threads adding different
+ * elements rarely wait for each other. Reads lock one shard (count) or
+ * each shard in turn (snapshot, most_common, top_n); snapshot() gives a
+ * sequential FrequencyCounter for the analysis functions.
+ *
+ * For a batch that is all available up front, parallel_frequency_count
+ * avoids the locks altogether.
+ */
+template<typename T, typename Storage = flat_hash_map<T, size_t>>
+class ConcurrentFrequencyCounter {
+public:
+    using counter_type = FrequencyCounter<T, Storage>;
+    using ranked_type = std::conditional_t<std::is_same_v<T, std::string_view>, std::string, T>;
+
+    /**
+     * @param shards Number of shards, rounded up to a power of two
+     */
+    explicit ConcurrentFrequencyCounter(size_t shards = 64)
+        : shard_mask(std::bit_ceil(std::max<size_t>(shards, 1)) - 1),
+          shard_array(std::make_unique<shard[]>(shard_mask + 1)) {}
+
+    ConcurrentFrequencyCounter(ConcurrentFrequencyCounter const&) = delete;
+    ConcurrentFrequencyCounter& operator=(ConcurrentFrequencyCounter const&) = delete;
+
+    /**
+     * @brief Add an element; safe to call from any number of threads
+     */
+    void add(const T& element) {
+        shard& s = shard_for(element);
+        std::lock_guard lock(s.mutex);
+        s.counter.add(element);
+    }
+
+    void add(const T& element, size_t n) {
+        shard& s = shard_for(element);
+        std::lock_guard lock(s.mutex);
+        s.counter.add(element, n);
+    }
+
+    void add_all(const std::vector<T>& elements) {
+        for (const auto& elem : elements) {
+            add(elem);
+        }
+    }
+
+    /**
+     * @brief Add a whole counter, say a thread's private one
+     */
+    template<typename OtherStorage>
+    void merge(const FrequencyCounter<T, OtherStorage>& other) {
+        for (const auto& [element, count] : other.get_counts()) {
+            add(element, count);
+        }
+    }
+
+    size_t count(const T& element) const {
+        shard& s = shard_for(element);
+        std::lock_guard lock(s.mutex);
+        return s.counter.count(element);
+    }
+
+    size_t total() const {
+        size_t sum = 0;
+        for_each_shard([&](counter_type const& c) { sum += c.total(); });
+        return sum;
+    }
+
+    size_t unique_count() const {
+        size_t sum = 0;
+        for_each_shard([&](counter_type const& c) { sum += c.unique_count(); });
+        return sum;
+    }
+
+    /**
+     * @brief All counts merged into a sequential counter
+     *
+     * Each shard is copied under its own lock, so adds that race with the
+     * snapshot may or may not be included.
+     */
+    counter_type snapshot() const {
+        counter_type merged;
+        merged.reserve(unique_count());
+        for_each_shard([&](counter_type const& c) { merged.merge(c); });
+        return merged;
+    }
+
+    /**
+     * @brief Ranked counts; string_view elements are returned as strings,
+     * since the views would point into the discarded snapshot
+     */
+    std::vector<std::pair<ranked_type, size_t>> most_common() const {
+        return owned(snapshot().most_common());
+    }
+
+    std::vector<std::pair<ranked_type, size_t>> top_n(size_t n) const {
+        return owned(snapshot().top_n(n));
+    }
+
+    void clear() {
+        for (size_t i = 0; i <= shard_mask; ++i) {
+            std::lock_guard lock(shard_array[i].mutex);
+            shard_array[i].counter.clear();
+        }
+    }
+
+private:
+    struct alignas(64) shard {
+        mutable std::mutex mutex;
+        counter_type counter;
+    };
+
+    shard& shard_for(const T& element) const {
+        // Use the high bits so shard choice is independent of the shard's own table
+        uint64_t h = static_cast<uint64_t>(std::hash<T>{}(element));
+        h *= 0x9e3779b97f4a7c15ULL;
+        return shard_array[(h >> 32) & shard_mask];
+    }
+
+    static std::vector<std::pair<ranked_type, size_t>> owned(std::vector<std::pair<T, size_t>> ranked) {
+        if constexpr (std::is_same_v<T, ranked_type>) {
+            return ranked;
+        } else {
+            std::vector<std::pair<ranked_type, size_t>> result;
+            result.reserve(ranked.size());
+            for (auto const& [element, count] : ranked) result.emplace_back(ranked_type(element), count);
+            return result;
+        }
+    }
+
+    template<typename F>
+    void for_each_shard(F&& f) const {
+        for (size_t i = 0; i <= shard_mask; ++i) {
+            std::lock_guard lock(shard_array[i].mutex);
+            f(shard_array[i].counter);
+        }
+    }
+
+    size_t shard_mask;
+    std::unique_ptr<shard[]> shard_array;
+};
+
+} // namespace statistics
+} // namespace alga
@@ -2,8 +2,10 @@
 
 #include "monadic_combinators.hpp"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
+#include <unordered_set>
 #include <regex>
 #include <sstream>
 
@@ -61,8 +63,12 @@ public:
         auto bigrams = generate_bigrams(*stems);
         auto trigrams = generate_trigrams(*stems);
         
-        // Step 4: Calculate statistics
-        std::set<porter2_stem> unique_stem_set(stems->begin(), stems->end());
+        // Step 4: Calculate statistics (views into stems, nothing copied or retained)
+        std::unordered_set<std::string_view> unique_stem_set;
+        unique_stem_set.reserve(stems->size());
+        for (auto const& stem : *stems) {
+            unique_stem_set.insert(stem.view());
+        }
         
         return SentenceAnalysis{
             *words,
@@ -0,0 +1,359 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace alga {
+
+/**
+ * @brief Bump allocator for string bytes
+ *
+ * Copies strings into large blocks and hands out views of the copies. The
+ * views stay valid until clear() or destruction, including across moves of
+ * the arena; nothing is freed individually.
+ */
+class string_arena {
+public:
+    explicit string_arena(size_t block_size = 64 * 1024) : block_size(std::max<size_t>(block_size, 1)) {}
+
+    // The source is left empty: its cursor would otherwise point into a
+    // block the target now owns
+    string_arena(string_arena&& other) noexcept
+        : blocks(std::move(other.blocks)), cursor(other.cursor), remaining(other.remaining),
+          block_size(other.block_size), bytes(other.bytes) {
+        other.reset();
+    }
+
+    string_arena& operator=(string_arena&& other) noexcept {
+        if (this != &other) {
+            blocks = std::move(other.blocks);
+            cursor = other.cursor;
+            remaining = other.remaining;
+            block_size = other.block_size;
+            bytes = other.bytes;
+            other.reset();
+        }
+        return *this;
+    }
+
+    string_arena(string_arena const&) = delete;
+    string_arena& operator=(string_arena const&) = delete;
+
+    /**
+     * @brief Copy s into the arena, returning a view of the copy
+     */
+    std::string_view store(std::string_view s) {
+        if (s.empty()) return {};
+        if (s.size() > block_size) {
+            // Oversized strings get a block of their own; the current block stays open
+            auto& block = blocks.emplace_back(std::make_unique_for_overwrite<char[]>(s.size()));
+            std::memcpy(block.get(), s.data(), s.size());
+            bytes += s.size();
+            return {block.get(), s.size()};
+        }
+        if (s.size() > remaining) {
+            cursor = blocks.emplace_back(std::make_unique_for_overwrite<char[]>(block_size)).get();
+            remaining = block_size;
+        }
+        std::memcpy(cursor, s.data(), s.size());
+        std::string_view stored(cursor, s.size());
+        cursor += s.size();
+        remaining -= s.size();
+        bytes += s.size();
+        return stored;
+    }
+
+    /**
+     * @brief Bytes of string data stored
+     */
+    size_t size() const { return bytes; }
+
+    void clear() { reset(); }
+
+private:
+    void reset() {
+        blocks.clear();
+        cursor = nullptr;
+        remaining = 0;
+        bytes = 0;
+    }
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char* cursor = nullptr;
+    size_t remaining = 0;
+    size_t block_size;
+    size_t bytes = 0;
+};
+
+/**
+ * @brief Open-addressing hash map with one control byte per slot
+ *
+ * Keys and values live in one flat array, so a lookup touches a control
+ * word and usually a single slot instead of following bucket and node
+ * pointers. As in Swiss tables, each slot's control byte is either empty
+ * or holds 7 bits of the key's hash; groups of 8 control bytes are tested
+ * against that tag in one 64-bit word, and keys are only compared where
+ * the tag matches. Groups are probed triangularly and the table grows at
+ * 7/8 load.
+ *
+ * Elements cannot be erased individually. Inserting may move elements, so
+ * references and iterators are invalidated by insertion, unlike
+ * std::unordered_map.
+ *
+ * With std::string_view keys the map owns its keys: each new key is
+ * copied into an internal string_arena, so callers may count views of
+ * short-lived buffers.
+ */
+template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class flat_hash_map {
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using size_type = size_t;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = flat_hash_map::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = value_type const*;
+        using reference = value_type const&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return map->slots[index]; }
+        pointer operator->() const { return map->slots + index; }
+
+        const_iterator& operator++() {
+            ++index;
+            skip_empty();
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const_iterator const& other) const { return index == other.index; }
+
+    private:
+        friend class flat_hash_map;
+
+        const_iterator(flat_hash_map const* m, size_t i) : map(m), index(i) { skip_empty(); }
+
+        void skip_empty() {
+            while (index < map->capacity && map->ctrl[index] == empty_ctrl) ++index;
+        }
+
+        flat_hash_map const* map = nullptr;
+        size_t index = 0;
+    };
+
+    flat_hash_map() = default;
+
+    flat_hash_map(flat_hash_map const& other) : hasher(other.hasher), equal(other.equal) {
+        reserve(other.used);
+        for (auto const& [key, value] : other) (*this)[key] = value;
+    }
+
+    flat_hash_map(flat_hash_map&& other) noexcept { swap(other); }
+
+    flat_hash_map& operator=(flat_hash_map other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~flat_hash_map() { release(); }
+
+    void swap(flat_hash_map& other) noexcept {
+        using std::swap;
+        swap(ctrl, other.ctrl);
+        swap(slots, other.slots);
+        swap(capacity, other.capacity);
+        swap(used, other.used);
+        swap(hasher, other.hasher);
+        swap(equal, other.equal);
+        swap(arena, other.arena);
+    }
+
+    /**
+     * @brief Value for key, value-initialized and inserted if absent
+     */
+    V& operator[](K const& key) {
+        const uint64_t h = hash_of(key);
+        size_t i = find_index(key, h);
+        if (i != npos) return slots[i].second;
+
+        if ((used + 1) * 8 > capacity * 7) rehash(capacity ? capacity * 2 : min_capacity);
+        i = free_index(h);
+        std::construct_at(slots + i, stored_key(key), V{});
+        ctrl[i] = tag_of(h);
+        ++used;
+        return slots[i].second;
+    }
+
+    const_iterator find(K const& key) const {
+        size_t i = find_index(key, hash_of(key));
+        return i == npos ? end() : const_iterator(this, i);
+    }
+
+    bool contains(K const& key) const { return find_index(key, hash_of(key)) != npos; }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, capacity); }
+
+    size_t size() const { return used; }
+    bool empty() const { return used == 0; }
+
+    /**
+     * @brief Make room for n elements without growing
+     */
+    void reserve(size_t n) {
+        size_t needed = min_capacity;
+        while (n * 8 > needed * 7) needed *= 2;
+        if (needed > capacity) rehash(needed);
+    }
+
+    /**
+     * @brief Remove every element, keeping the table's capacity
+     */
+    void clear() {
+        for (size_t i = 0; i < capacity; ++i) {
+            if (ctrl[i] != empty_ctrl) std::destroy_at(slots + i);
+        }
+        std::fill_n(ctrl.get(), capacity, empty_ctrl);
+        used = 0;
+        if constexpr (owns_keys) arena.clear();
+    }
+
+private:
+    static constexpr bool owns_keys = std::is_same_v<K, std::string_view>;
+    static constexpr uint8_t empty_ctrl = 0x80;
+    static constexpr size_t group_width = 8;
+    static constexpr size_t min_capacity = 16;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    static constexpr uint64_t low_bits = 0x0101010101010101ULL;
+    static constexpr uint64_t high_bits = 0x8080808080808080ULL;
+
+    struct no_arena {};
+
+    uint64_t hash_of(K const& key) const {
+        // Finalize, since std::hash of an integer is often the integer itself
+        uint64_t h = static_cast<uint64_t>(hasher(key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    static uint8_t tag_of(uint64_t h) { return static_cast<uint8_t>(h & 0x7f); }
+
+    // Control bytes of group g, byte i of the group in bits 8i..8i+7
+    uint64_t load_group(size_t g) const {
+        uint64_t word = 0;
+        for (size_t i = 0; i < group_width; ++i) {
+            word |= static_cast<uint64_t>(ctrl[g * group_width + i]) << (8 * i);
+        }
+        return word;
+    }
+
+    // 0x80 in every byte of the group equal to tag
+    static uint64_t match_tag(uint64_t group, uint8_t tag) {
+        uint64_t x = group ^ (low_bits * tag);
+        return ~(((x & ~high_bits) + ~high_bits) | x | ~high_bits);
+    }
+
+    size_t find_index(K const& key, uint64_t h) const {
+        if (used == 0) return npos;
+        const size_t group_mask = capacity / group_width - 1;
+        const uint8_t tag = tag_of(h);
+        size_t g = (h >> 7) & group_mask;
+        for (size_t step = 1;; ++step) {
+            uint64_t group = load_group(g);
+            for (uint64_t m = match_tag(group, tag); m != 0; m &= m - 1) {
+                size_t i = g * group_width + static_cast<size_t>(std::countr_zero(m)) / 8;
+                if (equal(slots[i].first, key)) return i;
+            }
+            // Nothing is erased, so an empty slot ends every probe chain through it
+            if (group & high_bits) return npos;
+            g = (g + step) & group_mask;
+        }
+    }
+
+    // First empty slot on h's probe sequence; the table is never full
+    size_t free_index(uint64_t h) const {
+        const size_t group_mask = capacity / group_width - 1;
+        size_t g = (h >> 7) & group_mask;
+        for (size_t step = 1;; ++step) {
+            uint64_t empty = load_group(g) & high_bits;
+            if (empty) return g * group_width + static_cast<size_t>(std::countr_zero(empty)) / 8;
+            g = (g + step) & group_mask;
+        }
+    }
+
+    K stored_key(K const& key) {
+        if constexpr (owns_keys) {
+            return arena.store(key);
+        } else {
+            return key;
+        }
+    }
+
+    // Strong guarantee, as for std::unordered_map: everything that can throw
+    // (allocation and hashing) happens before the table is touched, and
+    // elements are then moved over, which is assumed not to throw
+    void rehash(size_t new_capacity) {
+        auto new_ctrl = std::make_unique_for_overwrite<uint8_t[]>(new_capacity);
+        std::fill_n(new_ctrl.get(), new_capacity, empty_ctrl);
+        auto hashes = std::make_unique_for_overwrite<uint64_t[]>(capacity);
+        for (size_t i = 0; i < capacity; ++i) {
+            if (ctrl[i] != empty_ctrl) hashes[i] = hash_of(slots[i].first);
+        }
+        value_type* new_slots = std::allocator<value_type>{}.allocate(new_capacity);
+
+        std::unique_ptr<uint8_t[]> old_ctrl = std::exchange(ctrl, std::move(new_ctrl));
+        value_type* old_slots = std::exchange(slots, new_slots);
+        size_t old_capacity = std::exchange(capacity, new_capacity);
+
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (old_ctrl[i] == empty_ctrl) continue;
+            size_t j = free_index(hashes[i]);
+            std::construct_at(slots + j, std::move(old_slots[i]));
+            ctrl[j] = tag_of(hashes[i]);
+            std::destroy_at(old_slots + i);
+        }
+        if (old_slots) std::allocator<value_type>{}.deallocate(old_slots, old_capacity);
+    }
+
+    void release() {
+        if (!slots) return;
+        for (size_t i = 0; i < capacity; ++i) {
+            if (ctrl[i] != empty_ctrl) std::destroy_at(slots + i);
+        }
+        std::allocator<value_type>{}.deallocate(slots, capacity);
+        slots = nullptr;
+    }
+
+    std::unique_ptr<uint8_t[]> ctrl;
+    value_type* slots = nullptr;
+    size_t capacity = 0;  // Power of two, at least min_capacity once allocated
+    size_t used = 0;
+    [[no_unique_address]] Hash hasher;
+    [[no_unique_address]] KeyEqual equal;
+    [[no_unique_address]] std::conditional_t<owns_keys, string_arena, no_arena> arena;
+};
+
+} // namespace alga
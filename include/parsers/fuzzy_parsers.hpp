@@ -1,18 +1,71 @@
 #pragma once
 
 #include "parsers/similarity.hpp"
+#include "parsers/levenshtein_trie.hpp"
+#include "parsers/symspell_index.hpp"
 #include "parsers/phonetic.hpp"
 #include <string>
 #include <string_view>
 #include <optional>
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <cctype>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <unordered_set>
 
 namespace alga {
 namespace fuzzy {
 
+namespace detail {
+
+inline bool is_word_char(char c) {
+    return std::isalpha(static_cast<unsigned char>(c)) != 0;
+}
+
+// End of the run of letters starting at begin
+template<typename Iterator>
+Iterator word_end(Iterator begin, Iterator end) {
+    return std::find_if_not(begin, end, is_word_char);
+}
+
+// The word at begin, as a view into the input when the iterators are
+// contiguous and as a string otherwise; matchers only copy it into their
+// std::string result once it is accepted
+template<typename Iterator>
+auto scan_word(Iterator begin, Iterator end) {
+    Iterator last = word_end(begin, end);
+    if constexpr (std::contiguous_iterator<Iterator>) {
+        using result_type = std::optional<std::string_view>;
+        if (last == begin) return std::pair<Iterator, result_type>{begin, std::nullopt};
+        return std::pair<Iterator, result_type>{
+            last, std::string_view(std::to_address(begin), static_cast<size_t>(last - begin))};
+    } else {
+        using result_type = std::optional<std::string>;
+        if (last == begin) return std::pair<Iterator, result_type>{begin, std::nullopt};
+        return std::pair<Iterator, result_type>{last, std::string(begin, last)};
+    }
+}
+
+inline bool equals_ignore_case(std::string_view a, std::string_view b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               return phonetic::detail::upper(x) == phonetic::detail::upper(y);
+           });
+}
+
+} // namespace detail
+
 /**
  * @brief Word parser for use with fuzzy matching
+ *
+ * Returns an owned copy of the word, made in one allocation. Use
+ * WordViewParser to avoid the copy when the input outlives the result.
  */
 class WordParser {
 public:
@@ -22,19 +75,12 @@ public:
     auto parse(Iterator begin, Iterator end) const
         -> std::pair<Iterator, std::optional<std::string>>
     {
-        if (begin == end || !std::isalpha(*begin)) {
+        Iterator current = detail::word_end(begin, end);
+        if (current == begin) {
             return {begin, std::nullopt};
         }
 
-        std::string result;
-        Iterator current = begin;
-
-        while (current != end && std::isalpha(*current)) {
-            result += *current;
-            ++current;
-        }
-
-        return {current, std::make_optional(std::move(result))};
+        return {current, std::make_optional<std::string>(begin, current)};
     }
 };
 
@@ -42,10 +88,63 @@ inline auto word_parser() {
     return WordParser{};
 }
 
+/**
+ * @brief Zero-copy word parser over contiguous input
+ *
+ * Returns the word as a slice of the input, so it is only valid while the
+ * input is. Convert with std::string(*result) when an owned value is
+ * needed, or use WordParser.
+ */
+class WordViewParser {
+public:
+    using output_type = std::string_view;
+
+    template<std::contiguous_iterator Iterator>
+    auto parse(Iterator begin, Iterator end) const
+        -> std::pair<Iterator, std::optional<std::string_view>>
+    {
+        return detail::scan_word(begin, end);
+    }
+};
+
+inline auto word_view_parser() {
+    return WordViewParser{};
+}
+
+/**
+ * @brief True for distance functions that take a cutoff
+ *
+ * A bounded distance is called as func(a, b, k) and returns
+ * std::optional<size_t>: the distance if it is at most k, nullopt otherwise.
+ * Matchers pass their max_distance as k so the computation can stop early.
+ */
+template<typename DistanceFunc>
+inline constexpr bool is_bounded_distance_v =
+    std::is_invocable_r_v<std::optional<size_t>, DistanceFunc const&,
+                          std::string const&, std::string const&, size_t>;
+
+namespace detail {
+
+// Calls a user distance function on a scanned word, copying the word
+// only if the function cannot take a std::string_view
+template<typename DistanceFunc, typename... Bound>
+auto call_distance(DistanceFunc const& func, std::string_view word, std::string const& other, Bound... k) {
+    if constexpr (std::is_invocable_v<DistanceFunc const&, std::string_view, std::string const&, Bound...>) {
+        return func(word, other, k...);
+    } else {
+        return func(std::string(word), other, k...);
+    }
+}
+
+} // namespace detail
+
 /**
  * @brief Fuzzy word matcher - accepts words within edit distance
  *
  * Parses a word and accepts it if within max_distance of target.
+ * DistanceFunc is either func(a, b) -> size_t or a bounded distance. One
+ * that accepts std::string_view compares the word in place; one that needs
+ * std::string gets a copy of it.
  */
 template<typename DistanceFunc>
 class FuzzyWordMatcher {
@@ -66,16 +165,22 @@ public:
         -> std::pair<Iterator, std::optional<std::string>>
     {
         // First parse a word
-        auto word_p = word_parser();
-        auto [pos, word_result] = word_p.parse(begin, end);
+        auto [pos, word_result] = detail::scan_word(begin, end);
 
         if (!word_result) {
             return {begin, std::nullopt};
         }
 
         // Check if within distance
-        if (distance_func(*word_result, target) <= max_distance) {
-            return {pos, std::move(word_result)};
+        bool within;
+        if constexpr (is_bounded_distance_v<DistanceFunc>) {
+            within = detail::call_distance(distance_func, *word_result, target, max_distance).has_value();
+        } else {
+            within = detail::call_distance(distance_func, *word_result, target) <= max_distance;
+        }
+
+        if (within) {
+            return {pos, std::make_optional<std::string>(std::move(*word_result))};
         }
 
         return {begin, std::nullopt};
@@ -89,8 +194,8 @@ inline auto fuzzy_match(std::string target, size_t max_distance = 2) {
     return FuzzyWordMatcher(
         std::move(target),
         max_distance,
-        [](const std::string& a, const std::string& b) {
-            return similarity::levenshtein_distance(a, b);
+        [](std::string_view a, std::string_view b, size_t k) {
+            return similarity::levenshtein_distance_bounded(a, b, k);
         }
     );
 }
@@ -104,49 +209,103 @@ inline auto fuzzy_match_dl(std::string target, size_t max_distance = 2) {
     return FuzzyWordMatcher(
         std::move(target),
         max_distance,
-        [](const std::string& a, const std::string& b) {
-            return similarity::damerau_levenshtein_distance(a, b);
+        [](std::string_view a, std::string_view b, size_t k) {
+            return similarity::damerau_levenshtein_distance_bounded(a, b, k);
         }
     );
 }
 
+/**
+ * @brief Soundex encoding for the phonetic matchers
+ *
+ * An encoding names the packed code type of a word and how to compute it;
+ * two words sound alike when their codes are equal.
+ */
+struct soundex_encoding {
+    using code_type = phonetic::soundex_code_t;
+    using hash = std::hash<code_type>;
+
+    static code_type code(std::string_view word) { return phonetic::Soundex::code(word); }
+};
+
+/**
+ * @brief Metaphone encoding (4 letters) for the phonetic matchers
+ */
+struct metaphone_encoding {
+    using code_type = phonetic::metaphone_code_t;
+    using hash = std::hash<code_type>;
+
+    static code_type code(std::string_view word) { return phonetic::Metaphone::code(word, 4); }
+};
+
+/**
+ * @brief Soundex and Metaphone together
+ *
+ * Words sound alike only when both codes agree, which rejects many of the
+ * accidental collisions either encoding makes on its own.
+ */
+struct combined_encoding {
+    struct code_type {
+        phonetic::soundex_code_t soundex;
+        phonetic::metaphone_code_t metaphone;
+
+        bool operator==(code_type const&) const = default;
+    };
+
+    struct hash {
+        size_t operator()(code_type const& c) const {
+            return std::hash<uint64_t>{}(c.metaphone ^ (uint64_t(c.soundex) * 0x9e3779b97f4a7c15ULL));
+        }
+    };
+
+    static code_type code(std::string_view word) {
+        return {phonetic::Soundex::code(word), phonetic::Metaphone::code(word, 4)};
+    }
+};
+
 /**
  * @brief Phonetic matcher - accepts words that sound alike
  *
- * Uses Soundex algorithm.
+ * The target is encoded once at construction; each parse encodes only the
+ * input word, into a packed integer, and compares codes.
  */
-class PhoneticMatcher {
+template<typename Encoding>
+class BasicPhoneticMatcher {
 public:
     using output_type = std::string;
 
 private:
-    std::string target_code;
+    typename Encoding::code_type target_code;
     std::string target;
 
 public:
-    explicit PhoneticMatcher(std::string target_word)
-        : target_code(phonetic::soundex(target_word)), target(std::move(target_word)) {}
+    explicit BasicPhoneticMatcher(std::string target_word)
+        : target_code(Encoding::code(target_word)), target(std::move(target_word)) {}
 
     template<typename Iterator>
     auto parse(Iterator begin, Iterator end) const
         -> std::pair<Iterator, std::optional<std::string>>
     {
-        auto word_p = word_parser();
-        auto [pos, word_result] = word_p.parse(begin, end);
+        auto [pos, word_result] = detail::scan_word(begin, end);
 
         if (!word_result) {
             return {begin, std::nullopt};
         }
 
         // Check if sounds like target
-        if (phonetic::soundex(*word_result) == target_code) {
-            return {pos, std::move(word_result)};
+        if (Encoding::code(*word_result) == target_code) {
+            return {pos, std::make_optional<std::string>(std::move(*word_result))};
         }
 
         return {begin, std::nullopt};
     }
 };
 
+/**
+ * @brief Phonetic matcher using Soundex
+ */
+using PhoneticMatcher = BasicPhoneticMatcher<soundex_encoding>;
+
 /**
  * @brief Create a phonetic matcher (Soundex)
  */
@@ -154,6 +313,109 @@ inline auto phonetic_match(std::string target) {
     return PhoneticMatcher(std::move(target));
 }
 
+/**
+ * @brief Create a phonetic matcher with the given encoding
+ *
+ * phonetic_match<metaphone_encoding>("Knight") or
+ * phonetic_match<combined_encoding>("Smith").
+ */
+template<typename Encoding>
+inline auto phonetic_match(std::string target) {
+    return BasicPhoneticMatcher<Encoding>(std::move(target));
+}
+
+/**
+ * @brief Phonetic matcher against many targets
+ *
+ * Keeps the codes of all targets in a hash set, so a parse costs one
+ * encode and one lookup however many targets there are. Returns the word
+ * as written.
+ */
+template<typename Encoding>
+class PhoneticSetMatcher {
+public:
+    using output_type = std::string;
+
+private:
+    std::unordered_set<typename Encoding::code_type, typename Encoding::hash> target_codes;
+
+public:
+    explicit PhoneticSetMatcher(std::vector<std::string> const& targets) {
+        target_codes.reserve(targets.size());
+        for (auto const& t : targets) {
+            target_codes.insert(Encoding::code(t));
+        }
+    }
+
+    template<typename Iterator>
+    auto parse(Iterator begin, Iterator end) const
+        -> std::pair<Iterator, std::optional<std::string>>
+    {
+        auto [pos, word_result] = detail::scan_word(begin, end);
+
+        if (!word_result) {
+            return {begin, std::nullopt};
+        }
+
+        if (target_codes.contains(Encoding::code(*word_result))) {
+            return {pos, std::make_optional<std::string>(std::move(*word_result))};
+        }
+
+        return {begin, std::nullopt};
+    }
+};
+
+/**
+ * @brief Create a matcher for words that sound like any of the targets
+ */
+template<typename Encoding = soundex_encoding>
+inline auto phonetic_match_any(std::vector<std::string> const& targets) {
+    return PhoneticSetMatcher<Encoding>(targets);
+}
+
+/**
+ * @brief Phonetic matcher against a whole dictionary
+ *
+ * Accepts a word that sounds like any record of a shared PhoneticIndex:
+ * the word is encoded once and looked up, whatever the dictionary size.
+ * Returns the word as written, like PhoneticMatcher.
+ */
+class PhoneticIndexMatcher {
+public:
+    using output_type = std::string;
+
+private:
+    std::shared_ptr<const phonetic::PhoneticIndex> index;
+
+public:
+    explicit PhoneticIndexMatcher(std::shared_ptr<const phonetic::PhoneticIndex> idx)
+        : index(std::move(idx)) {}
+
+    template<typename Iterator>
+    auto parse(Iterator begin, Iterator end) const
+        -> std::pair<Iterator, std::optional<std::string>>
+    {
+        auto [pos, word_result] = detail::scan_word(begin, end);
+
+        if (!word_result) {
+            return {begin, std::nullopt};
+        }
+
+        if (index->sounds_like_any(*word_result)) {
+            return {pos, std::make_optional<std::string>(std::move(*word_result))};
+        }
+
+        return {begin, std::nullopt};
+    }
+};
+
+/**
+ * @brief Create a phonetic matcher over a prebuilt PhoneticIndex
+ */
+inline auto phonetic_match(std::shared_ptr<const phonetic::PhoneticIndex> index) {
+    return PhoneticIndexMatcher(std::move(index));
+}
+
 /**
  * @brief Similarity matcher - accepts words above similarity threshold
  *
@@ -175,8 +437,7 @@ public:
     auto parse(Iterator begin, Iterator end) const
         -> std::pair<Iterator, std::optional<std::string>>
     {
-        auto word_p = word_parser();
-        auto [pos, word_result] = word_p.parse(begin, end);
+        auto [pos, word_result] = detail::scan_word(begin, end);
 
         if (!word_result) {
             return {begin, std::nullopt};
@@ -185,7 +446,7 @@ public:
         // Check similarity
         double sim = similarity::jaro_winkler_similarity(*word_result, target);
         if (sim >= threshold) {
-            return {pos, std::move(word_result)};
+            return {pos, std::make_optional<std::string>(std::move(*word_result))};
         }
 
         return {begin, std::nullopt};
@@ -203,6 +464,12 @@ inline auto similarity_match(std::string target, double threshold = 0.8) {
  * @brief Fuzzy choice - match closest to any candidate
  *
  * Tries to match any of the candidates, accepting closest within distance.
+ * When several candidates are equally close, the first one listed wins.
+ *
+ * With similarity::levenshtein_metric the candidates are indexed in a
+ * levenshtein_trie at construction, so lookups only visit the part of the
+ * dictionary that can be within max_distance. Any other distance function
+ * is scanned linearly.
  */
 template<typename DistanceFunc>
 class FuzzyChoiceMatcher {
@@ -210,40 +477,79 @@ public:
     using output_type = std::string;
 
 private:
-    std::vector<std::string> candidates;
+    static constexpr bool indexed = std::is_same_v<DistanceFunc, similarity::levenshtein_metric>;
+
+    using candidate_store = std::conditional_t<indexed,
+                                               similarity::levenshtein_trie,
+                                               std::vector<std::string>>;
+
+    candidate_store candidates;
     size_t max_distance;
     DistanceFunc distance_func;
 
+    static candidate_store make_store(std::vector<std::string> cands, DistanceFunc const& func) {
+        if constexpr (indexed) {
+            (void)func;
+            return candidate_store(cands);
+        } else {
+            return cands;
+        }
+    }
+
+    std::optional<std::string> closest(std::string_view word) const {
+        if constexpr (indexed) {
+            auto match = candidates.closest(word, max_distance);
+            if (!match) {
+                return std::nullopt;
+            }
+            return candidates[match->index];
+        } else {
+            size_t min_distance = SIZE_MAX;
+            std::string const* best = nullptr;
+
+            for (const auto& candidate : candidates) {
+                if constexpr (is_bounded_distance_v<DistanceFunc>) {
+                    // Only a strictly closer candidate can replace the current one
+                    size_t bound = min_distance == SIZE_MAX ? max_distance : min_distance - 1;
+                    auto dist = detail::call_distance(distance_func, word, candidate, bound);
+                    if (dist) {
+                        min_distance = *dist;
+                        best = &candidate;
+                        if (min_distance == 0) break;
+                    }
+                } else {
+                    size_t dist = detail::call_distance(distance_func, word, candidate);
+                    if (dist < min_distance) {
+                        min_distance = dist;
+                        best = &candidate;
+                    }
+                }
+            }
+
+            if (best == nullptr || min_distance > max_distance) {
+                return std::nullopt;
+            }
+            return *best;
+        }
+    }
+
 public:
     FuzzyChoiceMatcher(std::vector<std::string> cands, size_t max_dist, DistanceFunc func)
-        : candidates(std::move(cands)), max_distance(max_dist), distance_func(func) {}
+        : candidates(make_store(std::move(cands), func)), max_distance(max_dist), distance_func(func) {}
 
     template<typename Iterator>
     auto parse(Iterator begin, Iterator end) const
         -> std::pair<Iterator, std::optional<std::string>>
     {
-        auto word_p = word_parser();
-        auto [pos, word_result] = word_p.parse(begin, end);
+        auto [pos, word_result] = detail::scan_word(begin, end);
 
         if (!word_result) {
             return {begin, std::nullopt};
         }
 
-        // Find closest candidate
-        size_t min_distance = SIZE_MAX;
-        std::string closest;
-
-        for (const auto& candidate : candidates) {
-            size_t dist = distance_func(*word_result, candidate);
-            if (dist < min_distance) {
-                min_distance = dist;
-                closest = candidate;
-            }
-        }
-
-        // Accept if within threshold
-        if (min_distance <= max_distance) {
-            return {pos, std::make_optional(closest)};  // Return normalized form
+        // Accept closest candidate if within threshold
+        if (auto match = closest(*word_result)) {
+            return {pos, std::move(match)};  // Return normalized form
         }
 
         return {begin, std::nullopt};
@@ -252,17 +558,76 @@ public:
 
 /**
  * @brief Create fuzzy choice matcher
+ *
+ * Candidates are indexed in a trie searched by Levenshtein distance.
  */
 inline auto fuzzy_choice(std::vector<std::string> candidates, size_t max_distance = 2) {
     return FuzzyChoiceMatcher(
         std::move(candidates),
         max_distance,
-        [](const std::string& a, const std::string& b) {
-            return similarity::levenshtein_distance(a, b);
-        }
+        similarity::levenshtein_metric{}
     );
 }
 
+/**
+ * @brief Dictionary matcher backed by a shared symspell_index
+ *
+ * Accepts a word within max_distance of any dictionary word and returns the
+ * closest one, the earliest in the dictionary on ties, like
+ * FuzzyChoiceMatcher. The index is shared so one built or loaded index can
+ * serve many matchers.
+ */
+class SymSpellMatcher {
+public:
+    using output_type = std::string;
+
+private:
+    std::shared_ptr<const similarity::symspell_index> index;
+    size_t max_distance;
+    similarity::edit_metric metric;
+
+public:
+    SymSpellMatcher(std::shared_ptr<const similarity::symspell_index> idx, size_t max_dist,
+                    similarity::edit_metric m)
+        : index(std::move(idx)), max_distance(max_dist), metric(m) {}
+
+    template<typename Iterator>
+    auto parse(Iterator begin, Iterator end) const
+        -> std::pair<Iterator, std::optional<std::string>>
+    {
+        auto [pos, word_result] = detail::scan_word(begin, end);
+
+        if (!word_result) {
+            return {begin, std::nullopt};
+        }
+
+        if (auto match = index->closest(*word_result, max_distance, metric)) {
+            return {pos, std::make_optional(std::string((*index)[match->index]))};
+        }
+
+        return {begin, std::nullopt};
+    }
+};
+
+/**
+ * @brief Create fuzzy choice matcher over a prebuilt SymSpell index
+ *
+ * max_distance is capped at the distance the index was built for.
+ */
+inline auto fuzzy_choice(std::shared_ptr<const similarity::symspell_index> index, size_t max_distance = 2) {
+    return SymSpellMatcher(std::move(index), max_distance, similarity::edit_metric::levenshtein);
+}
+
+/**
+ * @brief Create Damerau-Levenshtein matcher against a whole dictionary
+ *
+ * Like fuzzy_match_dl but accepts any word of the index's dictionary and
+ * returns the closest one.
+ */
+inline auto fuzzy_match_dl(std::shared_ptr<const similarity::symspell_index> index, size_t max_distance = 2) {
+    return SymSpellMatcher(std::move(index), max_distance, similarity::edit_metric::damerau_levenshtein);
+}
+
 /**
  * @brief Case-insensitive matcher
  */
@@ -290,15 +655,14 @@ public:
     auto parse(Iterator begin, Iterator end) const
         -> std::pair<Iterator, std::optional<std::string>>
     {
-        auto word_p = word_parser();
-        auto [pos, word_result] = word_p.parse(begin, end);
+        auto [pos, word_result] = detail::scan_word(begin, end);
 
         if (!word_result) {
             return {begin, std::nullopt};
         }
 
-        if (to_lower(*word_result) == target) {
-            return {pos, std::move(word_result)};
+        if (detail::equals_ignore_case(*word_result, target)) {
+            return {pos, std::make_optional<std::string>(std::move(*word_result))};
         }
 
         return {begin, std::nullopt};
@@ -312,13 +676,77 @@ inline auto case_insensitive(std::string target) {
     return CaseInsensitiveMatcher(std::move(target));
 }
 
+/**
+ * @brief Stages of the CombinedFuzzyMatcher cascade, cheapest first
+ */
+enum class cascade_stage : uint8_t {
+    exact,             // Accepts the target as written
+    case_insensitive,  // Accepts the target in any ASCII case
+    length_filter,     // Rejects words whose length is too far off
+    phonetic,          // Accepts words with the target's Soundex code
+    edit_distance      // Accepts words within max_distance, rejects the rest
+};
+
+inline constexpr size_t cascade_stage_count = 5;
+
+/**
+ * @brief Which optional stages of the cascade run
+ *
+ * The exact and edit distance stages always run. With length_filter on,
+ * a word whose length differs from the target's by more than max_distance
+ * is rejected before the phonetic stage, so sound-alikes of quite
+ * different lengths are no longer accepted.
+ */
+struct cascade_options {
+    bool case_insensitive = true;
+    bool length_filter = true;
+    bool phonetic = true;
+};
+
+/**
+ * @brief Number of words each stage accepted and rejected
+ */
+struct cascade_counts {
+    std::array<uint64_t, cascade_stage_count> accepted{};
+    std::array<uint64_t, cascade_stage_count> rejected{};
+
+    uint64_t accepted_at(cascade_stage stage) const { return accepted[static_cast<size_t>(stage)]; }
+    uint64_t rejected_at(cascade_stage stage) const { return rejected[static_cast<size_t>(stage)]; }
+
+    /**
+     * @brief Words that reached a decision
+     */
+    uint64_t total() const {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < cascade_stage_count; ++i) sum += accepted[i] + rejected[i];
+        return sum;
+    }
+};
+
+namespace detail {
+
+// Shared by copies of a matcher, so a matcher copied into a combinator
+// still reports to the handle it was built from
+struct cascade_counters {
+    std::array<std::atomic<uint64_t>, cascade_stage_count> accepted{};
+    std::array<std::atomic<uint64_t>, cascade_stage_count> rejected{};
+};
+
+} // namespace detail
+
 /**
  * @brief Combined fuzzy matcher - tries multiple strategies
  *
+ * A cascade ordered by cost, each stage deciding or passing the word on:
  * 1. Exact match
- * 2. Case-insensitive match
- * 3. Phonetic match
- * 4. Fuzzy match (edit distance)
+ * 2. Case-insensitive match, compared in place
+ * 3. Length filter (rejects when lengths differ by more than max_distance)
+ * 4. Phonetic match on packed Soundex codes
+ * 5. Fuzzy match (bounded edit distance)
+ *
+ * Every decision is counted per stage, relaxed-atomically so a matcher
+ * can be shared between threads; stats() shows which stages decide most
+ * words, to tune cascade_options against real traffic.
  */
 class CombinedFuzzyMatcher {
 public:
@@ -326,64 +754,87 @@ public:
 
 private:
     std::string target;
-    std::string target_lower;
-    std::string target_soundex;
+    phonetic::soundex_code_t target_soundex;
     size_t max_distance;
+    cascade_options options;
+    std::shared_ptr<detail::cascade_counters> counters;
 
-    static std::string to_lower(std::string_view s) {
-        std::string result;
-        for (char c : s) result += std::tolower(c);
-        return result;
+    bool decide(cascade_stage stage, bool accept) const {
+        auto& slot = accept ? counters->accepted : counters->rejected;
+        slot[static_cast<size_t>(stage)].fetch_add(1, std::memory_order_relaxed);
+        return accept;
+    }
+
+    bool accepts(std::string_view word) const {
+        if (word == target) {
+            return decide(cascade_stage::exact, true);
+        }
+        if (options.case_insensitive && detail::equals_ignore_case(word, target)) {
+            return decide(cascade_stage::case_insensitive, true);
+        }
+        if (options.length_filter) {
+            size_t diff = word.size() > target.size() ? word.size() - target.size() : target.size() - word.size();
+            if (diff > max_distance) {
+                return decide(cascade_stage::length_filter, false);
+            }
+        }
+        if (options.phonetic && phonetic::Soundex::code(word) == target_soundex) {
+            return decide(cascade_stage::phonetic, true);
+        }
+        return decide(cascade_stage::edit_distance,
+                      similarity::within_distance(word, target, max_distance));
     }
 
 public:
-    CombinedFuzzyMatcher(std::string target_word, size_t max_dist = 2)
-        : target(target_word),
-          target_lower(to_lower(target_word)),
-          target_soundex(phonetic::soundex(target_word)),
-          max_distance(max_dist) {}
+    CombinedFuzzyMatcher(std::string target_word, size_t max_dist = 2, cascade_options opts = {})
+        : target(std::move(target_word)),
+          target_soundex(phonetic::Soundex::code(target)),
+          max_distance(max_dist),
+          options(opts),
+          counters(std::make_shared<detail::cascade_counters>()) {}
 
     template<typename Iterator>
     auto parse(Iterator begin, Iterator end) const
         -> std::pair<Iterator, std::optional<std::string>>
     {
-        auto word_p = word_parser();
-        auto [pos, word_result] = word_p.parse(begin, end);
+        auto [pos, word_result] = detail::scan_word(begin, end);
 
         if (!word_result) {
             return {begin, std::nullopt};
         }
 
-        // 1. Exact match
-        if (*word_result == target) {
-            return {pos, std::move(word_result)};
+        if (accepts(*word_result)) {
+            return {pos, std::make_optional<std::string>(std::move(*word_result))};
         }
 
-        // 2. Case-insensitive match
-        std::string word_lower = to_lower(*word_result);
-        if (word_lower == target_lower) {
-            return {pos, std::move(word_result)};
-        }
+        return {begin, std::nullopt};
+    }
 
-        // 3. Phonetic match
-        if (phonetic::soundex(*word_result) == target_soundex) {
-            return {pos, std::move(word_result)};
+    /**
+     * @brief Snapshot of the per-stage counters
+     */
+    cascade_counts stats() const {
+        cascade_counts counts;
+        for (size_t i = 0; i < cascade_stage_count; ++i) {
+            counts.accepted[i] = counters->accepted[i].load(std::memory_order_relaxed);
+            counts.rejected[i] = counters->rejected[i].load(std::memory_order_relaxed);
         }
+        return counts;
+    }
 
-        // 4. Fuzzy match (edit distance)
-        if (similarity::levenshtein_distance(*word_result, target) <= max_distance) {
-            return {pos, std::move(word_result)};
+    void reset_stats() const {
+        for (size_t i = 0; i < cascade_stage_count; ++i) {
+            counters->accepted[i].store(0, std::memory_order_relaxed);
+            counters->rejected[i].store(0, std::memory_order_relaxed);
         }
-
-        return {begin, std::nullopt};
     }
 };
 
 /**
  * @brief Create combined fuzzy matcher (tries all strategies)
  */
-inline auto combined_fuzzy(std::string target, size_t max_distance = 2) {
-    return CombinedFuzzyMatcher(std::move(target), max_distance);
+inline auto combined_fuzzy(std::string target, size_t max_distance = 2, cascade_options options = {}) {
+    return CombinedFuzzyMatcher(std::move(target), max_distance, options);
 }
 
 } // namespace fuzzy
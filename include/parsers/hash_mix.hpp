@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace alga {
+namespace detail {
+
+// splitmix64 finalizer: spreads every input bit over the whole word
+inline uint64_t mix64(uint64_t h) {
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return h;
+}
+
+// FNV-1a, finalized with mix64. Unlike std::hash the result is the same on
+// every platform, so it may be written to disk.
+inline uint64_t hash_bytes(std::string_view s) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (char c : s) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3ULL;
+    }
+    return mix64(h);
+}
+
+} // namespace detail
+} // namespace alga
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <cstddef>
+#include <compare>
+#include <iostream>
+
+namespace alga
+{
+    /**
+     * @brief Fixed-capacity string with inline storage and heap spill
+     *
+     * Strings of up to Capacity bytes live inside the object, so copying,
+     * concatenating and storing short words never touches the allocator.
+     * Longer strings spill to a single heap block. Models the subset of
+     * std::string used as an lc_alpha storage policy: sized construction,
+     * writable data(), iteration and string_view conversion.
+     */
+    template <size_t Capacity = 24>
+    class inline_string
+    {
+    private:
+        size_t len;
+        union
+        {
+            char buf[Capacity];
+            char* heap;
+        };
+
+        bool on_heap() const { return len > Capacity; }
+
+        void allocate(size_t n)
+        {
+            len = n;
+            if (on_heap()) {
+                heap = new char[n];
+            }
+        }
+
+    public:
+        using value_type = char;
+        using size_type = size_t;
+        using const_iterator = char const*;
+        using iterator = char*;
+
+        static constexpr size_t inline_capacity = Capacity;
+
+        inline_string() noexcept : len(0) {}
+
+        inline_string(size_t n, char c)
+        {
+            allocate(n);
+            std::memset(data(), c, n);
+        }
+
+        explicit inline_string(std::string_view sv)
+        {
+            allocate(sv.size());
+            if (!sv.empty()) {
+                std::memcpy(data(), sv.data(), sv.size());
+            }
+        }
+
+        inline_string(inline_string const& other)
+        {
+            allocate(other.len);
+            if (len != 0) {
+                std::memcpy(data(), other.data(), len);
+            }
+        }
+
+        inline_string(inline_string&& other) noexcept : len(other.len)
+        {
+            if (on_heap()) {
+                heap = other.heap;
+                other.len = 0;
+            } else if (len != 0) {
+                std::memcpy(buf, other.buf, len);
+            }
+        }
+
+        inline_string& operator=(inline_string const& other)
+        {
+            if (this != &other) {
+                inline_string copy(other);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        inline_string& operator=(inline_string&& other) noexcept
+        {
+            if (this != &other) {
+                inline_string moved(std::move(other));
+                swap(moved);
+            }
+            return *this;
+        }
+
+        ~inline_string()
+        {
+            if (on_heap()) {
+                delete[] heap;
+            }
+        }
+
+        void swap(inline_string& other) noexcept
+        {
+            inline_string* lhs = this;
+            inline_string* rhs = &other;
+            // Byte-wise swap is valid: the only owned resource is the heap pointer
+            alignas(inline_string) unsigned char tmp[sizeof(inline_string)];
+            std::memcpy(tmp, static_cast<void*>(lhs), sizeof(inline_string));
+            std::memcpy(static_cast<void*>(lhs), static_cast<void*>(rhs), sizeof(inline_string));
+            std::memcpy(static_cast<void*>(rhs), tmp, sizeof(inline_string));
+        }
+
+        // Access interface
+        char* data() { return on_heap() ? heap : buf; }
+        char const* data() const { return on_heap() ? heap : buf; }
+        size_t size() const { return len; }
+        bool empty() const { return len == 0; }
+        bool is_inline() const { return !on_heap(); }
+
+        std::string_view view() const { return std::string_view(data(), len); }
+        operator std::string_view() const { return view(); }
+        explicit operator std::string() const { return std::string(view()); }
+
+        // Iterator interface
+        char const* begin() const { return data(); }
+        char const* end() const { return data() + len; }
+
+        char operator[](size_t i) const { return data()[i]; }
+
+        friend bool operator==(inline_string const& lhs, inline_string const& rhs)
+        {
+            return lhs.view() == rhs.view();
+        }
+
+        friend bool operator==(inline_string const& lhs, std::string_view rhs)
+        {
+            return lhs.view() == rhs;
+        }
+
+        friend std::strong_ordering operator<=>(inline_string const& lhs, inline_string const& rhs)
+        {
+            return lhs.view() <=> rhs.view();
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, inline_string const& s)
+        {
+            return os << s.view();
+        }
+    };
+}
@@ -0,0 +1,269 @@
+#pragma once
+
+#include "porter2stemmer.hpp"
+#include "ngram_stemmer.hpp"
+#include "hash_mix.hpp"
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace alga
+{
+    /**
+     * @brief Thread-safe string interning table with dense 32-bit IDs
+     *
+     * Maps each distinct string to an ID in [1, size()], assigned in order of
+     * first insertion. ID 0 is never issued, so invalid_id can mark an unset
+     * ID without standing for any string. Interned strings are never moved
+     * or freed, so views returned by lookup() stay valid for the lifetime of
+     * the pool. A pool holds at most max_size() strings.
+     *
+     * Lookups of already-interned strings take a shared lock; only the first
+     * insertion of a new string takes the exclusive lock.
+     */
+    class intern_pool
+    {
+    public:
+        using id_type = uint32_t;
+        static constexpr id_type invalid_id = 0;
+
+        intern_pool() = default;
+        intern_pool(intern_pool const&) = delete;
+        intern_pool& operator=(intern_pool const&) = delete;
+
+        /**
+         * @brief Return the ID of s, inserting it if it is new
+         *
+         * Throws std::length_error if s is new and the pool already holds
+         * max_size() strings.
+         */
+        id_type intern(string_view s)
+        {
+            {
+                std::shared_lock lock(mutex);
+                auto it = ids.find(s);
+                if (it != ids.end()) {
+                    return it->second;
+                }
+            }
+
+            std::unique_lock lock(mutex);
+            auto it = ids.find(s);
+            if (it != ids.end()) {
+                return it->second;
+            }
+
+            if (by_id.size() > max_size()) {
+                throw std::length_error("intern_pool: more than max_size() strings");
+            }
+            id_type id = static_cast<id_type>(by_id.size());
+            string_view stored = strings.emplace_back(s);
+            by_id.push_back(stored);
+            ids.emplace(stored, id);
+            return id;
+        }
+
+        /**
+         * @brief ID of s if it has been interned, without inserting
+         */
+        optional<id_type> find(string_view s) const
+        {
+            std::shared_lock lock(mutex);
+            auto it = ids.find(s);
+            if (it == ids.end()) {
+                return std::nullopt;
+            }
+            return it->second;
+        }
+
+        /**
+         * @brief String for an ID previously returned by intern()
+         *
+         * invalid_id, or any other ID this pool never issued, gives an empty
+         * view.
+         */
+        string_view lookup(id_type id) const
+        {
+            std::shared_lock lock(mutex);
+            if (id >= by_id.size()) {
+                return {};
+            }
+            return by_id[id];
+        }
+
+        size_t size() const
+        {
+            std::shared_lock lock(mutex);
+            return by_id.size() - 1;
+        }
+
+        static constexpr size_t max_size()
+        {
+            return std::numeric_limits<id_type>::max();
+        }
+
+    private:
+        mutable std::shared_mutex mutex;
+        std::deque<string> strings;  // Stable addresses for the views below
+        std::vector<string_view> by_id{string_view{}};  // Slot 0 is invalid_id
+        std::unordered_map<string_view, id_type> ids;
+    };
+
+    /**
+     * @brief Process-wide pool shared by lc_alpha, porter2_stem and n-gram IDs
+     */
+    inline intern_pool& global_intern_pool()
+    {
+        static intern_pool pool;
+        return pool;
+    }
+
+    /**
+     * @brief Interned lc_alpha / porter2_stem as a dense 32-bit ID
+     *
+     * Equality, ordering and hashing are single integer operations. Ordering
+     * follows insertion order, not lexicographic order. A default-constructed
+     * ID is intern_pool::invalid_id: it views as empty and equals no
+     * interned string.
+     */
+    struct intern_id
+    {
+        intern_pool::id_type value = intern_pool::invalid_id;
+
+        bool valid() const { return value != intern_pool::invalid_id; }
+
+        string_view view() const { return global_intern_pool().lookup(value); }
+        explicit operator string() const { return string(view()); }
+
+        friend bool operator==(intern_id, intern_id) = default;
+        friend auto operator<=>(intern_id, intern_id) = default;
+    };
+
+    using stem_id = intern_id;
+
+    inline std::ostream& operator<<(std::ostream& os, intern_id id)
+    {
+        return os << id.view();
+    }
+
+    template <typename Storage>
+    intern_id intern(basic_lc_alpha<Storage> const& word)
+    {
+        return intern_id{global_intern_pool().intern(word.view())};
+    }
+
+    template <typename Storage>
+    intern_id intern(basic_porter2_stem<Storage> const& stem)
+    {
+        return intern_id{global_intern_pool().intern(stem.view())};
+    }
+
+    /**
+     * @brief Stem input and intern the result in one step
+     */
+    inline optional<stem_id> make_stem_id(string_view input)
+    {
+        auto stem = make_porter2_stem(input);
+        if (!stem) {
+            return std::nullopt;
+        }
+        return intern(*stem);
+    }
+
+    /**
+     * @brief N-gram of interned stems packed as N 32-bit IDs
+     *
+     * A bigram is a 64-bit key and a trigram a 96-bit key, compared and hashed
+     * without touching the strings.
+     */
+    template <int N>
+    struct ngram_id
+    {
+        std::array<intern_pool::id_type, N> ids{};
+
+        constexpr size_t size() const { return N; }
+        intern_id operator[](size_t i) const { return intern_id{ids[i]}; }
+
+        /**
+         * @brief Single 64-bit key, first ID in the high word
+         */
+        uint64_t packed() const requires (N <= 2)
+        {
+            uint64_t key = 0;
+            for (int i = 0; i < N; ++i) {
+                key = (key << 32) | ids[i];
+            }
+            return key;
+        }
+
+        explicit operator string() const
+        {
+            string result;
+            for (int i = 0; i < N; ++i) {
+                if (i > 0) result += " ";
+                result += (*this)[i].view();
+            }
+            return result;
+        }
+
+        friend bool operator==(ngram_id const&, ngram_id const&) = default;
+        friend auto operator<=>(ngram_id const&, ngram_id const&) = default;
+    };
+
+    template <int N, typename Storage>
+    ngram_id<N> intern(ngram_stem<N, basic_porter2_stem<Storage>> const& ngram)
+    {
+        ngram_id<N> result;
+        for (int i = 0; i < N; ++i) {
+            result.ids[i] = global_intern_pool().intern(ngram[i].view());
+        }
+        return result;
+    }
+
+    /**
+     * @brief Build an ngram_id from already-interned stems
+     */
+    template <typename... Ids>
+        requires (std::same_as<Ids, intern_id> && ...)
+    ngram_id<sizeof...(Ids)> make_ngram_id(Ids... ids)
+    {
+        return ngram_id<sizeof...(Ids)>{{ids.value...}};
+    }
+}
+
+template <>
+struct std::hash<alga::intern_id>
+{
+    size_t operator()(alga::intern_id id) const noexcept
+    {
+        return static_cast<size_t>(alga::detail::mix64(id.value));
+    }
+};
+
+template <int N>
+struct std::hash<alga::ngram_id<N>>
+{
+    size_t operator()(alga::ngram_id<N> const& key) const noexcept
+    {
+        if constexpr (N <= 2) {
+            return static_cast<size_t>(alga::detail::mix64(key.packed()));
+        } else {
+            uint64_t h = 0;
+            for (int i = 0; i < N; ++i) {
+                h = alga::detail::mix64(h ^ key.ids[i]);
+            }
+            return static_cast<size_t>(h);
+        }
+    }
+};
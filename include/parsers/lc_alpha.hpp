@@ -7,6 +7,15 @@
 #include <iostream>
 #include <vector>
 #include <functional>
+#include <span>
+#include <cstddef>
+#include <utility>
+#include "inline_string.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define ALGA_LC_ALPHA_X86 1
+#include <immintrin.h>
+#endif
 
 using std::string;
 using std::string_view;
@@ -14,97 +23,333 @@ using std::optional;
 
 namespace alga
 {
+    namespace detail
+    {
+        /**
+         * @brief Single-pass validate-and-lowercase kernels for lc_alpha
+         *
+         * Each kernel writes the lowercase form of in[0, n) to out and returns
+         * false as soon as a byte outside [A-Za-z] is seen. Validation uses the
+         * identity "c is ASCII alphabetic iff (c | 0x20) is in [a-z]", so the
+         * lowercased byte is also the value tested. The SIMD kernels bias the
+         * byte so that [a-z] maps onto the bottom of the signed range and one
+         * signed compare checks a whole block.
+         */
+        inline bool lowercase_alpha_scalar(char const* in, size_t n, char* out)
+        {
+            for (size_t i = 0; i < n; ++i) {
+                unsigned char lower = static_cast<unsigned char>(in[i]) | 0x20;
+                if (static_cast<unsigned char>(lower - 'a') > 'z' - 'a') {
+                    return false;
+                }
+                out[i] = static_cast<char>(lower);
+            }
+            return true;
+        }
+
+#ifdef ALGA_LC_ALPHA_X86
+        inline bool lowercase_alpha_sse2(char const* in, size_t n, char* out)
+        {
+            __m128i const case_bit = _mm_set1_epi8(0x20);
+            __m128i const bias = _mm_set1_epi8(static_cast<char>(128 - 'a'));
+            __m128i const limit = _mm_set1_epi8(static_cast<char>(-128 + 26));
+
+            size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i));
+                __m128i lower = _mm_or_si128(v, case_bit);
+                __m128i ok = _mm_cmplt_epi8(_mm_add_epi8(lower, bias), limit);
+                if (_mm_movemask_epi8(ok) != 0xFFFF) {
+                    return false;
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), lower);
+            }
+            return lowercase_alpha_scalar(in + i, n - i, out + i);
+        }
+
+        __attribute__((target("avx2")))
+        inline bool lowercase_alpha_avx2(char const* in, size_t n, char* out)
+        {
+            __m256i const case_bit = _mm256_set1_epi8(0x20);
+            __m256i const bias = _mm256_set1_epi8(static_cast<char>(128 - 'a'));
+            __m256i const limit = _mm256_set1_epi8(static_cast<char>(-128 + 26));
+
+            size_t i = 0;
+            for (; i + 32 <= n; i += 32) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + i));
+                __m256i lower = _mm256_or_si256(v, case_bit);
+                __m256i ok = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(lower, bias));
+                if (static_cast<unsigned>(_mm256_movemask_epi8(ok)) != 0xFFFFFFFFu) {
+                    return false;
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), lower);
+            }
+            return lowercase_alpha_sse2(in + i, n - i, out + i);
+        }
+#endif
+
+        using lowercase_alpha_kernel = bool (*)(char const*, size_t, char*);
+
+        /**
+         * @brief Pick the widest kernel the running CPU supports
+         */
+        inline lowercase_alpha_kernel select_lowercase_alpha_kernel()
+        {
+#ifdef ALGA_LC_ALPHA_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) {
+                return &lowercase_alpha_avx2;
+            }
+            return &lowercase_alpha_sse2;
+#else
+            return &lowercase_alpha_scalar;
+#endif
+        }
+
+        /**
+         * @brief Validate and lowercase in[0, n) into out using the best kernel
+         *
+         * Short tokens skip the indirect call; the kernel is resolved once.
+         */
+        inline bool lowercase_alpha(char const* in, size_t n, char* out)
+        {
+            if (n < 16) {
+                return lowercase_alpha_scalar(in, n, out);
+            }
+            static lowercase_alpha_kernel const kernel = select_lowercase_alpha_kernel();
+            return kernel(in, n, out);
+        }
+    }
+
+    class lc_alpha_arena;
+
+    template <typename Storage>
+    class basic_lc_alpha;
+
+    template <typename Storage>
+    optional<basic_lc_alpha<Storage>> make_basic_lc_alpha(string_view input);
+
     /**
      * @brief Type-safe lowercase alphabetic strings with proper value semantics
      * 
      * Forms a free monoid under concatenation with empty string as identity.
      * Now supports full value semantics (assignable, movable, storable in containers).
+     * 
+     * The Storage policy owns the characters. It must be constructible as
+     * Storage(n, c), expose writable data(), size() and begin()/end(), and
+     * convert to string_view. std::string (the default, see lc_alpha) and
+     * inline_string<N> (short words stored in the object) both qualify.
      */
-    class lc_alpha
+    template <typename Storage>
+    class basic_lc_alpha
     {
     private:
-        string s;  // Removed const to enable proper value semantics
+        Storage s;  // Removed const to enable proper value semantics
         
         // Private constructor maintains invariant
-        explicit lc_alpha(string str) : s(std::move(str)) {}
+        explicit basic_lc_alpha(Storage str) : s(std::move(str)) {}
         
     public:
+        using storage_type = Storage;
+        
         // Factory function is the ONLY way to create from potentially invalid input
-        friend optional<lc_alpha> make_lc_alpha(string_view input);
+        template <typename S>
+        friend optional<basic_lc_alpha<S>> make_basic_lc_alpha(string_view input);
+        
+        // Batch results are already validated
+        friend class lc_alpha_arena;
         
         // Monoid operations
-        friend lc_alpha operator*(lc_alpha const& lhs, lc_alpha const& rhs);
-        friend optional<lc_alpha> operator*(optional<lc_alpha> const& lhs, optional<lc_alpha> const& rhs);
+        template <typename S>
+        friend basic_lc_alpha<S> operator*(basic_lc_alpha<S> const& lhs, basic_lc_alpha<S> const& rhs);
         
         // Extended algebraic operators
-        friend lc_alpha operator|(lc_alpha const& lhs, lc_alpha const& rhs);
-        friend lc_alpha operator^(lc_alpha const& base, size_t count);
-        
-        // Comparison operators need access
-        friend bool operator==(lc_alpha const& lhs, lc_alpha const& rhs);
-        friend bool operator!=(lc_alpha const& lhs, lc_alpha const& rhs);
-        friend bool operator<(lc_alpha const& lhs, lc_alpha const& rhs);
-        friend bool operator<=(lc_alpha const& lhs, lc_alpha const& rhs);
-        friend bool operator>(lc_alpha const& lhs, lc_alpha const& rhs);
-        friend bool operator>=(lc_alpha const& lhs, lc_alpha const& rhs);
+        template <typename S>
+        friend basic_lc_alpha<S> operator^(basic_lc_alpha<S> const& base, size_t count);
         
         // Default constructible (identity element)
-        lc_alpha() = default;
+        basic_lc_alpha() = default;
         
         // Full value semantics enabled
-        lc_alpha(lc_alpha const& other) = default;
-        lc_alpha(lc_alpha&& other) = default;
-        lc_alpha& operator=(lc_alpha const& other) = default;
-        lc_alpha& operator=(lc_alpha&& other) = default;
+        basic_lc_alpha(basic_lc_alpha const& other) = default;
+        basic_lc_alpha(basic_lc_alpha&& other) = default;
+        basic_lc_alpha& operator=(basic_lc_alpha const& other) = default;
+        basic_lc_alpha& operator=(basic_lc_alpha&& other) = default;
         
         // Access interface
-        string const& str() const { return s; }
-        explicit operator string() const { return s; }
+        Storage const& str() const { return s; }
+        string_view view() const { return string_view(s.data(), s.size()); }
+        explicit operator string() const { return string(view()); }
         
         // Iterator interface
         auto begin() const { return s.begin(); }
         auto end() const { return s.end(); }
-        bool empty() const { return s.empty(); }
+        bool empty() const { return s.size() == 0; }
         size_t size() const { return s.size(); }
         
         // Direct access for internal operations (friend functions)
-        string const& internal_string() const { return s; }
+        Storage const& internal_string() const { return s; }
     };
     
+    /**
+     * @brief Heap-backed lc_alpha (std::string storage)
+     */
+    using lc_alpha = basic_lc_alpha<string>;
+    
+    /**
+     * @brief Validate and create basic_lc_alpha with the given storage policy
+     * 
+     * Validates that input contains only ASCII alphabetic characters and converts
+     * to lowercase in a single vectorized pass, writing straight into Storage.
+     */
+    template <typename Storage>
+    optional<basic_lc_alpha<Storage>> make_basic_lc_alpha(string_view input)
+    {
+        Storage lowercase_str(input.size(), '\0');
+        if (!detail::lowercase_alpha(input.data(), input.size(), lowercase_str.data())) {
+            return std::nullopt;
+        }
+        
+        return basic_lc_alpha<Storage>(std::move(lowercase_str));
+    }
+    
     /**
      * @brief Validate and create lc_alpha from string input
      * 
      * This is the ONLY way to create lc_alpha from potentially invalid input.
-     * Validates that input contains only alphabetic characters and converts to lowercase.
+     * Validates that input contains only ASCII alphabetic characters and converts
+     * to lowercase in a single vectorized pass (SSE2/AVX2, chosen at runtime).
      * 
      * @param input String to validate and convert
      * @return optional<lc_alpha> containing the result if valid, nullopt if invalid
      */
-    optional<lc_alpha> make_lc_alpha(string_view input)
+    inline optional<lc_alpha> make_lc_alpha(string_view input)
     {
-        // Check if all characters are alphabetic
-        if (!std::all_of(input.begin(), input.end(), [](char c) { return std::isalpha(c); })) {
-            return std::nullopt;
+        return make_basic_lc_alpha<string>(input);
+    }
+    
+    /**
+     * @brief Output arena for batch lc_alpha validation
+     * 
+     * Stores the lowercased bytes of every accepted token back to back in one
+     * buffer, plus one (offset, length) slot per input token. Rejected tokens
+     * keep an invalid slot so results stay index-aligned with the input.
+     */
+    class lc_alpha_arena
+    {
+    public:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+        
+        lc_alpha_arena() = default;
+        
+        // Number of tokens processed (valid or not)
+        size_t size() const { return slots.size(); }
+        bool empty() const { return slots.empty(); }
+        
+        // Whether token i passed validation
+        bool valid(size_t i) const { return slots[i].first != npos; }
+        
+        /**
+         * @brief View of the lowercased token i (empty for rejected tokens)
+         * 
+         * The view is invalidated by the next batch appended to this arena.
+         */
+        string_view operator[](size_t i) const
+        {
+            if (!valid(i)) return {};
+            return string_view(data.data() + slots[i].first, slots[i].second);
         }
         
-        // Convert to lowercase
-        string lowercase_str;
-        lowercase_str.reserve(input.size());
-        std::transform(input.begin(), input.end(), std::back_inserter(lowercase_str),
-                      [](char c) { return std::tolower(c); });
+        // Owned lc_alpha for token i, nullopt if it was rejected
+        optional<lc_alpha> get(size_t i) const
+        {
+            if (!valid(i)) return std::nullopt;
+            return lc_alpha(string((*this)[i]));
+        }
+        
+        // All accepted bytes, concatenated
+        string_view bytes() const { return data; }
+        
+        void reserve(size_t byte_count, size_t token_count)
+        {
+            data.reserve(byte_count);
+            slots.reserve(token_count);
+        }
+        
+        void clear()
+        {
+            data.clear();
+            slots.clear();
+        }
+        
+        friend size_t make_lc_alpha_batch(string_view buffer,
+                                          std::span<const std::pair<size_t, size_t>> tokens,
+                                          lc_alpha_arena& arena);
+        
+    private:
+        string data;
+        std::vector<std::pair<size_t, size_t>> slots;
+    };
+    
+    /**
+     * @brief Validate and lowercase many tokens of one contiguous buffer
+     * 
+     * Each token is an (offset, length) range into buffer. Accepted tokens are
+     * appended to the arena's single byte buffer; the arena grows by exactly
+     * one slot per token. Tokens reaching past the end of buffer are rejected.
+     * 
+     * @return Number of tokens accepted
+     */
+    inline size_t make_lc_alpha_batch(string_view buffer,
+                                      std::span<const std::pair<size_t, size_t>> tokens,
+                                      lc_alpha_arena& arena)
+    {
+        // Only in-range tokens count, so one bogus length cannot overflow
+        // total or demand an impossible allocation
+        auto in_range = [&](size_t offset, size_t length) {
+            return offset <= buffer.size() && length <= buffer.size() - offset;
+        };
+        size_t total = 0;
+        for (auto const& [offset, length] : tokens) {
+            if (in_range(offset, length)) {
+                total += length;
+            }
+        }
+        
+        size_t write = arena.data.size();
+        arena.data.resize(write + total);
+        arena.slots.reserve(arena.slots.size() + tokens.size());
+        
+        size_t accepted = 0;
+        for (auto const& [offset, length] : tokens) {
+            if (in_range(offset, length) &&
+                detail::lowercase_alpha(buffer.data() + offset, length, arena.data.data() + write)) {
+                arena.slots.emplace_back(write, length);
+                write += length;
+                ++accepted;
+            } else {
+                arena.slots.emplace_back(lc_alpha_arena::npos, 0);
+            }
+        }
         
-        return lc_alpha(std::move(lowercase_str));
+        arena.data.resize(write);
+        return accepted;
     }
     
     /**
      * @brief Direct composition for lc_alpha values
      * 
      * Implements the monoid operation directly on values for better compositionality.
+     * Writes both operands into one sized Storage, so inline storage never allocates
+     * while the result fits.
      */
-    lc_alpha operator*(lc_alpha const& lhs, lc_alpha const& rhs)
+    template <typename Storage>
+    basic_lc_alpha<Storage> operator*(basic_lc_alpha<Storage> const& lhs, basic_lc_alpha<Storage> const& rhs)
     {
-        string result = lhs.s + rhs.s;
-        return lc_alpha(std::move(result));
+        Storage result(lhs.size() + rhs.size(), '\0');
+        std::copy(lhs.begin(), lhs.end(), result.data());
+        std::copy(rhs.begin(), rhs.end(), result.data() + lhs.size());
+        return basic_lc_alpha<Storage>(std::move(result));
     }
 
     /**
@@ -113,7 +358,9 @@ namespace alga
      * Implements the lifted monoid operation for optional values.
      * Returns nullopt if either operand is nullopt, otherwise concatenates.
      */
-    optional<lc_alpha> operator*(optional<lc_alpha> const& lhs, optional<lc_alpha> const& rhs)
+    template <typename Storage>
+    optional<basic_lc_alpha<Storage>> operator*(optional<basic_lc_alpha<Storage>> const& lhs,
+                                                optional<basic_lc_alpha<Storage>> const& rhs)
     {
         if (!lhs || !rhs) {
             return std::nullopt;
@@ -123,40 +370,47 @@ namespace alga
     }
     
     // Comparison operators
-    bool operator==(lc_alpha const& lhs, lc_alpha const& rhs)
+    template <typename Storage>
+    bool operator==(basic_lc_alpha<Storage> const& lhs, basic_lc_alpha<Storage> const& rhs)
     {
-        return lhs.s == rhs.s;
+        return lhs.view() == rhs.view();
     }
     
-    bool operator!=(lc_alpha const& lhs, lc_alpha const& rhs)
+    template <typename Storage>
+    bool operator!=(basic_lc_alpha<Storage> const& lhs, basic_lc_alpha<Storage> const& rhs)
     {
         return !(lhs == rhs);
     }
     
-    bool operator<(lc_alpha const& lhs, lc_alpha const& rhs)
+    template <typename Storage>
+    bool operator<(basic_lc_alpha<Storage> const& lhs, basic_lc_alpha<Storage> const& rhs)
     {
-        return lhs.s < rhs.s;
+        return lhs.view() < rhs.view();
     }
     
-    bool operator<=(lc_alpha const& lhs, lc_alpha const& rhs)
+    template <typename Storage>
+    bool operator<=(basic_lc_alpha<Storage> const& lhs, basic_lc_alpha<Storage> const& rhs)
     {
-        return lhs.s <= rhs.s;
+        return lhs.view() <= rhs.view();
     }
     
-    bool operator>(lc_alpha const& lhs, lc_alpha const& rhs)
+    template <typename Storage>
+    bool operator>(basic_lc_alpha<Storage> const& lhs, basic_lc_alpha<Storage> const& rhs)
     {
-        return lhs.s > rhs.s;
+        return lhs.view() > rhs.view();
     }
     
-    bool operator>=(lc_alpha const& lhs, lc_alpha const& rhs)
+    template <typename Storage>
+    bool operator>=(basic_lc_alpha<Storage> const& lhs, basic_lc_alpha<Storage> const& rhs)
     {
-        return lhs.s >= rhs.s;
+        return lhs.view() >= rhs.view();
     }
     
     // Stream output operator
-    std::ostream& operator<<(std::ostream& os, lc_alpha const& lc)
+    template <typename Storage>
+    std::ostream& operator<<(std::ostream& os, basic_lc_alpha<Storage> const& lc)
     {
-        return os << lc.str();
+        return os << lc.view();
     }
 
     // ============================================================================
@@ -166,7 +420,8 @@ namespace alga
     /**
      * @brief Choice operator - prefer left operand, fallback to right if left is empty
      */
-    lc_alpha operator|(lc_alpha const& lhs, lc_alpha const& rhs)
+    template <typename Storage>
+    basic_lc_alpha<Storage> operator|(basic_lc_alpha<Storage> const& lhs, basic_lc_alpha<Storage> const& rhs)
     {
         return lhs.empty() ? rhs : lhs;
     }
@@ -174,7 +429,9 @@ namespace alga
     /**
      * @brief Choice operator for optionals - first non-nullopt wins
      */
-    optional<lc_alpha> operator|(optional<lc_alpha> const& lhs, optional<lc_alpha> const& rhs)
+    template <typename Storage>
+    optional<basic_lc_alpha<Storage>> operator|(optional<basic_lc_alpha<Storage>> const& lhs,
+                                                optional<basic_lc_alpha<Storage>> const& rhs)
     {
         return lhs ? lhs : rhs;
     }
@@ -182,23 +439,25 @@ namespace alga
     /**
      * @brief Repetition operator - compose string with itself N times
      */
-    lc_alpha operator^(lc_alpha const& base, size_t count)
+    template <typename Storage>
+    basic_lc_alpha<Storage> operator^(basic_lc_alpha<Storage> const& base, size_t count)
     {
-        if (count == 0) return lc_alpha{};
+        if (count == 0) return basic_lc_alpha<Storage>{};
         if (count == 1) return base;
         
-        string result;
-        result.reserve(base.size() * count);
+        Storage result(base.size() * count, '\0');
         for (size_t i = 0; i < count; ++i) {
-            result += base.s;
+            std::copy(base.begin(), base.end(), result.data() + i * base.size());
         }
-        return lc_alpha(std::move(result));
+        return basic_lc_alpha<Storage>(std::move(result));
     }
 
     /**
      * @brief Sequential composition - creates ordered sequence
      */
-    std::vector<lc_alpha> operator>>(lc_alpha const& lhs, lc_alpha const& rhs)
+    template <typename Storage>
+    std::vector<basic_lc_alpha<Storage>> operator>>(basic_lc_alpha<Storage> const& lhs,
+                                                    basic_lc_alpha<Storage> const& rhs)
     {
         return {lhs, rhs};
     }
@@ -206,7 +465,9 @@ namespace alga
     /**
      * @brief Logical OR for optionals
      */
-    optional<lc_alpha> operator||(optional<lc_alpha> const& lhs, optional<lc_alpha> const& rhs)
+    template <typename Storage>
+    optional<basic_lc_alpha<Storage>> operator||(optional<basic_lc_alpha<Storage>> const& lhs,
+                                                 optional<basic_lc_alpha<Storage>> const& rhs)
     {
         return lhs ? lhs : rhs;
     }
@@ -214,7 +475,9 @@ namespace alga
     /**
      * @brief Logical AND for optionals - both must succeed
      */
-    optional<std::pair<lc_alpha, lc_alpha>> operator&&(optional<lc_alpha> const& lhs, optional<lc_alpha> const& rhs)
+    template <typename Storage>
+    optional<std::pair<basic_lc_alpha<Storage>, basic_lc_alpha<Storage>>> operator&&(
+        optional<basic_lc_alpha<Storage>> const& lhs, optional<basic_lc_alpha<Storage>> const& rhs)
     {
         if (!lhs || !rhs) return std::nullopt;
         return std::make_pair(*lhs, *rhs);
@@ -223,9 +486,9 @@ namespace alga
     /**
      * @brief Function application operator
      */
-    template<typename F>
-        requires std::invocable<F, lc_alpha>
-    auto operator%(lc_alpha const& value, F const& function) -> decltype(function(value))
+    template<typename Storage, typename F>
+        requires std::invocable<F, basic_lc_alpha<Storage>>
+    auto operator%(basic_lc_alpha<Storage> const& value, F const& function) -> decltype(function(value))
     {
         return function(value);
     }
@@ -233,9 +496,9 @@ namespace alga
     /**
      * @brief Function application for optional lc_alpha
      */
-    template<typename F>
-        requires std::invocable<F, lc_alpha>
-    auto operator%(optional<lc_alpha> const& maybe_value, F const& function) 
+    template<typename Storage, typename F>
+        requires std::invocable<F, basic_lc_alpha<Storage>>
+    auto operator%(optional<basic_lc_alpha<Storage>> const& maybe_value, F const& function) 
         -> optional<std::decay_t<decltype(function(*maybe_value))>>
     {
         if (!maybe_value) return std::nullopt;
@@ -0,0 +1,228 @@
+#pragma once
+
+#include "parsers/similarity.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace alga {
+namespace similarity {
+
+/**
+ * @brief Levenshtein distance as a function object
+ *
+ * Callable as f(a, b) for the exact distance and f(a, b, k) for the bounded
+ * distance. Matchers that see this type may answer queries from a
+ * levenshtein_trie instead of calling it pairwise.
+ */
+struct levenshtein_metric {
+    size_t operator()(std::string_view a, std::string_view b) const {
+        return levenshtein_distance(a, b);
+    }
+
+    std::optional<size_t> operator()(std::string_view a, std::string_view b, size_t k) const {
+        return levenshtein_distance_bounded(a, b, k);
+    }
+};
+
+/**
+ * @brief Dictionary trie searched by Levenshtein distance
+ *
+ * A query walks the trie depth first carrying one DP row per depth: the
+ * distances from every prefix of the query to the trie prefix at that
+ * node. This simulates a Levenshtein automaton over the trie. Common
+ * prefixes are costed once for all words sharing them. A subtree is cut off
+ * as soon as every entry of its row exceeds the radius, because no
+ * extension of the prefix can come back within it. Only the small part of
+ * the dictionary near the query is ever touched.
+ *
+ * Words are numbered in insertion order; inserting a word already present
+ * returns the existing number.
+ */
+class levenshtein_trie {
+public:
+    /**
+     * @brief Closest word found by a query
+     */
+    struct match {
+        size_t index;     // Insertion number of the word
+        size_t distance;  // Its distance to the query
+    };
+
+    levenshtein_trie() : nodes(1) {}
+
+    explicit levenshtein_trie(std::vector<std::string> const& dictionary) : levenshtein_trie() {
+        words.reserve(dictionary.size());
+        for (auto const& word : dictionary) {
+            insert(word);
+        }
+    }
+
+    /**
+     * @brief Add word, returning its index (the existing one for duplicates)
+     */
+    size_t insert(std::string_view word) {
+        const uint32_t next_index = static_cast<uint32_t>(words.size());
+        uint32_t current = 0;
+        for (char c : word) {
+            uint32_t child = nodes[current].first_child;
+            while (child != none && nodes[child].label != c) {
+                child = nodes[child].next_sibling;
+            }
+            if (child == none) {
+                child = static_cast<uint32_t>(nodes.size());
+                node added;
+                added.label = c;
+                added.depth = nodes[current].depth + 1;
+                added.first_word = next_index;
+                added.next_sibling = nodes[current].first_child;
+                nodes.push_back(added);
+                nodes[current].first_child = child;
+            }
+            current = child;
+        }
+
+        if (nodes[current].word != none) {
+            return nodes[current].word;
+        }
+        nodes[current].word = next_index;
+        words.emplace_back(word);
+        max_depth = std::max(max_depth, word.size());
+        return next_index;
+    }
+
+    /**
+     * @brief Closest word within max_distance of query
+     *
+     * Ties go to the word inserted first, so a trie built from a candidate
+     * list answers exactly like a linear scan keeping the first minimum.
+     */
+    std::optional<match> closest(std::string_view query, size_t max_distance) const {
+        std::optional<match> best;
+        if (words.empty()) {
+            return best;
+        }
+
+        // No distance exceeds the longer length, so this caps the radius
+        // without changing the answer and keeps the sentinel from overflowing
+        max_distance = std::min(max_distance, std::max(query.size(), max_depth));
+        const size_t outside = max_distance + 1;
+
+        // Nodes deeper than m + max_distance are skipped before their row is
+        // touched, so rows are needed only down to that depth
+        const size_t depth_limit = std::min(max_depth, query.size() + max_distance);
+        const size_t width = query.size() + 1;
+        std::vector<size_t> rows((depth_limit + 1) * width, outside);
+        for (size_t i = 0; i < width; ++i) rows[i] = i;
+
+        // The root row is 0..m; the empty word is checked like any other
+        if (nodes[0].word != none && query.size() <= max_distance) {
+            best = match{nodes[0].word, query.size()};
+        }
+
+        std::vector<uint32_t> pending;
+        push_children(pending, 0, query);
+        while (!pending.empty()) {
+            uint32_t id = pending.back();
+            pending.pop_back();
+            node const& n = nodes[id];
+
+            // Every word below this node was inserted after first_word, so
+            // once that is later than the best match only closer words count
+            size_t radius = max_distance;
+            if (best) {
+                if (n.first_word > best->index) {
+                    if (best->distance == 0) continue;
+                    radius = best->distance - 1;
+                } else {
+                    radius = best->distance;
+                }
+            }
+
+            // Only cells with |i - depth| <= radius can be within radius;
+            // the cells bordering that band are set to a value outside it
+            size_t lo = n.depth > radius ? n.depth - radius : 0;
+            size_t hi = std::min(query.size(), n.depth + radius);
+            if (lo > hi) {
+                continue;
+            }
+
+            size_t const* parent = &rows[(n.depth - 1) * width];
+            size_t* row = &rows[n.depth * width];
+            size_t row_min = outside;
+            if (lo == 0) {
+                row[0] = n.depth;
+                row_min = n.depth;
+                lo = 1;
+            } else {
+                row[lo - 1] = outside;
+            }
+            for (size_t i = lo; i <= hi; ++i) {
+                size_t cost = query[i - 1] == n.label ? 0 : 1;
+                row[i] = std::min({parent[i] + 1, row[i - 1] + 1, parent[i - 1] + cost});
+                row_min = std::min(row_min, row[i]);
+            }
+            if (hi + 1 < width) {
+                row[hi + 1] = outside;
+            }
+
+            if (row_min > radius) {
+                continue;
+            }
+
+            size_t d = hi == query.size() ? row[hi] : outside;
+            if (n.word != none && d <= radius &&
+                (!best || d < best->distance || n.word < best->index)) {
+                best = match{n.word, d};
+            }
+
+            push_children(pending, id, query);
+        }
+        return best;
+    }
+
+    size_t size() const { return words.size(); }
+    bool empty() const { return words.empty(); }
+    std::string const& operator[](size_t index) const { return words[index]; }
+
+private:
+    static constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+
+    struct node {
+        char label = 0;
+        uint32_t depth = 0;
+        uint32_t first_child = none;
+        uint32_t next_sibling = none;
+        uint32_t word = none;        // Index of the word ending here
+        uint32_t first_word = none;  // Smallest word index in this subtree
+    };
+
+    // The child continuing the query exactly is pushed last so it is
+    // searched first: an early close match shrinks the radius for the rest
+    void push_children(std::vector<uint32_t>& pending, uint32_t id, std::string_view query) const {
+        size_t depth = nodes[id].depth;
+        char next = depth < query.size() ? query[depth] : 0;
+        uint32_t exact = none;
+        for (uint32_t child = nodes[id].first_child; child != none; child = nodes[child].next_sibling) {
+            if (nodes[child].label == next && depth < query.size()) {
+                exact = child;
+            } else {
+                pending.push_back(child);
+            }
+        }
+        if (exact != none) {
+            pending.push_back(exact);
+        }
+    }
+
+    std::vector<node> nodes;         // nodes[0] is the root
+    std::vector<std::string> words;  // By insertion index
+    size_t max_depth = 0;
+};
+
+} // namespace similarity
+} // namespace alga
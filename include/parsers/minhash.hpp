@@ -0,0 +1,292 @@
+#pragma once
+
+#include "parsers/hash_mix.hpp"
+#include "parsers/similarity.hpp"
+#include "parsers/similarity_matrix.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace alga {
+namespace similarity {
+
+/**
+ * @brief Set of q-grams of a string, as sorted distinct 64-bit hashes
+ *
+ * A string shorter than q contributes itself as its only gram, so short
+ * strings still compare; the empty string has no grams.
+ */
+inline std::vector<uint64_t> qgram_profile(std::string_view s, size_t q = 3) {
+    std::vector<uint64_t> grams;
+    if (s.empty()) return grams;
+    q = std::max<size_t>(q, 1);
+    if (s.size() <= q) {
+        grams.push_back(alga::detail::hash_bytes(s));
+        return grams;
+    }
+    grams.reserve(s.size() - q + 1);
+    for (size_t i = 0; i + q <= s.size(); ++i) {
+        grams.push_back(alga::detail::hash_bytes(s.substr(i, q)));
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+/**
+ * @brief Jaccard similarity |A n B| / |A u B| of two q-gram profiles
+ *
+ * Two empty profiles are identical (1.0).
+ */
+inline double jaccard_similarity(std::span<const uint64_t> a, std::span<const uint64_t> b) {
+    if (a.empty() && b.empty()) return 1.0;
+    size_t shared = 0;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a.size() && j < b.size()) {
+        if (a[i] < b[j]) {
+            ++i;
+        } else if (b[j] < a[i]) {
+            ++j;
+        } else {
+            ++shared;
+            ++i;
+            ++j;
+        }
+    }
+    return static_cast<double>(shared) / static_cast<double>(a.size() + b.size() - shared);
+}
+
+/**
+ * @brief Jaccard similarity of the q-gram sets of two strings
+ */
+inline double qgram_similarity(std::string_view s1, std::string_view s2, size_t q = 3) {
+    return jaccard_similarity(qgram_profile(s1, q), qgram_profile(s2, q));
+}
+
+/**
+ * @brief Family of hash functions producing MinHash signatures
+ *
+ * Entry i of a signature is the minimum of the i-th hash over the
+ * string's q-grams. Two signatures agree at any one position with
+ * probability equal to the Jaccard similarity of the q-gram sets, so the
+ * fraction of agreeing positions estimates it. Signatures are only
+ * comparable between hashers built with the same size and seed.
+ */
+class minhash {
+public:
+    explicit minhash(size_t num_hashes = 128, uint64_t seed = 0x9e3779b97f4a7c15ULL) : salts(num_hashes) {
+        for (size_t i = 0; i < num_hashes; ++i) {
+            salts[i] = alga::detail::mix64(seed + i * 0x9e3779b97f4a7c15ULL);
+        }
+    }
+
+    size_t size() const { return salts.size(); }
+
+    /**
+     * @brief Signature of a q-gram profile, written to out (size() entries)
+     *
+     * Throws std::invalid_argument if out has fewer than size() entries.
+     */
+    void signature(std::span<const uint64_t> profile, std::span<uint64_t> out) const {
+        if (out.size() < salts.size()) throw std::invalid_argument("minhash: output span shorter than size()");
+        std::fill(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(salts.size()),
+                  std::numeric_limits<uint64_t>::max());
+        for (uint64_t gram : profile) {
+            for (size_t i = 0; i < salts.size(); ++i) {
+                out[i] = std::min(out[i], alga::detail::mix64(gram ^ salts[i]));
+            }
+        }
+    }
+
+    std::vector<uint64_t> signature(std::string_view s, size_t q = 3) const {
+        std::vector<uint64_t> out(salts.size());
+        signature(qgram_profile(s, q), out);
+        return out;
+    }
+
+    /**
+     * @brief Estimated Jaccard similarity: the fraction of equal entries
+     */
+    static double estimate(std::span<const uint64_t> a, std::span<const uint64_t> b) {
+        size_t n = std::min(a.size(), b.size());
+        if (n == 0) return 0.0;
+        size_t equal = 0;
+        for (size_t i = 0; i < n; ++i) equal += a[i] == b[i];
+        return static_cast<double>(equal) / static_cast<double>(n);
+    }
+
+private:
+    std::vector<uint64_t> salts;
+};
+
+/**
+ * @brief Locality-sensitive hashing index over MinHash signatures
+ *
+ * Signatures of bands * rows entries are cut into bands of rows entries,
+ * and each band is hashed into its own bucket table. Strings sharing any
+ * bucket become candidates. A pair with Jaccard similarity s collides with
+ * probability 1 - (1 - s^rows)^bands, an S-curve that rises steepest
+ * around threshold() = (1 / bands)^(1 / rows): more rows make it sharper,
+ * more bands move it lower.
+ *
+ * Candidates are only likely to be similar; verify them with an exact
+ * metric, as near_duplicates does.
+ *
+ * Ids are stored in 32 bits to halve the bucket tables, so an index holds
+ * at most max_size() strings.
+ */
+class lsh_index {
+public:
+    explicit lsh_index(size_t bands = 16, size_t rows = 4, size_t q = 3,
+                       uint64_t seed = 0x9e3779b97f4a7c15ULL)
+        : bands(std::max<size_t>(bands, 1)), rows(std::max<size_t>(rows, 1)), q(q),
+          hasher(this->bands * this->rows, seed), buckets(this->bands) {}
+
+    /**
+     * @brief Jaccard similarity at which a pair is about as likely in as out
+     */
+    double threshold() const {
+        return std::pow(1.0 / static_cast<double>(bands), 1.0 / static_cast<double>(rows));
+    }
+
+    /**
+     * @brief Add a string, returning its id (ids count up from 0)
+     *
+     * Throws std::length_error once max_size() strings are indexed.
+     */
+    size_t insert(std::string_view s) {
+        if (count >= max_size()) throw std::length_error("lsh_index: more than max_size() strings");
+        const uint32_t id = static_cast<uint32_t>(count++);
+        band_keys(s, [&](size_t band, uint64_t key) {
+            buckets[band][key].push_back(id);
+        });
+        return id;
+    }
+
+    size_t size() const { return count; }
+    static constexpr size_t max_size() { return std::numeric_limits<uint32_t>::max(); }
+
+    /**
+     * @brief Ids of indexed strings sharing a bucket with s, ascending
+     */
+    std::vector<size_t> query(std::string_view s) const {
+        std::vector<size_t> ids;
+        band_keys(s, [&](size_t band, uint64_t key) {
+            auto it = buckets[band].find(key);
+            if (it != buckets[band].end()) ids.insert(ids.end(), it->second.begin(), it->second.end());
+        });
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        return ids;
+    }
+
+    /**
+     * @brief Every pair of indexed ids sharing a bucket, (i < j), sorted
+     *
+     * Pairs are deduplicated as they are found, so strings that collide in
+     * every band (say many very short ones) cost memory once per pair, not
+     * once per pair and band.
+     */
+    std::vector<std::pair<size_t, size_t>> candidate_pairs() const {
+        std::unordered_set<uint64_t> seen;  // (i << 32) | j; ids are 32-bit
+        for (auto const& table : buckets) {
+            for (auto const& [key, ids] : table) {
+                for (size_t a = 0; a < ids.size(); ++a) {
+                    for (size_t b = a + 1; b < ids.size(); ++b) {
+                        seen.insert(uint64_t(ids[a]) << 32 | ids[b]);
+                    }
+                }
+            }
+        }
+        std::vector<std::pair<size_t, size_t>> pairs;
+        pairs.reserve(seen.size());
+        for (uint64_t packed : seen) {
+            pairs.emplace_back(static_cast<size_t>(packed >> 32), static_cast<size_t>(packed & 0xffffffffU));
+        }
+        std::sort(pairs.begin(), pairs.end());
+        return pairs;
+    }
+
+private:
+    // Calls f(band, key) for each band of the signature of s
+    template <typename F>
+    void band_keys(std::string_view s, F&& f) const {
+        std::vector<uint64_t> signature(bands * rows);
+        hasher.signature(qgram_profile(s, q), signature);
+        for (size_t band = 0; band < bands; ++band) {
+            uint64_t key = band;
+            for (size_t r = 0; r < rows; ++r) {
+                key = alga::detail::mix64(key ^ signature[band * rows + r]);
+            }
+            f(band, key);
+        }
+    }
+
+    size_t bands;
+    size_t rows;
+    size_t q;
+    minhash hasher;
+    std::vector<std::unordered_map<uint64_t, std::vector<uint32_t>>> buckets;  // One table per band
+    size_t count = 0;
+};
+
+/**
+ * @brief Tuning knobs for near_duplicates
+ */
+struct lsh_options {
+    size_t bands = 16;  // Bucket tables
+    size_t rows = 4;    // Signature entries hashed per band
+    size_t q = 3;       // q-gram length
+    uint64_t seed = 0x9e3779b97f4a7c15ULL;
+};
+
+/**
+ * @brief Similar pairs found through LSH blocking, then verified exactly
+ *
+ * Same result format and threshold semantics as similarity_matrix, but
+ * only the candidate pairs of an lsh_index are scored, so the cost grows
+ * with the corpus and the number of near duplicates instead of with its
+ * square. Pairs whose q-gram Jaccard similarity is well below
+ * threshold() of the chosen bands and rows are likely to be missed.
+ */
+inline std::vector<similar_pair> near_duplicates(std::span<const std::string_view> strings, pair_metric metric,
+                                                 double threshold, lsh_options const& options = {}) {
+    lsh_index index(options.bands, options.rows, options.q, options.seed);
+    for (auto s : strings) index.insert(s);
+
+    std::vector<similar_pair> pairs;
+    for (auto [i, j] : index.candidate_pairs()) {
+        std::string_view a = strings[i];
+        std::string_view b = strings[j];
+        switch (metric) {
+            case pair_metric::levenshtein:
+            case pair_metric::damerau_levenshtein: {
+                if (threshold < 0) break;
+                size_t k = static_cast<size_t>(std::min(threshold, 1e15));
+                auto d = metric == pair_metric::levenshtein ? levenshtein_distance_bounded(a, b, k)
+                                                            : damerau_levenshtein_distance_bounded(a, b, k);
+                if (d) pairs.push_back({i, j, static_cast<double>(*d)});
+                break;
+            }
+            case pair_metric::jaro_winkler:
+            case pair_metric::lcs: {
+                double score = metric == pair_metric::lcs ? lcs_similarity(a, b) : jaro_winkler_similarity(a, b);
+                if (score >= threshold) pairs.push_back({i, j, score});
+                break;
+            }
+        }
+    }
+    return pairs;
+}
+
+} // namespace similarity
+} // namespace alga
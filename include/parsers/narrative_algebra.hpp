@@ -13,6 +13,9 @@
 #include <algorithm>
 #include <numeric>
 #include <functional>
+#include <cctype>
+#include <iterator>
+#include <memory>
 #include <complex>
 
 namespace alga {
@@ -533,23 +536,26 @@ public:
      */
     template<typename Iterator>
     std::pair<Iterator, std::optional<narrative_element>> parse(Iterator begin, Iterator end) const {
-        std::string sentence;
-        Iterator current = begin;
-        
         // Extract sentence (simplified - look for punctuation)
-        while (current != end && *current != '.' && *current != '!' && *current != '?') {
-            sentence += *current;
-            ++current;
-        }
+        Iterator sentence_end = std::find_if(begin, end, [](char c) {
+            return c == '.' || c == '!' || c == '?';
+        });
         
+        Iterator current = sentence_end;
         if (current != end) ++current; // Skip punctuation
         
-        if (sentence.empty()) {
+        if (sentence_end == begin) {
             return {current, std::nullopt};
         }
         
-        auto element = make_narrative_element(sentence);
-        return {current, element};
+        // Contiguous input is analyzed in place
+        if constexpr (std::contiguous_iterator<Iterator>) {
+            std::string_view sentence(std::to_address(begin), static_cast<size_t>(sentence_end - begin));
+            return {current, make_narrative_element(sentence)};
+        } else {
+            std::string sentence(begin, sentence_end);
+            return {current, make_narrative_element(sentence)};
+        }
     }
 };
 
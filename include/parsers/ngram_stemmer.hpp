@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <optional>
 #include <iostream>
+#include <concepts>
 
 namespace alga
 {
@@ -25,11 +26,11 @@ namespace alga
         // Initialize from array
         ngram_stem(std::array<Stem, N> s) : stems(std::move(s)) {}
         
-        // Initialize from initializer list  
+        // Initialize from initializer list (constrained so copies of an
+        // ngram_stem still go to the copy constructor)
         template<typename... Args>
-        ngram_stem(Args&&... args) : stems{std::forward<Args>(args)...} {
-            static_assert(sizeof...(Args) == N, "Number of arguments must match ngram size");
-        }
+            requires (sizeof...(Args) == N && (std::convertible_to<Args, Stem> && ...))
+        ngram_stem(Args&&... args) : stems{std::forward<Args>(args)...} {}
         
         // Full value semantics enabled by non-const members
         ngram_stem(ngram_stem const& other) = default;
@@ -197,19 +198,31 @@ namespace alga
     using bigram_stem = ngram_stem<2, porter2_stem>;
     using trigram_stem = ngram_stem<3, porter2_stem>;
     
+    // Inline-storage n-grams: building, copying and composing them never allocates
+    // while every stem fits in the inline buffer
+    using inline_unigram_stem = ngram_stem<1, inline_porter2_stem>;
+    using inline_bigram_stem = ngram_stem<2, inline_porter2_stem>;
+    using inline_trigram_stem = ngram_stem<3, inline_porter2_stem>;
+    
     // Convenience factory functions
-    inline unigram_stem make_unigram(porter2_stem stem)
+    template <typename Storage>
+    ngram_stem<1, basic_porter2_stem<Storage>> make_unigram(basic_porter2_stem<Storage> stem)
     {
-        return unigram_stem{std::move(stem)};
+        return ngram_stem<1, basic_porter2_stem<Storage>>{std::move(stem)};
     }
     
-    inline bigram_stem make_bigram(porter2_stem stem1, porter2_stem stem2)
+    template <typename Storage>
+    ngram_stem<2, basic_porter2_stem<Storage>> make_bigram(basic_porter2_stem<Storage> stem1,
+                                                           basic_porter2_stem<Storage> stem2)
     {
-        return bigram_stem{std::move(stem1), std::move(stem2)};
+        return ngram_stem<2, basic_porter2_stem<Storage>>{std::move(stem1), std::move(stem2)};
     }
     
-    inline trigram_stem make_trigram(porter2_stem stem1, porter2_stem stem2, porter2_stem stem3)
+    template <typename Storage>
+    ngram_stem<3, basic_porter2_stem<Storage>> make_trigram(basic_porter2_stem<Storage> stem1,
+                                                            basic_porter2_stem<Storage> stem2,
+                                                            basic_porter2_stem<Storage> stem3)
     {
-        return trigram_stem{std::move(stem1), std::move(stem2), std::move(stem3)};
+        return ngram_stem<3, basic_porter2_stem<Storage>>{std::move(stem1), std::move(stem2), std::move(stem3)};
     }
 }
\ No newline at end of file
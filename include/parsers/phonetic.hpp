@@ -3,12 +3,166 @@
 #include <string>
 #include <string_view>
 #include <algorithm>
-#include <cctype>
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
 #include <optional>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace alga {
 namespace phonetic {
 
+namespace detail {
+
+// Byte-indexed tables built at compile time. Only ASCII letters are case
+// mapped; every other byte maps to itself, so no locale is consulted.
+constexpr std::array<char, 256> make_upper_table() {
+    std::array<char, 256> table{};
+    for (int b = 0; b < 256; ++b) {
+        char c = static_cast<char>(b);
+        table[static_cast<size_t>(b)] = (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+    return table;
+}
+
+inline constexpr std::array<char, 256> upper_table = make_upper_table();
+
+constexpr char upper(char c) {
+    return upper_table[static_cast<unsigned char>(c)];
+}
+
+constexpr std::array<bool, 256> make_vowel_table() {
+    std::array<bool, 256> table{};
+    for (char c : std::string_view("aeiouAEIOU")) table[static_cast<unsigned char>(c)] = true;
+    return table;
+}
+
+inline constexpr std::array<bool, 256> vowel_table = make_vowel_table();
+
+constexpr bool is_vowel(char c) {
+    return vowel_table[static_cast<unsigned char>(c)];
+}
+
+// Soundex digit of every byte, '0' for vowels, h, w, y and non-letters
+constexpr std::array<char, 256> make_soundex_table() {
+    std::array<char, 256> table{};
+    table.fill('0');
+    constexpr std::string_view groups[] = {"bfpv", "cgjkqsxz", "dt", "l", "mn", "r"};
+    for (size_t g = 0; g < 6; ++g) {
+        for (char c : groups[g]) {
+            table[static_cast<unsigned char>(c)] = static_cast<char>('1' + g);
+            table[static_cast<unsigned char>(c - 'a' + 'A')] = static_cast<char>('1' + g);
+        }
+    }
+    return table;
+}
+
+inline constexpr std::array<char, 256> soundex_table = make_soundex_table();
+
+// How Metaphone treats a letter: emit 'out' unconditionally, or only when
+// the letter's context allows it
+enum class metaphone_rule : uint8_t {
+    always,
+    initial_only,      // Vowels: kept only as the first letter
+    between_vowels,    // H
+    not_after_c,       // K: silent in "CK"
+    before_vowel,      // W, Y
+    not_final_after_m, // B: silent in final "MB"
+    ks                 // X: two letters
+};
+
+struct metaphone_action {
+    char out;
+    metaphone_rule rule;
+};
+
+constexpr std::array<metaphone_action, 256> make_metaphone_table() {
+    std::array<metaphone_action, 256> table{};
+    for (int b = 0; b < 256; ++b) {
+        char c = upper(static_cast<char>(b));
+        metaphone_action action{c, metaphone_rule::always};
+        switch (c) {
+            case 'A': case 'E': case 'I': case 'O': case 'U':
+                action.rule = metaphone_rule::initial_only;
+                break;
+            case 'B': action.rule = metaphone_rule::not_final_after_m; break;
+            case 'C': case 'G': case 'Q': action.out = 'K'; break;
+            case 'D': action.out = 'T'; break;
+            case 'H': action.rule = metaphone_rule::between_vowels; break;
+            case 'K': action.rule = metaphone_rule::not_after_c; break;
+            case 'V': action.out = 'F'; break;
+            case 'W': case 'Y': action.rule = metaphone_rule::before_vowel; break;
+            case 'X': action.out = 'K'; action.rule = metaphone_rule::ks; break;
+            case 'Z': action.out = 'S'; break;
+            default: break;
+        }
+        table[static_cast<size_t>(b)] = action;
+    }
+    return table;
+}
+
+inline constexpr std::array<metaphone_action, 256> metaphone_table = make_metaphone_table();
+
+// Appends characters to a code packed big-endian into an integer: the
+// first character is the most significant byte and unused bytes are zero,
+// so comparing packed codes compares the strings. Holds sizeof(T) chars.
+template <typename T>
+struct packed_sink {
+    T value = 0;
+    size_t length = 0;
+
+    constexpr void push(char c) {
+        value |= static_cast<T>(static_cast<unsigned char>(c)) << (8 * (sizeof(T) - 1 - length));
+        ++length;
+    }
+    constexpr size_t size() const { return length; }
+};
+
+struct string_sink {
+    std::string value;
+
+    void push(char c) { value += c; }
+    size_t size() const { return value.size(); }
+};
+
+} // namespace detail
+
+/**
+ * @brief Soundex code packed into an integer
+ *
+ * The four ASCII characters of the code, first character in the most
+ * significant byte, so "S530" is 0x53353330. Equal codes are equal
+ * integers and integer order is string order.
+ */
+using soundex_code_t = uint32_t;
+
+/**
+ * @brief Metaphone code of up to 8 characters packed into an integer
+ *
+ * Packed like soundex_code_t, with unused trailing bytes zero.
+ */
+using metaphone_code_t = uint64_t;
+
+/**
+ * @brief Characters of a packed code, stopping at the first zero byte
+ */
+template <typename T>
+inline std::string unpack_code(T code) {
+    std::string text;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        char c = static_cast<char>((code >> (8 * (sizeof(T) - 1 - i))) & 0xff);
+        if (c == '\0') break;
+        text += c;
+    }
+    return text;
+}
+
 /**
  * @brief Soundex phonetic encoding
  *
@@ -21,72 +175,59 @@ namespace phonetic {
  * 3. Replace consonants with digits (b,f,p,v→1, c,g,j,k,q,s,x,z→2, etc.)
  * 4. Remove adjacent duplicates
  * 5. Pad/truncate to 4 characters
+ *
+ * Digits come from a compile-time 256-entry table; code() builds the
+ * packed result without branching on the letters and without allocating.
  */
 class Soundex {
-private:
-    static char get_soundex_code(char c) {
-        c = std::tolower(c);
-        switch (c) {
-            case 'b': case 'f': case 'p': case 'v':
-                return '1';
-            case 'c': case 'g': case 'j': case 'k':
-            case 'q': case 's': case 'x': case 'z':
-                return '2';
-            case 'd': case 't':
-                return '3';
-            case 'l':
-                return '4';
-            case 'm': case 'n':
-                return '5';
-            case 'r':
-                return '6';
-            default:
-                return '0';  // a,e,i,o,u,h,w,y
-        }
-    }
-
 public:
     /**
-     * @brief Encode a word using Soundex
+     * @brief Packed Soundex code of a word
      */
-    static std::string encode(std::string_view word) {
-        if (word.empty()) return "0000";
-
-        std::string result;
-        result.reserve(4);
+    static constexpr soundex_code_t code(std::string_view word) {
+        if (word.empty()) return 0x30303030;  // "0000"
 
         // Keep first letter (uppercase)
-        result += std::toupper(word[0]);
-
-        char prev_code = get_soundex_code(word[0]);
+        soundex_code_t packed = 0;
+        size_t length = 0;
+        char prev_code = '0';
 
-        // Process remaining letters
-        for (size_t i = 1; i < word.size() && result.size() < 4; ++i) {
-            char code = get_soundex_code(word[i]);
-
-            // Skip vowels and duplicates
-            if (code != '0' && code != prev_code) {
-                result += code;
+        for (size_t i = 0; i < word.size() && length < 4; ++i) {
+            if (i == 0) {
+                packed = static_cast<soundex_code_t>(static_cast<unsigned char>(detail::upper(word[0]))) << 24;
+                prev_code = detail::soundex_table[static_cast<unsigned char>(word[0])];
+                length = 1;
+                continue;
             }
+            char code = detail::soundex_table[static_cast<unsigned char>(word[i])];
+            bool coded = code != '0';
 
-            if (code != '0') {
-                prev_code = code;
-            }
+            // Skip vowels and duplicates
+            bool keep = coded & (code != prev_code);
+            packed |= static_cast<soundex_code_t>(keep) * (static_cast<soundex_code_t>(code) << (8 * (3 - length)));
+            length += keep;
+            prev_code = coded ? code : prev_code;
         }
 
         // Pad with zeros to length 4
-        while (result.size() < 4) {
-            result += '0';
+        for (; length < 4; ++length) {
+            packed |= soundex_code_t('0') << (8 * (3 - length));
         }
+        return packed;
+    }
 
-        return result;
+    /**
+     * @brief Encode a word using Soundex
+     */
+    static std::string encode(std::string_view word) {
+        return unpack_code(code(word));
     }
 
     /**
      * @brief Check if two words sound alike (have same Soundex code)
      */
     static bool sounds_like(std::string_view word1, std::string_view word2) {
-        return encode(word1) == encode(word2);
+        return code(word1) == code(word2);
     }
 };
 
@@ -97,184 +238,730 @@ public:
  * Produces variable-length phonetic codes.
  *
  * Simplified implementation focusing on common patterns.
+ *
+ * Each byte's transformation comes from a compile-time table of actions;
+ * only H, K, W, Y, B and vowels look at their neighbours. code() packs up
+ * to 7 letters (8 when the last is the two-letter X) into an integer.
  */
 class Metaphone {
 private:
-    static bool is_vowel(char c) {
-        c = std::tolower(c);
-        return c == 'a' || c == 'e' || c == 'i' || c == 'o' || c == 'u';
-    }
+    template <typename Sink>
+    static constexpr void run(std::string_view w, size_t max_length, Sink& result) {
+        auto at = [&](size_t i) { return i < w.size() ? detail::upper(w[i]) : '\0'; };
+
+        size_t i = 0;
+
+        // Drop initial letters in certain situations
+        if (w.size() >= 2) {
+            char first = at(0);
+            char second = at(1);
+            if ((second == 'N' && (first == 'P' || first == 'K' || first == 'G')) ||
+                (first == 'W' && second == 'R') || (first == 'A' && second == 'E')) {
+                i = 1;
+            } else if (first == 'X') {
+                result.push('S');
+                i = 1;
+            } else if (first == 'W' && second == 'H') {
+                result.push('W');
+                i = 2;
+            }
+        }
 
-    static char at(std::string_view s, size_t i) {
-        return i < s.size() ? std::tolower(s[i]) : '\0';
+        // Process each character
+        for (; i < w.size() && result.size() < max_length; ++i) {
+            detail::metaphone_action action = detail::metaphone_table[static_cast<unsigned char>(w[i])];
+            bool emit = true;
+            switch (action.rule) {
+                case detail::metaphone_rule::always:
+                    break;
+                case detail::metaphone_rule::initial_only:
+                    emit = i == 0;
+                    break;
+                case detail::metaphone_rule::between_vowels:
+                    emit = i > 0 && detail::is_vowel(w[i - 1]) && detail::is_vowel(at(i + 1));
+                    break;
+                case detail::metaphone_rule::not_after_c:
+                    emit = i == 0 || at(i - 1) != 'C';
+                    break;
+                case detail::metaphone_rule::before_vowel:
+                    emit = detail::is_vowel(at(i + 1));
+                    break;
+                case detail::metaphone_rule::not_final_after_m:
+                    // Silent b in "dumb"
+                    emit = !(i == w.size() - 1 && i > 0 && at(i - 1) == 'M');
+                    break;
+                case detail::metaphone_rule::ks:
+                    result.push('K');
+                    action.out = 'S';
+                    break;
+            }
+            if (emit) {
+                result.push(action.out);
+            }
+        }
     }
 
 public:
+    /**
+     * @brief Packed Metaphone code of a word, max_length capped at 7
+     */
+    static constexpr metaphone_code_t code(std::string_view word, size_t max_length = 4) {
+        detail::packed_sink<metaphone_code_t> result;
+        run(word, std::min<size_t>(max_length, 7), result);
+        return result.value;
+    }
+
     /**
      * @brief Encode a word using Metaphone
      */
     static std::string encode(std::string_view word, size_t max_length = 4) {
-        if (word.empty()) return "";
+        detail::string_sink result;
+        result.value.reserve(max_length + 1);
+        run(word, max_length, result);
+        return std::move(result.value);
+    }
 
-        std::string w;
-        for (char c : word) {
-            w += std::toupper(c);
+    /**
+     * @brief Check if two words sound alike (have same Metaphone code)
+     */
+    static bool sounds_like(std::string_view word1, std::string_view word2, size_t max_length = 4) {
+        if (max_length <= 7) {
+            return code(word1, max_length) == code(word2, max_length);
         }
+        return encode(word1, max_length) == encode(word2, max_length);
+    }
+};
 
-        std::string result;
-        result.reserve(max_length);
+/**
+ * @brief Primary and alternate Double Metaphone codes, packed
+ *
+ * Packed like metaphone_code_t. The alternate equals the primary for most
+ * words; it differs where a spelling has two plausible pronunciations
+ * ("Schmidt": XMT / SMT).
+ */
+struct double_metaphone_code {
+    metaphone_code_t primary = 0;
+    metaphone_code_t alternate = 0;
 
-        size_t i = 0;
+    friend bool operator==(double_metaphone_code const&, double_metaphone_code const&) = default;
+};
 
-        // Drop initial letters in certain situations
-        if (w.size() >= 2) {
-            if (w.substr(0, 2) == "PN" || w.substr(0, 2) == "KN" ||
-                w.substr(0, 2) == "GN" || w.substr(0, 2) == "WR" ||
-                w.substr(0, 2) == "AE") {
-                i = 1;
-            } else if (w[0] == 'X') {
-                result += 'S';
-                i = 1;
-            } else if (w.substr(0, 2) == "WH") {
-                result += 'W';
-                i = 2;
+/**
+ * @brief Double Metaphone phonetic encoding (Lawrence Philips, 2000)
+ *
+ * Handles many non-English spellings (Germanic, Slavic, Romance, Greek
+ * and Chinese surnames) and produces two codes per word. Words sound alike
+ * when any of their codes agree. Follows the widely used Apache Commons
+ * Codec rules, including their treatment of Latin-1 C-cedilla and N-tilde
+ * bytes.
+ *
+ * The word is read in place through the uppercase table; code() writes
+ * into two packed integers and allocates nothing.
+ */
+class DoubleMetaphone {
+private:
+    template <typename Sink>
+    class encoder {
+    public:
+        encoder(std::string_view word, size_t max_length) : max_length(max_length) {
+            // Surrounding whitespace and control characters are ignored
+            while (!word.empty() && static_cast<unsigned char>(word.front()) <= ' ') word.remove_prefix(1);
+            while (!word.empty() && static_cast<unsigned char>(word.back()) <= ' ') word.remove_suffix(1);
+            value = word;
+            slavo_germanic = find("W") || find("K") || find("CZ") || find("WITZ");
+        }
+
+        void run() {
+            const ptrdiff_t length = static_cast<ptrdiff_t>(value.size());
+            if (length == 0) return;
+
+            ptrdiff_t index = 0;
+            if (contains(0, {"GN", "KN", "PN", "WR", "PS"})) index = 1;
+
+            while (!complete() && index < length) {
+                char c = at(index);
+                switch (c) {
+                    case 'A': case 'E': case 'I': case 'O': case 'U': case 'Y':
+                        if (index == 0) append('A');
+                        ++index;
+                        break;
+                    case 'B':
+                        append('P');
+                        index += at(index + 1) == 'B' ? 2 : 1;
+                        break;
+                    case '\xC7': case '\xE7':  // Latin-1 C cedilla
+                        append('S');
+                        ++index;
+                        break;
+                    case 'C': index = handle_c(index); break;
+                    case 'D': index = handle_d(index); break;
+                    case 'F':
+                        append('F');
+                        index += at(index + 1) == 'F' ? 2 : 1;
+                        break;
+                    case 'G': index = handle_g(index); break;
+                    case 'H': index = handle_h(index); break;
+                    case 'J': index = handle_j(index); break;
+                    case 'K':
+                        append('K');
+                        index += at(index + 1) == 'K' ? 2 : 1;
+                        break;
+                    case 'L': index = handle_l(index); break;
+                    case 'M':
+                        append('M');
+                        index += condition_m0(index) ? 2 : 1;
+                        break;
+                    case 'N':
+                        append('N');
+                        index += at(index + 1) == 'N' ? 2 : 1;
+                        break;
+                    case '\xD1': case '\xF1':  // Latin-1 N tilde
+                        append('N');
+                        ++index;
+                        break;
+                    case 'P': index = handle_p(index); break;
+                    case 'Q':
+                        append('K');
+                        index += at(index + 1) == 'Q' ? 2 : 1;
+                        break;
+                    case 'R': index = handle_r(index); break;
+                    case 'S': index = handle_s(index); break;
+                    case 'T': index = handle_t(index); break;
+                    case 'V':
+                        append('F');
+                        index += at(index + 1) == 'V' ? 2 : 1;
+                        break;
+                    case 'W': index = handle_w(index); break;
+                    case 'X': index = handle_x(index); break;
+                    case 'Z': index = handle_z(index); break;
+                    default: ++index; break;
+                }
             }
         }
 
-        // Process each character
-        while (i < w.size() && result.size() < max_length) {
-            char c = w[i];
-            char next = at(w, i + 1);
-            char prev = i > 0 ? w[i - 1] : '\0';
-
-            switch (c) {
-                case 'A': case 'E': case 'I': case 'O': case 'U':
-                    if (i == 0) result += c;
-                    break;
+        Sink primary;
+        Sink alternate;
 
-                case 'B':
-                    if (i == w.size() - 1 && prev == 'M') {
-                        // Silent b in "dumb"
-                    } else {
-                        result += 'B';
-                    }
-                    break;
+    private:
+        std::string_view value;
+        size_t max_length;
+        bool slavo_germanic = false;
 
-                case 'C':
-                    if (next == 'H') {
-                        result += 'X';
-                        i++;
-                    } else if (next == 'I' || next == 'E' || next == 'Y') {
-                        result += 'S';
-                    } else {
-                        result += 'K';
-                    }
-                    break;
+        ptrdiff_t last() const { return static_cast<ptrdiff_t>(value.size()) - 1; }
 
-                case 'D':
-                    if (next == 'G' && (at(w, i+2) == 'E' || at(w, i+2) == 'I' || at(w, i+2) == 'Y')) {
-                        result += 'J';
-                        i++;
-                    } else {
-                        result += 'T';
-                    }
-                    break;
+        // Uppercased character at index, '\0' outside the word
+        char at(ptrdiff_t index) const {
+            if (index < 0 || index >= static_cast<ptrdiff_t>(value.size())) return '\0';
+            return detail::upper(value[static_cast<size_t>(index)]);
+        }
 
-                case 'G':
-                    if (next == 'H' && !is_vowel(at(w, i+2))) {
-                        // Silent gh
-                    } else if (next == 'N' && i == w.size() - 2) {
-                        // Silent g in "gn" at end
-                    } else if (next == 'E' || next == 'I' || next == 'Y') {
-                        result += 'J';
-                    } else {
-                        result += 'K';
-                    }
-                    break;
+        static bool is_vowel(char c) {
+            return c == 'A' || c == 'E' || c == 'I' || c == 'O' || c == 'U' || c == 'Y';
+        }
 
-                case 'H':
-                    if (!is_vowel(prev) || !is_vowel(next)) {
-                        // H is silent unless between vowels
-                    } else {
-                        result += 'H';
-                    }
-                    break;
+        bool matches(ptrdiff_t start, std::string_view pattern) const {
+            if (start < 0 || start + static_cast<ptrdiff_t>(pattern.size()) > static_cast<ptrdiff_t>(value.size())) {
+                return false;
+            }
+            for (size_t i = 0; i < pattern.size(); ++i) {
+                if (at(start + static_cast<ptrdiff_t>(i)) != pattern[i]) return false;
+            }
+            return true;
+        }
 
-                case 'K':
-                    if (prev != 'C') {
-                        result += 'K';
-                    }
-                    break;
+        // Whether any of the (equal length) patterns occurs at start
+        bool contains(ptrdiff_t start, std::initializer_list<std::string_view> patterns) const {
+            for (auto p : patterns) {
+                if (matches(start, p)) return true;
+            }
+            return false;
+        }
 
-                case 'P':
-                    if (next == 'H') {
-                        result += 'F';
-                        i++;
-                    } else {
-                        result += 'P';
-                    }
-                    break;
+        bool find(std::string_view pattern) const {
+            for (ptrdiff_t i = 0; i + static_cast<ptrdiff_t>(pattern.size()) <= static_cast<ptrdiff_t>(value.size()); ++i) {
+                if (matches(i, pattern)) return true;
+            }
+            return false;
+        }
 
-                case 'Q':
-                    result += 'K';
-                    break;
+        bool complete() const {
+            return primary.size() >= max_length && alternate.size() >= max_length;
+        }
 
-                case 'S':
-                    if (next == 'H') {
-                        result += 'X';
-                        i++;
-                    } else if (next == 'I' && (at(w, i+2) == 'O' || at(w, i+2) == 'A')) {
-                        result += 'X';
-                    } else {
-                        result += 'S';
-                    }
-                    break;
+        void append_primary(std::string_view s) {
+            for (char c : s) {
+                if (primary.size() < max_length) primary.push(c);
+            }
+        }
 
-                case 'T':
-                    if (next == 'H') {
-                        result += '0';
-                        i++;
-                    } else if (next == 'I' && (at(w, i+2) == 'O' || at(w, i+2) == 'A')) {
-                        result += 'X';
+        void append_alternate(std::string_view s) {
+            for (char c : s) {
+                if (alternate.size() < max_length) alternate.push(c);
+            }
+        }
+
+        void append(std::string_view s) {
+            append_primary(s);
+            append_alternate(s);
+        }
+
+        void append(std::string_view p, std::string_view a) {
+            append_primary(p);
+            append_alternate(a);
+        }
+
+        void append(char c) { append(std::string_view(&c, 1)); }
+        void append(char p, char a) { append(std::string_view(&p, 1), std::string_view(&a, 1)); }
+
+        ptrdiff_t handle_c(ptrdiff_t index) {
+            if (condition_c0(index)) {
+                append('K');
+                return index + 2;
+            }
+            if (index == 0 && matches(index, "CAESAR")) {
+                append('S');
+                return index + 2;
+            }
+            if (matches(index, "CH")) return handle_ch(index);
+            if (matches(index, "CZ") && !matches(index - 2, "WICZ")) {
+                // "Czerny"
+                append('S', 'X');
+                return index + 2;
+            }
+            if (matches(index + 1, "CIA")) {
+                // "Focaccia"
+                append('X');
+                return index + 3;
+            }
+            if (matches(index, "CC") && !(index == 1 && at(0) == 'M')) {
+                // Double C, but not "McClellan"
+                return handle_cc(index);
+            }
+            if (contains(index, {"CK", "CG", "CQ"})) {
+                append('K');
+                return index + 2;
+            }
+            if (contains(index, {"CI", "CE", "CY"})) {
+                // Italian vs. English
+                if (contains(index, {"CIO", "CIE", "CIA"})) {
+                    append('S', 'X');
+                } else {
+                    append('S');
+                }
+                return index + 2;
+            }
+
+            append('K');
+            if (contains(index + 1, {" C", " Q", " G"})) {
+                // "Mac Caffrey", "Mac Gregor"
+                return index + 3;
+            }
+            if (contains(index + 1, {"C", "K", "Q"}) && !contains(index + 1, {"CE", "CI"})) {
+                return index + 2;
+            }
+            return index + 1;
+        }
+
+        ptrdiff_t handle_cc(ptrdiff_t index) {
+            if (contains(index + 2, {"I", "E", "H"}) && !matches(index + 2, "HU")) {
+                // "Bellocchio" but not "Bacchus"
+                if ((index == 1 && at(index - 1) == 'A') || contains(index - 1, {"UCCEE", "UCCES"})) {
+                    // "Accident", "Accede", "Succeed"
+                    append("KS");
+                } else {
+                    // "Bacci", "Bertucci", other Italian
+                    append('X');
+                }
+                return index + 3;
+            }
+            // Pierce's rule
+            append('K');
+            return index + 2;
+        }
+
+        ptrdiff_t handle_ch(ptrdiff_t index) {
+            if (index > 0 && matches(index, "CHAE")) {
+                // "Michael"
+                append('K', 'X');
+                return index + 2;
+            }
+            if (condition_ch0(index) || condition_ch1(index)) {
+                // Greek roots ("chemistry", "chorus") and Germanic "ch"
+                append('K');
+                return index + 2;
+            }
+            if (index > 0) {
+                if (matches(0, "MC")) {
+                    append('K');
+                } else {
+                    append('X', 'K');
+                }
+            } else {
+                append('X');
+            }
+            return index + 2;
+        }
+
+        ptrdiff_t handle_d(ptrdiff_t index) {
+            if (matches(index, "DG")) {
+                if (contains(index + 2, {"I", "E", "Y"})) {
+                    // "Edge"
+                    append('J');
+                    return index + 3;
+                }
+                // "Edgar"
+                append("TK");
+                return index + 2;
+            }
+            append('T');
+            return contains(index, {"DT", "DD"}) ? index + 2 : index + 1;
+        }
+
+        ptrdiff_t handle_g(ptrdiff_t index) {
+            char next = at(index + 1);
+            if (next == 'H') return handle_gh(index);
+            if (next == 'N') {
+                if (index == 1 && is_vowel(at(0)) && !slavo_germanic) {
+                    append("KN", "N");
+                } else if (!matches(index + 2, "EY") && at(index + 1) != 'Y' && !slavo_germanic) {
+                    append("N", "KN");
+                } else {
+                    append("KN");
+                }
+                return index + 2;
+            }
+            if (matches(index + 1, "LI") && !slavo_germanic) {
+                append("KL", "L");
+                return index + 2;
+            }
+            if (index == 0 && (next == 'Y' || contains(index + 1, {"ES", "EP", "EB", "EL", "EY", "IB", "IL", "IN",
+                                                                   "IE", "EI", "ER"}))) {
+                // -ges-, -gep-, -gel-, -gie- at beginning
+                append('K', 'J');
+                return index + 2;
+            }
+            if ((matches(index + 1, "ER") || next == 'Y') &&
+                !contains(0, {"DANGER", "RANGER", "MANGER"}) &&
+                !contains(index - 1, {"E", "I"}) &&
+                !contains(index - 1, {"RGY", "OGY"})) {
+                // -ger-, -gy-
+                append('K', 'J');
+                return index + 2;
+            }
+            if (contains(index + 1, {"E", "I", "Y"}) || contains(index - 1, {"AGGI", "OGGI"})) {
+                // Italian "biaggi"
+                if (contains(0, {"VAN ", "VON "}) || matches(0, "SCH") || matches(index + 1, "ET")) {
+                    // Obvious Germanic
+                    append('K');
+                } else if (matches(index + 1, "IER")) {
+                    append('J');
+                } else {
+                    append('J', 'K');
+                }
+                return index + 2;
+            }
+            append('K');
+            return next == 'G' ? index + 2 : index + 1;
+        }
+
+        ptrdiff_t handle_gh(ptrdiff_t index) {
+            if (index > 0 && !is_vowel(at(index - 1))) {
+                append('K');
+                return index + 2;
+            }
+            if (index == 0) {
+                append(at(index + 2) == 'I' ? 'J' : 'K');
+                return index + 2;
+            }
+            if ((index > 1 && contains(index - 2, {"B", "H", "D"})) ||
+                (index > 2 && contains(index - 3, {"B", "H", "D"})) ||
+                (index > 3 && contains(index - 4, {"B", "H"}))) {
+                // Parker's rule (with some further refinements): "hugh", "bough", "broughton"
+                return index + 2;
+            }
+            if (index > 2 && at(index - 1) == 'U' && contains(index - 3, {"C", "G", "L", "R", "T"})) {
+                // "laugh", "McLaughlin", "cough", "gough", "rough", "tough"
+                append('F');
+            } else if (index > 0 && at(index - 1) != 'I') {
+                append('K');
+            }
+            return index + 2;
+        }
+
+        ptrdiff_t handle_h(ptrdiff_t index) {
+            // Only keep if first and before a vowel, or between two vowels
+            if ((index == 0 || is_vowel(at(index - 1))) && is_vowel(at(index + 1))) {
+                append('H');
+                return index + 2;
+            }
+            return index + 1;
+        }
+
+        ptrdiff_t handle_j(ptrdiff_t index) {
+            if (matches(index, "JOSE") || matches(0, "SAN ")) {
+                // Obvious Spanish: "Jose", "San Jacinto"
+                if ((index == 0 && at(index + 4) == ' ') || value.size() == 4 || matches(0, "SAN ")) {
+                    append('H');
+                } else {
+                    append('J', 'H');
+                }
+                return index + 1;
+            }
+            if (index == 0 && !matches(index, "JOSE")) {
+                append('J', 'A');
+            } else if (is_vowel(at(index - 1)) && !slavo_germanic && (at(index + 1) == 'A' || at(index + 1) == 'O')) {
+                append('J', 'H');
+            } else if (index == last()) {
+                append('J', ' ');
+            } else if (!contains(index + 1, {"L", "T", "K", "S", "N", "M", "B", "Z"}) &&
+                       !contains(index - 1, {"S", "K", "L"})) {
+                append('J');
+            }
+            return at(index + 1) == 'J' ? index + 2 : index + 1;
+        }
+
+        ptrdiff_t handle_l(ptrdiff_t index) {
+            if (at(index + 1) == 'L') {
+                if (condition_l0(index)) {
+                    // Spanish "cabrillo", "gallegos"
+                    append_primary("L");
+                } else {
+                    append('L');
+                }
+                return index + 2;
+            }
+            append('L');
+            return index + 1;
+        }
+
+        ptrdiff_t handle_p(ptrdiff_t index) {
+            if (at(index + 1) == 'H') {
+                append('F');
+                return index + 2;
+            }
+            append('P');
+            return contains(index + 1, {"P", "B"}) ? index + 2 : index + 1;
+        }
+
+        ptrdiff_t handle_r(ptrdiff_t index) {
+            // French "Rogier"
+            if (index == last() && !slavo_germanic && matches(index - 2, "IE") && !contains(index - 4, {"ME", "MA"})) {
+                append_alternate("R");
+            } else {
+                append('R');
+            }
+            return at(index + 1) == 'R' ? index + 2 : index + 1;
+        }
+
+        ptrdiff_t handle_s(ptrdiff_t index) {
+            if (contains(index - 1, {"ISL", "YSL"})) {
+                // Special cases "island", "isle", "carlisle", "carlysle"
+                return index + 1;
+            }
+            if (index == 0 && matches(index, "SUGAR")) {
+                // Special case "sugar-"
+                append('X', 'S');
+                return index + 1;
+            }
+            if (matches(index, "SH")) {
+                // Germanic
+                append(contains(index + 1, {"HEIM", "HOEK", "HOLM", "HOLZ"}) ? 'S' : 'X');
+                return index + 2;
+            }
+            if (contains(index, {"SIO", "SIA"}) || matches(index, "SIAN")) {
+                // Italian and Armenian
+                if (slavo_germanic) {
+                    append('S');
+                } else {
+                    append('S', 'X');
+                }
+                return index + 3;
+            }
+            if ((index == 0 && contains(index + 1, {"M", "N", "L", "W"})) || matches(index + 1, "Z")) {
+                // German and Anglicisations: "Smith" matches "Schmidt", "Snider" matches "Schneider"
+                append('S', 'X');
+                return matches(index + 1, "Z") ? index + 2 : index + 1;
+            }
+            if (matches(index, "SC")) return handle_sc(index);
+
+            if (index == last() && contains(index - 2, {"AI", "OI"})) {
+                // French "resnais", "artois"
+                append_alternate("S");
+            } else {
+                append('S');
+            }
+            return contains(index + 1, {"S", "Z"}) ? index + 2 : index + 1;
+        }
+
+        ptrdiff_t handle_sc(ptrdiff_t index) {
+            if (at(index + 2) == 'H') {
+                if (contains(index + 3, {"OO", "ER", "EN", "UY", "ED", "EM"})) {
+                    // Dutch origin: "school", "schooner"
+                    if (contains(index + 3, {"ER", "EN"})) {
+                        // "Schermerhorn", "Schenker"
+                        append("X", "SK");
                     } else {
-                        result += 'T';
+                        append("SK");
                     }
-                    break;
+                } else if (index == 0 && !is_vowel(at(3)) && at(3) != 'W') {
+                    append('X', 'S');
+                } else {
+                    append('X');
+                }
+            } else if (contains(index + 2, {"I", "E", "Y"})) {
+                append('S');
+            } else {
+                append("SK");
+            }
+            return index + 3;
+        }
 
-                case 'V':
-                    result += 'F';
-                    break;
+        ptrdiff_t handle_t(ptrdiff_t index) {
+            if (matches(index, "TION") || contains(index, {"TIA", "TCH"})) {
+                append('X');
+                return index + 3;
+            }
+            if (matches(index, "TH") || matches(index, "TTH")) {
+                if (contains(index + 2, {"OM", "AM"}) || contains(0, {"VAN ", "VON "}) || matches(0, "SCH")) {
+                    // Special case "Thomas", "Thames" or Germanic
+                    append('T');
+                } else {
+                    append('0', 'T');
+                }
+                return index + 2;
+            }
+            append('T');
+            return contains(index + 1, {"T", "D"}) ? index + 2 : index + 1;
+        }
 
-                case 'W': case 'Y':
-                    if (is_vowel(next)) {
-                        result += c;
-                    }
-                    break;
+        ptrdiff_t handle_w(ptrdiff_t index) {
+            if (matches(index, "WR")) {
+                // Can also be in the middle of a word
+                append('R');
+                return index + 2;
+            }
+            if (index == 0 && (is_vowel(at(index + 1)) || matches(index, "WH"))) {
+                // "Wasserman" should match "Vasserman"
+                if (is_vowel(at(index + 1))) {
+                    append('A', 'F');
+                } else {
+                    // Need "Uomo" to match "Womo"
+                    append('A');
+                }
+                return index + 1;
+            }
+            if ((index == last() && is_vowel(at(index - 1))) ||
+                contains(index - 1, {"EWSKI", "EWSKY", "OWSKI", "OWSKY"}) || matches(0, "SCH")) {
+                // "Arnow" should match "Arnoff"
+                append_alternate("F");
+                return index + 1;
+            }
+            if (contains(index, {"WICZ", "WITZ"})) {
+                // Polish "Filipowicz"
+                append("TS", "FX");
+                return index + 4;
+            }
+            return index + 1;
+        }
 
-                case 'X':
-                    result += "KS";
-                    break;
+        ptrdiff_t handle_x(ptrdiff_t index) {
+            if (index == 0) {
+                append('S');
+                return index + 1;
+            }
+            if (!(index == last() && (contains(index - 3, {"IAU", "EAU"}) || contains(index - 2, {"AU", "OU"})))) {
+                // French "breaux" is silent
+                append("KS");
+            }
+            return contains(index + 1, {"C", "X"}) ? index + 2 : index + 1;
+        }
 
-                case 'Z':
-                    result += 'S';
-                    break;
+        ptrdiff_t handle_z(ptrdiff_t index) {
+            if (at(index + 1) == 'H') {
+                // Chinese "Zhao"
+                append('J');
+                return index + 2;
+            }
+            if (contains(index + 1, {"ZO", "ZI", "ZA"}) || (slavo_germanic && index > 0 && at(index - 1) != 'T')) {
+                append("S", "TS");
+            } else {
+                append('S');
+            }
+            return at(index + 1) == 'Z' ? index + 2 : index + 1;
+        }
 
-                default:
-                    result += c;
-                    break;
+        bool condition_c0(ptrdiff_t index) const {
+            // Various Germanic: "Bacher", "Macher", but not "Bachelor"
+            if (matches(index, "CHIA")) return true;
+            if (index <= 1) return false;
+            if (is_vowel(at(index - 2))) return false;
+            if (!matches(index - 1, "ACH")) return false;
+            char c = at(index + 2);
+            return (c != 'I' && c != 'E') || contains(index - 2, {"BACHER", "MACHER"});
+        }
+
+        bool condition_ch0(ptrdiff_t index) const {
+            // Greek roots at the start: "chemistry", "chorus"
+            if (index != 0) return false;
+            if (!contains(index + 1, {"HARAC", "HARIS"}) && !contains(index + 1, {"HOR", "HYM", "HIA", "HEM"})) {
+                return false;
             }
+            return !matches(0, "CHORE");
+        }
+
+        bool condition_ch1(ptrdiff_t index) const {
+            // Germanic, Greek or otherwise "ch" for "kh" sound
+            return contains(0, {"VAN ", "VON "}) || matches(0, "SCH") ||
+                   contains(index - 2, {"ORCHES", "ARCHIT", "ORCHID"}) ||
+                   contains(index + 2, {"T", "S"}) ||
+                   ((contains(index - 1, {"A", "O", "U", "E"}) || index == 0) &&
+                    (contains(index + 2, {"L", "R", "N", "M", "B", "H", "F", "V", "W", " "}) || index + 1 == last()));
+        }
+
+        bool condition_l0(ptrdiff_t index) const {
+            if (index == last() - 2 && contains(index - 1, {"ILLO", "ILLA", "ALLE"})) return true;
+            return (contains(last() - 1, {"AS", "OS"}) || contains(last(), {"A", "O"})) &&
+                   matches(index - 1, "ALLE");
+        }
 
-            i++;
+        bool condition_m0(ptrdiff_t index) const {
+            if (at(index + 1) == 'M') return true;
+            return matches(index - 1, "UMB") && (index + 1 == last() || matches(index + 2, "ER"));
         }
+    };
 
-        return result;
+public:
+    /**
+     * @brief Packed primary and alternate codes, max_length capped at 8
+     */
+    static double_metaphone_code code(std::string_view word, size_t max_length = 4) {
+        encoder<detail::packed_sink<metaphone_code_t>> e(word, std::min<size_t>(max_length, 8));
+        e.run();
+        return {e.primary.value, e.alternate.value};
     }
 
     /**
-     * @brief Check if two words sound alike (have same Metaphone code)
+     * @brief Primary and alternate codes as strings
+     */
+    static std::pair<std::string, std::string> encode(std::string_view word, size_t max_length = 4) {
+        encoder<detail::string_sink> e(word, max_length);
+        e.run();
+        return {std::move(e.primary.value), std::move(e.alternate.value)};
+    }
+
+    /**
+     * @brief Check if any code of one word equals any code of the other
      */
     static bool sounds_like(std::string_view word1, std::string_view word2, size_t max_length = 4) {
-        return encode(word1, max_length) == encode(word2, max_length);
+        if (max_length <= 8) {
+            auto a = code(word1, max_length);
+            auto b = code(word2, max_length);
+            return a.primary == b.primary || a.primary == b.alternate ||
+                   a.alternate == b.primary || a.alternate == b.alternate;
+        }
+        auto a = encode(word1, max_length);
+        auto b = encode(word2, max_length);
+        return a.first == b.first || a.first == b.second || a.second == b.first || a.second == b.second;
     }
 };
 
@@ -290,6 +977,14 @@ inline std::string metaphone(std::string_view word, size_t max_length = 4) {
     return Metaphone::encode(word, max_length);
 }
 
+inline soundex_code_t soundex_code(std::string_view word) {
+    return Soundex::code(word);
+}
+
+inline metaphone_code_t metaphone_code(std::string_view word, size_t max_length = 4) {
+    return Metaphone::code(word, max_length);
+}
+
 inline bool sounds_like_soundex(std::string_view word1, std::string_view word2) {
     return Soundex::sounds_like(word1, word2);
 }
@@ -298,5 +993,123 @@ inline bool sounds_like_metaphone(std::string_view word1, std::string_view word2
     return Metaphone::sounds_like(word1, word2, max_length);
 }
 
+inline double_metaphone_code double_metaphone_code_of(std::string_view word, size_t max_length = 4) {
+    return DoubleMetaphone::code(word, max_length);
+}
+
+inline std::pair<std::string, std::string> double_metaphone(std::string_view word, size_t max_length = 4) {
+    return DoubleMetaphone::encode(word, max_length);
+}
+
+inline bool sounds_like_double_metaphone(std::string_view word1, std::string_view word2, size_t max_length = 4) {
+    return DoubleMetaphone::sounds_like(word1, word2, max_length);
+}
+
+/**
+ * @brief Phonetic encoding used by a PhoneticIndex
+ */
+enum class phonetic_algorithm { soundex, metaphone, double_metaphone };
+
+/**
+ * @brief Posting lists of record ids keyed by packed phonetic code
+ *
+ * Each inserted word is encoded once and its id appended to the posting
+ * list of its code (of both codes, for Double Metaphone). Finding every
+ * record that sounds like a query is then one encoding and one or two
+ * hash lookups, instead of encoding both sides of every pair.
+ *
+ * Record ids are 32-bit, so an index holds at most max_size() words.
+ */
+class PhoneticIndex {
+public:
+    explicit PhoneticIndex(phonetic_algorithm algorithm = phonetic_algorithm::double_metaphone,
+                           size_t max_length = 4)
+        : algorithm(algorithm),
+          max_length(std::min<size_t>(max_length, algorithm == phonetic_algorithm::metaphone ? 7 : 8)) {}
+
+    /**
+     * @brief Add a word, returning its record id (ids count up from 0)
+     *
+     * Throws std::length_error once max_size() words are indexed.
+     */
+    uint32_t insert(std::string_view word) {
+        if (count >= max_size()) throw std::length_error("PhoneticIndex: more than max_size() words");
+        const uint32_t id = count++;
+        auto [primary, alternate] = keys(word);
+        postings[primary].push_back(id);
+        if (alternate != primary) {
+            postings[alternate].push_back(id);
+        }
+        return id;
+    }
+
+    /**
+     * @brief Primary and alternate key of a word under this index's encoding
+     *
+     * Both are the same key except for Double Metaphone.
+     */
+    std::pair<uint64_t, uint64_t> keys(std::string_view word) const {
+        switch (algorithm) {
+            case phonetic_algorithm::soundex: {
+                uint64_t key = Soundex::code(word);
+                return {key, key};
+            }
+            case phonetic_algorithm::metaphone: {
+                uint64_t key = Metaphone::code(word, max_length);
+                return {key, key};
+            }
+            case phonetic_algorithm::double_metaphone: {
+                auto code = DoubleMetaphone::code(word, max_length);
+                return {code.primary, code.alternate};
+            }
+        }
+        return {0, 0};
+    }
+
+    /**
+     * @brief Record ids filed under one key, ascending
+     */
+    std::span<const uint32_t> postings_for(uint64_t key) const {
+        auto it = postings.find(key);
+        if (it == postings.end()) return {};
+        return it->second;
+    }
+
+    /**
+     * @brief Ids of every record sharing a key with word, ascending
+     */
+    std::vector<uint32_t> lookup(std::string_view word) const {
+        auto [primary, alternate] = keys(word);
+        auto first = postings_for(primary);
+        std::vector<uint32_t> ids(first.begin(), first.end());
+        if (alternate != primary) {
+            auto second = postings_for(alternate);
+            std::vector<uint32_t> merged;
+            merged.reserve(ids.size() + second.size());
+            std::set_union(ids.begin(), ids.end(), second.begin(), second.end(), std::back_inserter(merged));
+            ids = std::move(merged);
+        }
+        return ids;
+    }
+
+    /**
+     * @brief Whether any record sounds like word
+     */
+    bool sounds_like_any(std::string_view word) const {
+        auto [primary, alternate] = keys(word);
+        return postings.count(primary) > 0 || (alternate != primary && postings.count(alternate) > 0);
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    static constexpr size_t max_size() { return std::numeric_limits<uint32_t>::max(); }
+
+private:
+    phonetic_algorithm algorithm;
+    size_t max_length;
+    uint32_t count = 0;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> postings;
+};
+
 } // namespace phonetic
 } // namespace alga
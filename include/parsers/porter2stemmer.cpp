@@ -1,136 +1,309 @@
-#include <vector>
 #include <algorithm>
-#include <utility>
-#include <unordered_map>
+#include <array>
+#include <cstring>
+#include <span>
 #include <string>
+#include <string_view>
 using std::string;
-
-static size_t firstNonVowelAfterVowel(const string& word, size_t start);
-static size_t getStartR1(const string& word);
-static size_t getStartR2(const string& word, size_t startR1);
-static void changeY(string& word);
-static void step0(string& word);
-static bool step1A(string& word);
-static void step1B(string& word, size_t startR1);
-static void step1C(string& word);
-static void step2(string& word, size_t startR1);
-static void step3(string& word, size_t startR1, size_t startR2);
-static void step4(string& word, size_t startR2);
-static void step5(string& word, size_t startR1, size_t startR2);
-static bool isShort(const string& word);
-static bool special(string& word);
-static bool isVowel(char ch);
-static bool isVowelY(char ch);
-static bool endsWith(const string& word, const string& str);
-static bool endsInDouble(const string& word);
-static bool replaceIfExists(string& word,
-                        const string& suffix, const string& replacement,
-                        size_t start);
-static bool isValidLIEnding(char ch);
-static bool containsVowel(const string& word, size_t start, size_t end);
+using std::string_view;
 
 namespace alga {
+    size_t porter2stemmer(std::span<char> buffer);
+    void porter2stemmer(string & word);
+}
 
-    void porter2stemmer(string & word)
+/**
+ * The procedures below are internal to the implementation of porter2stemmer
+ * and not externally visible.
+ *
+ * The word is edited in place inside the caller's buffer; every Porter2
+ * rewrite produces a suffix no longer than the one it replaces, so the word
+ * never grows past its original length and nothing is allocated. Suffix
+ * rules live in constexpr tables of string_views.
+ */
+namespace {
+namespace inplace {
+
+struct Word
+{
+    char* p;
+    size_t n;
+
+    string_view view() const { return string_view(p, n); }
+    bool endsWith(string_view s) const
     {
-        // special case short words
-        if(word.size() <= 2)
-            return;
+        return n >= s.size() && std::memcmp(p + n - s.size(), s.data(), s.size()) == 0;
+    }
+    bool startsWith(string_view s) const
+    {
+        return n >= s.size() && std::memcmp(p, s.data(), s.size()) == 0;
+    }
+    bool operator==(string_view s) const { return view() == s; }
+    char back() const { return p[n - 1]; }
+    void assign(string_view s)
+    {
+        std::memcpy(p, s.data(), s.size());
+        n = s.size();
+    }
+};
 
-        // max word length is 35 for English
-        if(word.size() > 35)
-            word = word.substr(0, 35);
+struct Rule
+{
+    string_view suffix;
+    string_view replacement;
+};
+
+constexpr std::array<Rule, 11> exceptions = {{
+    {"skis", "ski"}, {"skies", "sky"}, {"dying", "die"}, {"lying", "lie"},
+    {"tying", "tie"}, {"idly", "idl"}, {"gently", "gentl"}, {"ugly", "ugli"},
+    {"early", "earli"}, {"only", "onli"}, {"singly", "singl"}
+}};
+
+constexpr std::array<string_view, 7> invariants = {
+    "sky", "news", "howe", "atlas", "cosmos", "bias", "andes"
+};
+
+constexpr std::array<string_view, 8> step1AStops = {
+    "inning", "outing", "canning", "herring", "earring", "proceed", "exceed", "succeed"
+};
+
+constexpr std::array<Rule, 22> step2Rules = {{
+    {"ational", "ate"}, {"tional", "tion"}, {"enci", "ence"}, {"anci", "ance"},
+    {"abli", "able"}, {"entli", "ent"}, {"izer", "ize"}, {"ization", "ize"},
+    {"ation", "ate"}, {"ator", "ate"}, {"alism", "al"}, {"aliti", "al"},
+    {"alli", "al"}, {"fulness", "ful"}, {"ousli", "ous"}, {"ousness", "ous"},
+    {"iveness", "ive"}, {"iviti", "ive"}, {"biliti", "ble"}, {"bli", "ble"},
+    {"fulli", "ful"}, {"lessli", "less"}
+}};
+
+constexpr std::array<string_view, 8> step2LiLonger = {
+    "abli", "entli", "aliti", "alli", "ousli", "bli", "fulli", "lessli"
+};
+
+constexpr std::array<Rule, 8> step3Rules = {{
+    {"ational", "ate"}, {"tional", "tion"}, {"alize", "al"}, {"icate", "ic"},
+    {"iciti", "ic"}, {"ical", "ic"}, {"ful", ""}, {"ness", ""}
+}};
+
+constexpr std::array<Rule, 16> step4Rules = {{
+    {"al", ""}, {"ance", ""}, {"ence", ""}, {"er", ""}, {"ic", ""},
+    {"able", ""}, {"ible", ""}, {"ant", ""}, {"ement", ""}, {"ment", ""},
+    {"ism", ""}, {"ate", ""}, {"iti", ""}, {"ous", ""}, {"ive", ""}, {"ize", ""}
+}};
+
+template <size_t N>
+constexpr bool rulesNeverGrow(std::array<Rule, N> const& rules)
+{
+    for (auto const& rule : rules) {
+        if (rule.replacement.size() > rule.suffix.size()) return false;
+    }
+    return true;
+}
 
-        if(word[0] == '\'')
-            word = word.substr(1, word.size() - 1);
+static_assert(rulesNeverGrow(exceptions) && rulesNeverGrow(step2Rules)
+              && rulesNeverGrow(step3Rules) && rulesNeverGrow(step4Rules),
+              "in-place stemming requires rewrites that never lengthen the word");
 
-        if(special(word))
-            return;
+bool isVowel(char ch)
+{
+    return ch == 'e' || ch == 'a' || ch == 'i' || ch == 'o' || ch == 'u';
+}
 
-        changeY(word);
-        size_t startR1 = getStartR1(word);
-        size_t startR2 = getStartR2(word, startR1);
+bool isVowelY(char ch)
+{
+    return isVowel(ch) || ch == 'y';
+}
+
+bool isValidLIEnding(char ch)
+{
+    return ch == 'c' || ch == 'd' || ch == 'e' || ch == 'g' || ch == 'h'
+           || ch == 'k' || ch == 'm' || ch == 'n' || ch == 'r' || ch == 't';
+}
+
+bool replaceIfExists(Word& word, string_view suffix, string_view replacement, size_t start)
+{
+    if(!(start > word.n) && word.n - start >= suffix.size() && word.endsWith(suffix))
+    {
+        word.n -= suffix.size();
+        std::memcpy(word.p + word.n, replacement.data(), replacement.size());
+        word.n += replacement.size();
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Compile-time dispatch index over a suffix rule table.
+ *
+ * Rules are bucketed by their final letter with a stable counting sort, so
+ * within a bucket they keep table order and "first rule that matches and
+ * lies in the region wins" is preserved exactly. A lookup inspects only the
+ * rules sharing the word's last letter (at most seven for step 4) and
+ * rejects most of those on the second-to-last letter before comparing the
+ * rest of the suffix.
+ */
+constexpr size_t letterBucket(char ch)
+{
+    return (ch >= 'a' && ch <= 'z') ? static_cast<size_t>(ch - 'a') : 26;
+}
 
-        step0(word);
+template <size_t N>
+struct SuffixIndex
+{
+    std::array<Rule, N> rules{};
+    std::array<size_t, 28> start{};   // bucket b is rules[start[b], start[b + 1])
+};
 
-        if(step1A(word))
+template <size_t N>
+constexpr SuffixIndex<N> indexByLastLetter(std::array<Rule, N> const& table)
+{
+    SuffixIndex<N> index;
+    for(auto const& rule : table)
+        ++index.start[letterBucket(rule.suffix.back()) + 1];
+    for(size_t b = 1; b < index.start.size(); ++b)
+        index.start[b] += index.start[b - 1];
+
+    std::array<size_t, 27> fill{};
+    for(auto const& rule : table)
+    {
+        size_t b = letterBucket(rule.suffix.back());
+        index.rules[index.start[b] + fill[b]++] = rule;
+    }
+    return index;
+}
+
+template <size_t N>
+bool replaceFirst(Word& word, SuffixIndex<N> const& index, size_t start)
+{
+    if(word.n == 0)
+        return false;
+
+    size_t bucket = letterBucket(word.back());
+    char penultimate = word.n >= 2 ? word.p[word.n - 2] : '\0';
+    for(size_t i = index.start[bucket]; i != index.start[bucket + 1]; ++i)
+    {
+        Rule const& rule = index.rules[i];
+        if(rule.suffix.size() >= 2 && rule.suffix[rule.suffix.size() - 2] != penultimate)
+            continue;
+        if(replaceIfExists(word, rule.suffix, rule.replacement, start))
+            return true;
+    }
+    return false;
+}
+
+constexpr auto step2Index = indexByLastLetter(step2Rules);
+constexpr auto step3Index = indexByLastLetter(step3Rules);
+constexpr auto step4Index = indexByLastLetter(step4Rules);
+
+bool containsVowel(Word const& word, size_t start, size_t end)
+{
+    if(start <= end && end < word.n)
+    {
+        for(size_t i = start; i < end; ++i)
         {
-            std::replace(word.begin(), word.end(), 'Y', 'y');
-            return;
+            if(isVowelY(word.p[i]))
+                return true;
         }
+    }
+    return false;
+}
 
-        step1B(word, startR1);
-        step1C(word);
-        step2(word, startR1);
-        step3(word, startR1, startR2);
-        step4(word, startR2);
-        step5(word, startR1, startR2);
+bool endsInDouble(Word const& word)
+{
+    if(word.n >= 2)
+    {
+        char a = word.p[word.n - 1];
+        char b = word.p[word.n - 2];
 
-        std::replace(word.begin(), word.end(), 'Y', 'y');
-        return;
+        if(a == b)
+        {
+            return a == 'b' || a == 'd' || a == 'f' || a == 'g' ||
+                   a == 'm' || a == 'n' || a == 'p' || a == 'r' || a == 't';
+        }
     }
-
-} // namespace alga
+    return false;
+}
 
 /**
- * The procedures below this comment are internal to the implementation
- * of porter2stemmer and not externally visible.
+ * Determines whether a word ends in a short syllable.
+ * Define a short syllable in a word as either
+ *
+ * (a) a vowel followed by a non-vowel other than w, x or Y and preceded by a non-vowel
+ * (b) a vowel at the beginning of the word followed by a non-vowel.
  */
-static size_t getStartR1(const string& word)
+bool isShort(char const* p, size_t size)
+{
+    if(size >= 3)
+    {
+        if(!isVowelY(p[size - 3]) && isVowelY(p[size - 2])
+                && !isVowelY(p[size - 1]) && p[size - 1] != 'w'
+                && p[size - 1] != 'x' && p[size - 1] != 'Y')
+        {
+            return true;
+        }
+    }
+    return size == 2 && isVowelY(p[0]) && !isVowelY(p[1]);
+}
+
+size_t firstNonVowelAfterVowel(Word const& word, size_t start)
 {
-    // special cases
-    if (word.substr(0, 5) == "gener")
+    for(size_t i = start; i != 0 && i < word.n; ++i)
+    {
+        if(!isVowelY(word.p[i]) && isVowelY(word.p[i - 1]))
+            return i + 1;
+    }
+    return word.n;
+}
+
+size_t getStartR1(Word const& word)
+{
+    if(word.startsWith("gener") || word.startsWith("arsen"))
         return 5;
-    if (word.substr(0, 6) == "commun")
+    if(word.startsWith("commun"))
         return 6;
-    if (word.substr(0, 5) == "arsen")
-        return 5;
-    // general case
     return firstNonVowelAfterVowel(word, 1);
 }
 
-size_t getStartR2(const string& word, size_t startR1)
+size_t getStartR2(Word const& word, size_t startR1)
 {
-    if (startR1 == word.size())
+    if(startR1 == word.n)
         return startR1;
-
-    return firstNonVowelAfterVowel(word, startR1+1);
+    return firstNonVowelAfterVowel(word, startR1 + 1);
 }
 
-static size_t firstNonVowelAfterVowel(
-    const string& word,
-    size_t start)
+bool special(Word& word)
 {
-    for(size_t i = start; i != 0 && i < word.size(); ++i)
+    for(auto const& ex : exceptions)
     {
-        if(!isVowelY(word[i]) && isVowelY(word[i-1]))
-            return i + 1;
+        if(word == ex.suffix)
+        {
+            word.assign(ex.replacement);
+            return true;
+        }
     }
-
-    return word.size();
+    return std::find(invariants.begin(), invariants.end(), word.view()) != invariants.end();
 }
 
-static void changeY(string& word)
+void changeY(Word& word)
 {
-    if(word.find_first_of("y") == string::npos)
+    if(std::memchr(word.p, 'y', word.n) == nullptr)
         return;
 
-    if(word[0] == 'y')
-        word[0] = 'Y';
+    if(word.p[0] == 'y')
+        word.p[0] = 'Y';
 
-    for(size_t i = 1; i < word.size(); ++i)
+    for(size_t i = 1; i < word.n; ++i)
     {
-        if(word[i] == 'y' && isVowel(word[i - 1]))
-            word[i++] = 'Y';    // skip next iteration
+        if(word.p[i] == 'y' && isVowel(word.p[i - 1]))
+            word.p[i++] = 'Y';    // skip next iteration
     }
 }
 
 /**
   Step 0
 */
-static void step0(string& word)
+void step0(Word& word)
 {
-    // short circuit the longest suffix
     replaceIfExists(word, "'s'", "", 0)
     || replaceIfExists(word, "'s", "", 0)
     || replaceIfExists(word, "'", "", 0);
@@ -153,29 +326,22 @@ static void step0(string& word)
     delete if the preceding word part contains a vowel not immediately before the
     s (so gas and this retain the s, gaps and kiwis lose it)
 */
-static bool step1A(string& word)
+bool step1A(Word& word)
 {
     if(!replaceIfExists(word, "sses", "ss", 0))
     {
-        if(endsWith(word, "ied") || endsWith(word, "ies"))
+        if(word.endsWith("ied") || word.endsWith("ies"))
         {
-            // if preceded by only one letter
-            if(word.size() <= 4)
-                word = word.substr(0, word.size() - 1);
-            else
-                word = word.substr(0, word.size() - 2);
+            word.n -= (word.n <= 4) ? 1 : 2;
         }
-        else if(endsWith(word, "s") && !endsWith(word, "us")
-                && !endsWith(word, "ss"))
+        else if(word.endsWith("s") && !word.endsWith("us") && !word.endsWith("ss"))
         {
-            if(word.size() > 2 && containsVowel(word, 0, word.size() - 2))
-                word = word.substr(0, word.size() - 1);
+            if(word.n > 2 && containsVowel(word, 0, word.n - 2))
+                word.n -= 1;
         }
     }
 
-    // special case after step 1a
-    return word == "inning" || word == "outing" || word == "canning" || word == "herring" ||
-           word == "earring" || word == "proceed" || word == "exceed" || word == "succeed";
+    return std::find(step1AStops.begin(), step1AStops.end(), word.view()) != step1AStops.end();
 }
 
 /**
@@ -190,34 +356,31 @@ static bool step1A(string& word)
       if the word ends with a double remove the last letter (so hopp -> hop), or
       if the word is short, add e (so hop -> hope)
 */
-static void step1B(string& word, size_t startR1)
+void step1B(Word& word, size_t startR1)
 {
-    bool exists = endsWith(word, "eedly") || endsWith(word, "eed");
-
-    if(exists)
+    if(word.endsWith("eedly") || word.endsWith("eed"))
     {
         replaceIfExists(word, "eedly", "ee", startR1)
         || replaceIfExists(word, "eed", "ee", startR1);
+        return;
     }
-    else
-    {
-        size_t size = word.size();
-        bool deleted = (containsVowel(word, 0, size - 2)
-                        && replaceIfExists(word, "ed", "", 0))
-                       || (containsVowel(word, 0, size - 4)
-                           && replaceIfExists(word, "edly", "", 0))
-                       || (containsVowel(word, 0, size - 3) && replaceIfExists(word, "ing", "", 0))
-                       || (containsVowel(word, 0, size - 5)
-                           && replaceIfExists(word, "ingly", "", 0));
-
-        if(deleted && (endsWith(word, "at") || endsWith(word, "bl")
-                       || endsWith(word, "iz")))
-            word = word + "e";
-        else if(deleted && endsInDouble(word))
-            word = word.substr(0, word.size() - 1);
-        else if(deleted && startR1 == word.size() && isShort(word))
-            word = word + "e";
-    }
+
+    size_t size = word.n;
+    bool deleted = (containsVowel(word, 0, size - 2) && replaceIfExists(word, "ed", "", 0))
+                   || (containsVowel(word, 0, size - 4) && replaceIfExists(word, "edly", "", 0))
+                   || (containsVowel(word, 0, size - 3) && replaceIfExists(word, "ing", "", 0))
+                   || (containsVowel(word, 0, size - 5) && replaceIfExists(word, "ingly", "", 0));
+
+    if(!deleted)
+        return;
+
+    // At least two characters were deleted, so appending stays in bounds
+    if(word.endsWith("at") || word.endsWith("bl") || word.endsWith("iz"))
+        word.p[word.n++] = 'e';
+    else if(endsInDouble(word))
+        word.n -= 1;
+    else if(startR1 == word.n && isShort(word.p, word.n))
+        word.p[word.n++] = 'e';
 }
 
 /**
@@ -226,13 +389,13 @@ static void step1B(string& word, size_t startR1)
   Replace suffix y or Y by i if preceded by a non-vowel which is not the first
   letter of the word (so cry -> cri, by -> by, say -> say)
 */
-static void step1C(string& word)
+void step1C(Word& word)
 {
-    size_t size = word.size();
-    if(size > 2 && (word[size - 1] == 'y' || word[size - 1] == 'Y'))
+    size_t size = word.n;
+    if(size > 2 && (word.p[size - 1] == 'y' || word.p[size - 1] == 'Y'))
     {
-        if(!isVowel(word[size - 2]))
-            word[size - 1] = 'i';
+        if(!isVowel(word.p[size - 2]))
+            word.p[size - 1] = 'i';
     }
 }
 
@@ -258,38 +421,19 @@ static void step1C(string& word)
   ogi:                  replace by og if preceded by l
   li:                   delete if preceded by a valid li-ending
 */
-static void step2(string& word, size_t startR1)
+void step2(Word& word, size_t startR1)
 {
-    static const std::vector<std::pair<string, string>> subs =
-    {
-        {"ational", "ate"}, {"tional", "tion"}, {"enci", "ence"}, {"anci", "ance"},
-        {"abli", "able"}, {"entli", "ent"}, {"izer", "ize"}, {"ization", "ize"},
-        {"ation", "ate"}, {"ator", "ate"}, {"alism", "al"}, {"aliti", "al"},
-        {"alli", "al"}, {"fulness", "ful"}, {"ousli", "ous"}, {"ousness", "ous"},
-        {"iveness", "ive"}, {"iviti", "ive"}, {"biliti", "ble"}, {"bli", "ble"},
-        {"fulli", "ful"}, {"lessli", "less"}
-    };
-
-    for(auto& sub : subs)
-    {
-        if(replaceIfExists(word, sub.first, sub.second, startR1))
-            return;
-    }
+    if(replaceFirst(word, step2Index, startR1))
+        return;
 
     if(!replaceIfExists(word, "logi", "log", startR1 - 1))
     {
         // make sure we choose the longest suffix
-        if(endsWith(word, "li") && !endsWith(word, "abli")
-                && !endsWith(word, "entli")
-                && !endsWith(word, "aliti") && !endsWith(word, "alli")
-                && !endsWith(word, "ousli")
-                && !endsWith(word, "bli") && !endsWith(word, "fulli")
-                && !endsWith(word, "lessli"))
-            if(word.size() > 3 && word.size() - 2 >= startR1
-                    && isValidLIEnding(word[word.size() - 3]))
-            {
-                word = word.substr(0, word.size() - 2);
-            }
+        if(word.endsWith("li")
+                && std::none_of(step2LiLonger.begin(), step2LiLonger.end(),
+                                [&](string_view s) { return word.endsWith(s); }))
+            if(word.n > 3 && word.n - 2 >= startR1 && isValidLIEnding(word.p[word.n - 3]))
+                word.n -= 2;
     }
 }
 
@@ -305,19 +449,10 @@ static void step2(string& word, size_t startR1)
   ful, ness:          delete
   ative:              delete if in R2
 */
-static void step3(string& word, size_t startR1, size_t startR2)
+void step3(Word& word, size_t startR1, size_t startR2)
 {
-    static const std::vector<std::pair<string, string>> subs =
-    {
-        {"ational", "ate"}, {"tional", "tion"}, {"alize", "al"}, {"icate", "ic"},
-        {"iciti", "ic"}, {"ical", "ic"}, {"ful", ""}, {"ness", ""}
-    };
-
-    for(auto& sub : subs)
-    {
-        if(replaceIfExists(word, sub.first, sub.second, startR1))
-            return;
-    }
+    if(replaceFirst(word, step3Index, startR1))
+        return;
 
     replaceIfExists(word, "ative", "", startR2);
 }
@@ -333,29 +468,18 @@ static void step3(string& word, size_t startR1, size_t startR2)
   ion
                               delete if preceded by s or t
 */
-static void step4(string& word, size_t startR2)
+void step4(Word& word, size_t startR2)
 {
-    static const std::vector<std::pair<string, string>> subs =
-    {
-        {"al", ""}, {"ance", ""}, {"ence", ""}, {"er", ""}, {"ic", ""},
-        {"able", ""}, {"ible", ""}, {"ant", ""}, {"ement", ""}, {"ment", ""},
-        {"ism", ""}, {"ate", ""}, {"iti", ""}, {"ous", ""}, {"ive", ""}, {"ize", ""}
-    };
-
-    for(auto& sub : subs)
-    {
-        if(replaceIfExists(word, sub.first, sub.second, startR2))
-            return;
-    }
+    if(replaceFirst(word, step4Index, startR2))
+        return;
 
     // make sure we only choose the longest suffix
-    if(!endsWith(word, "ement") && !endsWith(word, "ment"))
+    if(!word.endsWith("ement") && !word.endsWith("ment"))
     {
         if(replaceIfExists(word, "ent", "", startR2))
             return;
     }
 
-    // short circuit
     replaceIfExists(word, "sion", "s", startR2 - 1)
     || replaceIfExists(word, "tion", "t", startR2 - 1);
 }
@@ -366,131 +490,83 @@ static void step4(string& word, size_t startR2)
   e     delete if in R2, or in R1 and not preceded by a short syllable
   l     delete if in R2 and preceded by l
 */
-static void step5(string& word, size_t startR1, size_t startR2)
+void step5(Word& word, size_t startR1, size_t startR2)
 {
-    size_t size = word.size();
-    if(word[size - 1] == 'e')
+    size_t size = word.n;
+    if(size == 0)
+        return;
+
+    if(word.p[size - 1] == 'e')
     {
         if(size - 1 >= startR2)
-            word = word.substr(0, size - 1);
-        else if(size - 1 >= startR1 && !isShort(word.substr(0, size - 1)))
-            word = word.substr(0, size - 1);
+            word.n -= 1;
+        else if(size - 1 >= startR1 && !isShort(word.p, size - 1))
+            word.n -= 1;
     }
-    else if(word[word.size() - 1] == 'l')
+    else if(word.p[size - 1] == 'l')
     {
-        if(word.size() - 1 >= startR2 && word[word.size() - 2] == 'l')
-            word = word.substr(0, word.size() - 1);
+        if(size - 1 >= startR2 && word.p[size - 2] == 'l')
+            word.n -= 1;
     }
 }
 
-/**
- * Determines whether a word ends in a short syllable.
- * Define a short syllable in a word as either
- *
- * (a) a vowel followed by a non-vowel other than w, x or Y and preceded by a non-vowel
- * (b) a vowel at the beginning of the word followed by a non-vowel.
- */
-static bool isShort(const string& word)
+void restoreY(Word& word)
 {
-    size_t size = word.size();
-
-    if(size >= 3)
-    {
-        if(!isVowelY(word[size - 3]) && isVowelY(word[size - 2])
-                && !isVowelY(word[size - 1]) && word[size - 1] != 'w'
-                && word[size - 1] != 'x' && word[size - 1] != 'Y')
-        {
-            return true;
-        }
-    }
-    return size == 2 && isVowelY(word[0]) && !isVowelY(word[1]);
+    std::replace(word.p, word.p + word.n, 'Y', 'y');
 }
 
-static bool special(string& word)
-{
-    static const std::unordered_map<string, string> exceptions =
-    {
-        {"skis", "ski"}, {"skies", "sky"}, {"dying", "die"}, {"lying", "lie"},
-        {"tying", "tie"}, {"idly", "idl"}, {"gently", "gentl"}, {"ugly", "ugli"},
-        {"early", "earli"}, {"only", "onli"}, {"singly", "singl"}
-    };
-
-    // special cases
-    auto ex = exceptions.find(word);
-    if(ex != exceptions.end())
+} // namespace inplace
+} // namespace
+
+namespace alga {
+
+    size_t porter2stemmer(std::span<char> buffer)
     {
-        word = ex->second;
-        return true;
-    }
+        inplace::Word word{buffer.data(), buffer.size()};
 
-    // invariants
-    return word == "sky" || word == "news" || word == "howe" ||
-           word == "atlas" || word == "cosmos" || word == "bias" ||
-           word == "andes";
-}
+        // special case short words
+        if(word.n <= 2)
+            return word.n;
 
-// Static helper functions (not in namespace)
-static bool isVowelY(char ch)
-{
-    return ch == 'e' || ch == 'a' || ch == 'i' ||
-           ch == 'o' || ch == 'u' || ch == 'y';
-}
+        // max word length is 35 for English
+        if(word.n > 35)
+            word.n = 35;
 
-static bool isVowel(char ch)
-{
-    return ch == 'e' || ch == 'a' || ch == 'i' ||
-           ch == 'o' || ch == 'u';
-}
+        if(word.p[0] == '\'')
+        {
+            std::memmove(word.p, word.p + 1, word.n - 1);
+            word.n -= 1;
+        }
 
-static bool endsWith(const string& word, const string& str)
-{
-    return word.size() >= str.size() &&
-           word.substr(word.size() - str.size()) == str;
-}
+        if(inplace::special(word))
+            return word.n;
 
-static bool endsInDouble(const string& word)
-{
-    if(word.size() >= 2)
-    {
-        char a = word[word.size() - 1];
-        char b = word[word.size() - 2];
+        inplace::changeY(word);
+        size_t startR1 = inplace::getStartR1(word);
+        size_t startR2 = inplace::getStartR2(word, startR1);
 
-        if(a == b)
+        inplace::step0(word);
+
+        if(inplace::step1A(word))
         {
-            return a == 'b' || a == 'd' || a == 'f' || a == 'g' ||
-                   a == 'm' || a == 'n' || a == 'p' || a == 'r' || a == 't';
+            inplace::restoreY(word);
+            return word.n;
         }
-    }
 
-    return false;
-}
+        inplace::step1B(word, startR1);
+        inplace::step1C(word);
+        inplace::step2(word, startR1);
+        inplace::step3(word, startR1, startR2);
+        inplace::step4(word, startR2);
+        inplace::step5(word, startR1, startR2);
 
-static bool replaceIfExists(string& word, const string& suffix, const string& replacement, size_t start)
-{
-    if(!(start > word.size())
-            && endsWith(word.substr(start, word.size() - start), suffix))
-    {
-        word = word.substr(0, word.size() - suffix.size()) + replacement;
-        return true;
+        inplace::restoreY(word);
+        return word.n;
     }
-    return false;
-}
-
-static bool isValidLIEnding(char ch)
-{
-    return ch == 'c' || ch == 'd' || ch == 'e' || ch == 'g' || ch == 'h'
-           || ch == 'k' || ch == 'm' || ch == 'n' || ch == 'r' || ch == 't';
-}
 
-static bool containsVowel(const string& word, size_t start, size_t end)
-{
-    if(start <= end && end < word.size())
+    void porter2stemmer(string & word)
     {
-        for(size_t i = start; i < end; ++i)
-        {
-            if(isVowelY(word[i]))
-                return true;
-        }
+        word.resize(porter2stemmer(std::span<char>(word.data(), word.size())));
     }
-    return false;
-}
\ No newline at end of file
+
+} // namespace alga
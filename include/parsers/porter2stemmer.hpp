@@ -8,6 +8,7 @@
 #include <utility>
 #include <vector>
 #include <functional>
+#include <span>
 
 using std::string;
 using std::optional;
@@ -18,30 +19,51 @@ namespace alga
 {
     // Forward declaration of stemming function
     void porter2stemmer(string &);
+    
+    /**
+     * @brief Words longer than this are truncated before stemming
+     */
+    constexpr size_t porter2_max_word_length = 35;
+    
+    /**
+     * @brief Allocation-free Porter2 stemmer working in place on a char buffer
+     * 
+     * Stems the word held in buffer (e.g. a span over a char[36] and a length)
+     * without touching the heap. The stem never grows past the input length, so
+     * it is written back into buffer.first(result).
+     * 
+     * Produces byte-identical output to porter2stemmer(string&).
+     * 
+     * @return Length of the stemmed word
+     */
+    size_t porter2stemmer(std::span<char> buffer);
 
     /**
      * @brief Porter2 stemmed word with proper value semantics
      * 
      * Represents a word that has been processed by the Porter2 stemming algorithm.
      * Now supports full value semantics and uniform composition operations.
+     * The Storage policy is forwarded to the wrapped basic_lc_alpha.
      */
-    struct porter2_stem
+    template <typename Storage>
+    struct basic_porter2_stem
     {
-        lc_alpha word;  // Removed const to enable proper value semantics
+        basic_lc_alpha<Storage> word;  // Removed const to enable proper value semantics
         
         // Constructors
-        porter2_stem() = default;
-        porter2_stem(lc_alpha w) : word(std::move(w)) {}
+        basic_porter2_stem() = default;
+        basic_porter2_stem(basic_lc_alpha<Storage> w) : word(std::move(w)) {}
         
         // Full value semantics
-        porter2_stem(porter2_stem const& other) = default;
-        porter2_stem(porter2_stem&& other) = default;
-        porter2_stem& operator=(porter2_stem const& other) = default;
-        porter2_stem& operator=(porter2_stem&& other) = default;
+        basic_porter2_stem(basic_porter2_stem const& other) = default;
+        basic_porter2_stem(basic_porter2_stem&& other) = default;
+        basic_porter2_stem& operator=(basic_porter2_stem const& other) = default;
+        basic_porter2_stem& operator=(basic_porter2_stem&& other) = default;
         
         // Access interface
         explicit operator string() const { return static_cast<string>(word); }
-        lc_alpha const& lc() const { return word; }
+        basic_lc_alpha<Storage> const& lc() const { return word; }
+        string_view view() const { return word.view(); }
         
         // Iterator interface  
         auto begin() const { return word.begin(); }
@@ -51,29 +73,93 @@ namespace alga
     };
     
     /**
-     * @brief Factory function for porter2_stem from string input
+     * @brief Heap-backed porter2_stem (std::string storage)
+     */
+    using porter2_stem = basic_porter2_stem<string>;
+    
+    /**
+     * @brief porter2_stem whose characters live inline for words up to 24 bytes
      * 
-     * Validates input, converts to lc_alpha, applies stemming, returns result.
-     * This is the primary way to create porter2_stem from arbitrary string input.
+     * Copies and n-grams of inline stems do not allocate.
      */
-    optional<porter2_stem> make_porter2_stem(string_view input)
+    using inline_porter2_stem = basic_porter2_stem<inline_string<24>>;
+    
+    namespace detail
     {
-        auto lc_opt = make_lc_alpha(input);
-        if (!lc_opt) {
-            return std::nullopt;
+        /**
+         * @brief Validate input and lowercase its stemmed prefix into buffer
+         * 
+         * Writes the first porter2_max_word_length characters of input, all
+         * lowercased, to buffer and validates the remainder chunk by chunk.
+         * 
+         * @return Number of characters written, nullopt if input is not alphabetic
+         */
+        inline optional<size_t> lowercase_for_stemming(string_view input,
+                                                       char (&buffer)[porter2_max_word_length])
+        {
+            size_t head = std::min(input.size(), porter2_max_word_length);
+            if (!lowercase_alpha(input.data(), head, buffer)) {
+                return std::nullopt;
+            }
+            
+            // Characters past the stemming limit still have to be validated
+            char scratch[porter2_max_word_length];
+            for (size_t pos = head; pos < input.size(); pos += porter2_max_word_length) {
+                size_t chunk = std::min(input.size() - pos, porter2_max_word_length);
+                if (!lowercase_alpha(input.data() + pos, chunk, scratch)) {
+                    return std::nullopt;
+                }
+            }
+            return head;
         }
         
-        // Apply Porter2 stemming
-        string s = lc_opt->str();
-        porter2stemmer(s);
-        
-        auto stemmed_lc = make_lc_alpha(s);
-        if (!stemmed_lc) {
-            // This shouldn't happen if porter2stemmer is correct
+        /**
+         * @brief Stem an already lowercased alphabetic word into Storage
+         * 
+         * Only the first porter2_max_word_length characters take part in
+         * stemming, so they are copied to a stack buffer and stemmed in place.
+         * The stemmer only removes or rewrites lowercase letters, so its output
+         * is still a valid lc_alpha.
+         */
+        template <typename Storage>
+        basic_porter2_stem<Storage> stem_lowercase(string_view word)
+        {
+            char buffer[porter2_max_word_length];
+            size_t length = std::min(word.size(), porter2_max_word_length);
+            std::copy_n(word.data(), length, buffer);
+            length = porter2stemmer(std::span<char>(buffer, length));
+            return basic_porter2_stem<Storage>(*make_basic_lc_alpha<Storage>(string_view(buffer, length)));
+        }
+    }
+    
+    /**
+     * @brief Factory function for basic_porter2_stem with the given storage policy
+     * 
+     * Validates and lowercases the whole input on the stack, then stems in place.
+     * With inline storage no step of this touches the heap.
+     */
+    template <typename Storage>
+    optional<basic_porter2_stem<Storage>> make_basic_porter2_stem(string_view input)
+    {
+        char buffer[porter2_max_word_length];
+        auto head = detail::lowercase_for_stemming(input, buffer);
+        if (!head) {
             return std::nullopt;
         }
         
-        return porter2_stem(std::move(*stemmed_lc));
+        size_t length = porter2stemmer(std::span<char>(buffer, *head));
+        return basic_porter2_stem<Storage>(*make_basic_lc_alpha<Storage>(string_view(buffer, length)));
+    }
+    
+    /**
+     * @brief Factory function for porter2_stem from string input
+     * 
+     * Validates input, converts to lc_alpha, applies stemming, returns result.
+     * This is the primary way to create porter2_stem from arbitrary string input.
+     */
+    inline optional<porter2_stem> make_porter2_stem(string_view input)
+    {
+        return make_basic_porter2_stem<string>(input);
     }
     
     /**
@@ -82,10 +168,11 @@ namespace alga
      * Provides a clean, consistent interface where ALL operations return optional<T>.
      * No more mixed return types - everything follows the same pattern.
      */
-    struct porter2_stemmer
+    template <typename Storage>
+    struct basic_porter2_stemmer
     {
         using input_type = string_view;
-        using output_type = porter2_stem;
+        using output_type = basic_porter2_stem<Storage>;
         
         /**
          * @brief Stem a string input (primary interface)
@@ -93,9 +180,9 @@ namespace alga
          * @param input String to stem
          * @return optional<porter2_stem> Result if input is valid, nullopt if invalid
          */
-        optional<porter2_stem> operator()(string_view input) const
+        optional<output_type> operator()(string_view input) const
         {
-            return make_porter2_stem(input);
+            return make_basic_porter2_stem<Storage>(input);
         }
         
         /**
@@ -104,18 +191,10 @@ namespace alga
          * @param input Valid lc_alpha to stem
          * @return optional<porter2_stem> Always succeeds for valid lc_alpha input
          */
-        optional<porter2_stem> operator()(lc_alpha const& input) const
+        template <typename S>
+        optional<output_type> operator()(basic_lc_alpha<S> const& input) const
         {
-            string s = input.str();
-            porter2stemmer(s);
-            
-            auto stemmed_lc = make_lc_alpha(s);
-            if (!stemmed_lc) {
-                // This shouldn't happen if porter2stemmer is correct
-                return std::nullopt;
-            }
-            
-            return porter2_stem(std::move(*stemmed_lc));
+            return detail::stem_lowercase<Storage>(input.view());
         }
         
         /**
@@ -125,7 +204,7 @@ namespace alga
          * Returns pair of remaining iterator and optional result.
          */
         template<typename Iterator>
-        pair<Iterator, optional<porter2_stem>> parse(Iterator begin, Iterator end) const
+        pair<Iterator, optional<output_type>> parse(Iterator begin, Iterator end) const
         {
             string word;
             Iterator current = begin;
@@ -143,24 +222,28 @@ namespace alga
             // Apply stemming
             porter2stemmer(word);
             
-            auto lc_opt = make_lc_alpha(word);
+            auto lc_opt = make_basic_lc_alpha<Storage>(word);
             if (!lc_opt) {
                 return {current, std::nullopt};
             }
             
-            return {current, porter2_stem(std::move(*lc_opt))};
+            return {current, output_type(std::move(*lc_opt))};
         }
     };
     
+    using porter2_stemmer = basic_porter2_stemmer<string>;
+    using inline_porter2_stemmer = basic_porter2_stemmer<inline_string<24>>;
+    
     /**
      * @brief Direct composition for porter2_stem values
      * 
      * Implements the monoid operation directly on values for better compositionality.
      */
-    porter2_stem operator*(porter2_stem const& lhs, porter2_stem const& rhs)
+    template <typename Storage>
+    basic_porter2_stem<Storage> operator*(basic_porter2_stem<Storage> const& lhs,
+                                          basic_porter2_stem<Storage> const& rhs)
     {
-        lc_alpha combined_word = lhs.word * rhs.word;
-        return porter2_stem(combined_word);
+        return basic_porter2_stem<Storage>(lhs.word * rhs.word);
     }
 
     /**
@@ -168,7 +251,9 @@ namespace alga
      * 
      * Implements uniform composition pattern across all algebraic types.
      */
-    optional<porter2_stem> operator*(optional<porter2_stem> const& lhs, optional<porter2_stem> const& rhs)
+    template <typename Storage>
+    optional<basic_porter2_stem<Storage>> operator*(optional<basic_porter2_stem<Storage>> const& lhs,
+                                                    optional<basic_porter2_stem<Storage>> const& rhs)
     {
         if (!lhs || !rhs) {
             return std::nullopt;
@@ -178,40 +263,47 @@ namespace alga
     }
     
     // Comparison operators
-    bool operator==(porter2_stem const& lhs, porter2_stem const& rhs)
+    template <typename Storage>
+    bool operator==(basic_porter2_stem<Storage> const& lhs, basic_porter2_stem<Storage> const& rhs)
     {
         return lhs.word == rhs.word;
     }
     
-    bool operator!=(porter2_stem const& lhs, porter2_stem const& rhs)
+    template <typename Storage>
+    bool operator!=(basic_porter2_stem<Storage> const& lhs, basic_porter2_stem<Storage> const& rhs)
     {
         return !(lhs == rhs);
     }
     
-    bool operator<(porter2_stem const& lhs, porter2_stem const& rhs)
+    template <typename Storage>
+    bool operator<(basic_porter2_stem<Storage> const& lhs, basic_porter2_stem<Storage> const& rhs)
     {
         return lhs.word < rhs.word;
     }
     
-    bool operator<=(porter2_stem const& lhs, porter2_stem const& rhs)
+    template <typename Storage>
+    bool operator<=(basic_porter2_stem<Storage> const& lhs, basic_porter2_stem<Storage> const& rhs)
     {
         return lhs.word <= rhs.word;
     }
     
-    bool operator>(porter2_stem const& lhs, porter2_stem const& rhs)
+    template <typename Storage>
+    bool operator>(basic_porter2_stem<Storage> const& lhs, basic_porter2_stem<Storage> const& rhs)
     {
         return lhs.word > rhs.word;
     }
     
-    bool operator>=(porter2_stem const& lhs, porter2_stem const& rhs)
+    template <typename Storage>
+    bool operator>=(basic_porter2_stem<Storage> const& lhs, basic_porter2_stem<Storage> const& rhs)
     {
         return lhs.word >= rhs.word;
     }
     
     // Stream output operator
-    std::ostream& operator<<(std::ostream& os, porter2_stem const& stem)
+    template <typename Storage>
+    std::ostream& operator<<(std::ostream& os, basic_porter2_stem<Storage> const& stem)
     {
-        return os << static_cast<string>(stem);
+        return os << stem.view();
     }
 
     // ============================================================================
@@ -221,7 +313,9 @@ namespace alga
     /**
      * @brief Choice operator - prefer left operand, fallback to right if left is empty
      */
-    porter2_stem operator|(porter2_stem const& lhs, porter2_stem const& rhs)
+    template <typename Storage>
+    basic_porter2_stem<Storage> operator|(basic_porter2_stem<Storage> const& lhs,
+                                          basic_porter2_stem<Storage> const& rhs)
     {
         return lhs.empty() ? rhs : lhs;
     }
@@ -229,7 +323,9 @@ namespace alga
     /**
      * @brief Choice operator for optionals - first non-nullopt wins
      */
-    optional<porter2_stem> operator|(optional<porter2_stem> const& lhs, optional<porter2_stem> const& rhs)
+    template <typename Storage>
+    optional<basic_porter2_stem<Storage>> operator|(optional<basic_porter2_stem<Storage>> const& lhs,
+                                                    optional<basic_porter2_stem<Storage>> const& rhs)
     {
         return lhs ? lhs : rhs;
     }
@@ -237,22 +333,18 @@ namespace alga
     /**
      * @brief Repetition operator - compose stem with itself N times
      */
-    porter2_stem operator^(porter2_stem const& base, size_t count)
+    template <typename Storage>
+    basic_porter2_stem<Storage> operator^(basic_porter2_stem<Storage> const& base, size_t count)
     {
-        if (count == 0) return porter2_stem{};
-        if (count == 1) return base;
-        
-        porter2_stem result = base;
-        for (size_t i = 1; i < count; ++i) {
-            result = result * base;
-        }
-        return result;
+        return basic_porter2_stem<Storage>(base.word ^ count);
     }
 
     /**
      * @brief Sequential composition - creates ordered sequence
      */
-    std::vector<porter2_stem> operator>>(porter2_stem const& lhs, porter2_stem const& rhs)
+    template <typename Storage>
+    std::vector<basic_porter2_stem<Storage>> operator>>(basic_porter2_stem<Storage> const& lhs,
+                                                        basic_porter2_stem<Storage> const& rhs)
     {
         return {lhs, rhs};
     }
@@ -260,7 +352,9 @@ namespace alga
     /**
      * @brief Logical OR for optionals
      */
-    optional<porter2_stem> operator||(optional<porter2_stem> const& lhs, optional<porter2_stem> const& rhs)
+    template <typename Storage>
+    optional<basic_porter2_stem<Storage>> operator||(optional<basic_porter2_stem<Storage>> const& lhs,
+                                                     optional<basic_porter2_stem<Storage>> const& rhs)
     {
         return lhs ? lhs : rhs;
     }
@@ -268,7 +362,9 @@ namespace alga
     /**
      * @brief Logical AND for optionals - both must succeed
      */
-    optional<std::pair<porter2_stem, porter2_stem>> operator&&(optional<porter2_stem> const& lhs, optional<porter2_stem> const& rhs)
+    template <typename Storage>
+    optional<std::pair<basic_porter2_stem<Storage>, basic_porter2_stem<Storage>>> operator&&(
+        optional<basic_porter2_stem<Storage>> const& lhs, optional<basic_porter2_stem<Storage>> const& rhs)
     {
         if (!lhs || !rhs) return std::nullopt;
         return std::make_pair(*lhs, *rhs);
@@ -277,9 +373,9 @@ namespace alga
     /**
      * @brief Function application operator
      */
-    template<typename F>
-        requires std::invocable<F, porter2_stem>
-    auto operator%(porter2_stem const& value, F const& function) -> decltype(function(value))
+    template<typename Storage, typename F>
+        requires std::invocable<F, basic_porter2_stem<Storage>>
+    auto operator%(basic_porter2_stem<Storage> const& value, F const& function) -> decltype(function(value))
     {
         return function(value);
     }
@@ -287,9 +383,9 @@ namespace alga
     /**
      * @brief Function application for optional porter2_stem
      */
-    template<typename F>
-        requires std::invocable<F, porter2_stem>
-    auto operator%(optional<porter2_stem> const& maybe_value, F const& function) 
+    template<typename Storage, typename F>
+        requires std::invocable<F, basic_porter2_stem<Storage>>
+    auto operator%(optional<basic_porter2_stem<Storage>> const& maybe_value, F const& function) 
         -> optional<std::decay_t<decltype(function(*maybe_value))>>
     {
         if (!maybe_value) return std::nullopt;
@@ -12,6 +12,9 @@
 #include <algorithm>
 #include <numeric>
 #include <functional>
+#include <cctype>
+#include <iterator>
+#include <memory>
 
 namespace alga {
 
@@ -264,26 +267,26 @@ public:
      */
     template<typename Iterator>
     std::pair<Iterator, std::optional<rhythmic_pattern>> parse(Iterator begin, Iterator end) const {
-        std::string word;
-        Iterator current = begin;
+        // Skip leading whitespace, then extract word characters
+        Iterator word_begin = std::find_if_not(begin, end, [](char c) {
+            return std::isspace(static_cast<unsigned char>(c));
+        });
+        Iterator current = std::find_if_not(word_begin, end, [](char c) {
+            return std::isalpha(static_cast<unsigned char>(c));
+        });
         
-        // Extract word characters
-        while (current != end && (std::isalpha(*current) || std::isspace(*current))) {
-            if (std::isalpha(*current)) {
-                word += std::tolower(*current);
-            } else if (!word.empty()) {
-                // End of word, analyze it
-                break;
-            }
-            ++current;
-        }
-        
-        if (word.empty()) {
+        if (current == word_begin) {
             return {current, std::nullopt};
         }
         
-        auto pattern = make_rhythmic_pattern(word);
-        return {current, pattern};
+        // Contiguous input is analyzed in place; the pattern folds case itself
+        if constexpr (std::contiguous_iterator<Iterator>) {
+            std::string_view word(std::to_address(word_begin), static_cast<size_t>(current - word_begin));
+            return {current, make_rhythmic_pattern(word)};
+        } else {
+            std::string word(word_begin, current);
+            return {current, make_rhythmic_pattern(word)};
+        }
     }
 };
 
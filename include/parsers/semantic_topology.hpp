@@ -14,6 +14,9 @@
 #include <algorithm>
 #include <numeric>
 #include <functional>
+#include <cctype>
+#include <iterator>
+#include <memory>
 #include <iomanip>
 
 namespace alga {
@@ -394,24 +397,27 @@ public:
     
     /**
      * @brief Iterator-based parsing for composition
+     *
+     * Contiguous input is analyzed in place; stemming does the case folding.
      */
     template<typename Iterator>
     std::pair<Iterator, std::optional<semantic_vector>> parse(Iterator begin, Iterator end) const {
-        std::string word;
-        Iterator current = begin;
-        
         // Extract word characters
-        while (current != end && std::isalpha(*current)) {
-            word += std::tolower(*current);
-            ++current;
-        }
+        Iterator current = std::find_if_not(begin, end, [](char c) {
+            return std::isalpha(static_cast<unsigned char>(c));
+        });
         
-        if (word.empty()) {
+        if (current == begin) {
             return {current, std::nullopt};
         }
         
-        auto vector = make_semantic_vector(word);
-        return {current, vector};
+        if constexpr (std::contiguous_iterator<Iterator>) {
+            std::string_view word(std::to_address(begin), static_cast<size_t>(current - begin));
+            return {current, make_semantic_vector(word)};
+        } else {
+            std::string word(begin, current);
+            return {current, make_semantic_vector(word)};
+        }
     }
     
     /**
@@ -4,53 +4,519 @@
 #include <string_view>
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cmath>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
 
 namespace alga {
 namespace similarity {
 
 /**
- * @brief Levenshtein distance (edit distance)
- *
- * Minimum number of single-character edits (insertions, deletions, substitutions)
- * required to change one string into another.
+ * @brief Reusable scratch space for the bit-parallel edit distances
  *
- * Complexity: O(m*n) time, O(min(m,n)) space
+ * Holds the per-character match masks and column bit-vectors. Buffers only
+ * grow, so once a workspace has seen its longest pattern, further calls do
+ * not allocate. A workspace must not be shared between threads; the
+ * overloads without one use a thread-local workspace.
  */
-inline size_t levenshtein_distance(std::string_view s1, std::string_view s2) {
-    const size_t m = s1.size();
-    const size_t n = s2.size();
+class edit_distance_workspace {
+public:
+    /**
+     * @brief Levenshtein distance (Myers / Hyyro bit-vector algorithm)
+     */
+    size_t levenshtein(std::string_view s1, std::string_view s2) {
+        trim_common_affix(s1, s2);
+        if (s1.size() > s2.size()) std::swap(s1, s2);
+        if (s1.empty()) return s2.size();
+        return s1.size() <= 64 ? levenshtein_single(s1, s2) : levenshtein_blocked(s1, s2);
+    }
+
+    /**
+     * @brief Optimal string alignment distance (Hyyro's transposition extension)
+     */
+    size_t damerau_levenshtein(std::string_view s1, std::string_view s2) {
+        trim_common_affix(s1, s2);
+        if (s1.size() > s2.size()) std::swap(s1, s2);
+        if (s1.empty()) return s2.size();
+        return s1.size() <= 64 ? osa_single(s1, s2) : osa_blocked(s1, s2);
+    }
+
+    /**
+     * @brief Levenshtein distance if it is at most k, computed in a 2k+1 band
+     */
+    std::optional<size_t> levenshtein_bounded(std::string_view s1, std::string_view s2, size_t k) {
+        return bounded<false>(s1, s2, k);
+    }
+
+    /**
+     * @brief Optimal string alignment distance if it is at most k
+     */
+    std::optional<size_t> damerau_levenshtein_bounded(std::string_view s1, std::string_view s2, size_t k) {
+        return bounded<true>(s1, s2, k);
+    }
+
+    /**
+     * @brief Length of the longest common subsequence (Allison-Dix / Hyyro)
+     */
+    size_t lcs(std::string_view s1, std::string_view s2) {
+        size_t affix = s1.size();
+        trim_common_affix(s1, s2);
+        affix -= s1.size();
+        if (s1.size() > s2.size()) std::swap(s1, s2);
+        if (s1.empty()) return affix;
+        return affix + (s1.size() <= 64 ? lcs_single(s1, s2) : lcs_blocked(s1, s2));
+    }
+
+    /**
+     * @brief One longest common subsequence as matched (s1, s2) index pairs
+     *
+     * Hirschberg's divide and conquer: the middle row of the LCS table is
+     * found from a forward pass over the top half of s1 and a backward pass
+     * over the bottom half, and the two halves are solved recursively. Each
+     * pass is bit-parallel, so memory stays linear in the input length.
+     */
+    std::vector<std::pair<size_t, size_t>> lcs_alignment(std::string_view s1, std::string_view s2) {
+        std::vector<std::pair<size_t, size_t>> pairs;
+        size_t prefix = 0;
+        while (prefix < std::min(s1.size(), s2.size()) && s1[prefix] == s2[prefix]) {
+            pairs.emplace_back(prefix, prefix);
+            ++prefix;
+        }
+        size_t suffix = 0;
+        while (suffix < std::min(s1.size(), s2.size()) - prefix &&
+               s1[s1.size() - 1 - suffix] == s2[s2.size() - 1 - suffix]) {
+            ++suffix;
+        }
+
+        hirschberg(s1.substr(prefix, s1.size() - prefix - suffix), prefix,
+                   s2.substr(prefix, s2.size() - prefix - suffix), prefix, pairs);
+
+        for (size_t k = suffix; k > 0; --k) {
+            pairs.emplace_back(s1.size() - k, s2.size() - k);
+        }
+        return pairs;
+    }
+
+private:
+    struct column {
+        uint64_t vp = ~uint64_t(0);
+        uint64_t vn = 0;
+        uint64_t d0 = 0;
+        uint64_t pm = 0;
+    };
+
+    // Match masks: peq[c] has bit i set where pattern[i] == c. Both tables
+    // are all-zero between calls; only the pattern's entries are touched.
+    std::array<uint64_t, 256> peq{};
+    std::vector<uint64_t> block_peq;  // [c * words + word]
+    std::vector<column> old_columns;
+    std::vector<column> new_columns;
+    std::array<std::vector<size_t>, 3> band_rows;  // Rows i-2, i-1, i of the banded DP
+    std::array<std::vector<size_t>, 2> lcs_rows;   // Forward and backward Hirschberg rows
+
+    static unsigned char byte(char c) { return static_cast<unsigned char>(c); }
+
+    static void trim_common_affix(std::string_view& s1, std::string_view& s2) {
+        size_t prefix = 0;
+        size_t limit = std::min(s1.size(), s2.size());
+        while (prefix < limit && s1[prefix] == s2[prefix]) ++prefix;
+        s1.remove_prefix(prefix);
+        s2.remove_prefix(prefix);
+
+        size_t suffix = 0;
+        limit -= prefix;
+        while (suffix < limit && s1[s1.size() - 1 - suffix] == s2[s2.size() - 1 - suffix]) ++suffix;
+        s1.remove_suffix(suffix);
+        s2.remove_suffix(suffix);
+    }
+
+    void load_single(std::string_view pattern) {
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            peq[byte(pattern[i])] |= uint64_t(1) << i;
+        }
+    }
+
+    void clear_single(std::string_view pattern) {
+        for (char c : pattern) peq[byte(c)] = 0;
+    }
+
+    // A reversed load puts pattern[size - 1 - i] at bit i
+    size_t load_blocked(std::string_view pattern, bool reversed = false) {
+        size_t words = (pattern.size() + 63) / 64;
+        if (block_peq.size() < 256 * words) block_peq.resize(256 * words, 0);
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            char c = reversed ? pattern[pattern.size() - 1 - i] : pattern[i];
+            block_peq[byte(c) * words + i / 64] |= uint64_t(1) << (i % 64);
+        }
+        old_columns.assign(words + 1, column{});
+        new_columns.assign(words + 1, column{});
+        return words;
+    }
 
-    if (m == 0) return n;
-    if (n == 0) return m;
+    void clear_blocked(std::string_view pattern, size_t words, bool reversed = false) {
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            char c = reversed ? pattern[pattern.size() - 1 - i] : pattern[i];
+            block_peq[byte(c) * words + i / 64] = 0;
+        }
+    }
 
-    // Use single array with size n+1
-    std::vector<size_t> prev_row(n + 1);
-    std::vector<size_t> curr_row(n + 1);
+    size_t levenshtein_single(std::string_view pattern, std::string_view text) {
+        load_single(pattern);
+        const uint64_t last = uint64_t(1) << (pattern.size() - 1);
+        uint64_t vp = ~uint64_t(0);
+        uint64_t vn = 0;
+        size_t dist = pattern.size();
+
+        for (char c : text) {
+            uint64_t x = peq[byte(c)] | vn;
+            uint64_t d0 = (((x & vp) + vp) ^ vp) | x;
+            uint64_t hp = vn | ~(d0 | vp);
+            uint64_t hn = d0 & vp;
+            dist += (hp & last) != 0;
+            dist -= (hn & last) != 0;
+            hp = (hp << 1) | 1;
+            hn <<= 1;
+            vp = hn | ~(d0 | hp);
+            vn = hp & d0;
+        }
 
-    // Initialize first row
-    for (size_t j = 0; j <= n; ++j) {
-        prev_row[j] = j;
+        clear_single(pattern);
+        return dist;
     }
 
-    // Fill matrix
-    for (size_t i = 1; i <= m; ++i) {
-        curr_row[0] = i;
+    size_t osa_single(std::string_view pattern, std::string_view text) {
+        load_single(pattern);
+        const uint64_t last = uint64_t(1) << (pattern.size() - 1);
+        uint64_t vp = ~uint64_t(0);
+        uint64_t vn = 0;
+        uint64_t d0 = 0;
+        uint64_t pm_old = 0;
+        size_t dist = pattern.size();
+
+        for (char c : text) {
+            uint64_t pm = peq[byte(c)];
+            uint64_t tr = (((~d0) & pm) << 1) & pm_old;
+            d0 = (((pm & vp) + vp) ^ vp) | pm | vn | tr;
+            uint64_t hp = vn | ~(d0 | vp);
+            uint64_t hn = d0 & vp;
+            dist += (hp & last) != 0;
+            dist -= (hn & last) != 0;
+            hp = (hp << 1) | 1;
+            hn <<= 1;
+            vp = hn | ~(d0 | hp);
+            vn = hp & d0;
+            pm_old = pm;
+        }
 
-        for (size_t j = 1; j <= n; ++j) {
-            size_t cost = (s1[i - 1] == s2[j - 1]) ? 0 : 1;
+        clear_single(pattern);
+        return dist;
+    }
 
-            curr_row[j] = std::min({
-                prev_row[j] + 1,      // deletion
-                curr_row[j - 1] + 1,  // insertion
-                prev_row[j - 1] + cost // substitution
-            });
+    // Blocks of 64 pattern rows are chained through the horizontal deltas
+    // leaving the top bit of each block
+    size_t levenshtein_blocked(std::string_view pattern, std::string_view text) {
+        size_t words = load_blocked(pattern);
+        const uint64_t last = uint64_t(1) << ((pattern.size() - 1) % 64);
+        size_t dist = pattern.size();
+
+        for (char c : text) {
+            uint64_t const* pm_row = &block_peq[byte(c) * words];
+            uint64_t hp_carry = 1;
+            uint64_t hn_carry = 0;
+
+            for (size_t w = 0; w < words; ++w) {
+                column& col = old_columns[w];
+                uint64_t x = pm_row[w] | hn_carry;
+                uint64_t d0 = (((x & col.vp) + col.vp) ^ col.vp) | x | col.vn;
+                uint64_t hp = col.vn | ~(d0 | col.vp);
+                uint64_t hn = d0 & col.vp;
+
+                if (w == words - 1) {
+                    dist += (hp & last) != 0;
+                    dist -= (hn & last) != 0;
+                }
+
+                uint64_t hp_out = hp >> 63;
+                uint64_t hn_out = hn >> 63;
+                hp = (hp << 1) | hp_carry;
+                hn = (hn << 1) | hn_carry;
+                hp_carry = hp_out;
+                hn_carry = hn_out;
+
+                col.vp = hn | ~(d0 | hp);
+                col.vn = hp & d0;
+            }
         }
 
-        std::swap(prev_row, curr_row);
+        clear_blocked(pattern, words);
+        return dist;
+    }
+
+    // Column state is double-buffered because the transposition term reads
+    // the previous column's D0 of the block below. Index 0 is a zero sentinel.
+    size_t osa_blocked(std::string_view pattern, std::string_view text) {
+        size_t words = load_blocked(pattern);
+        const uint64_t last = uint64_t(1) << ((pattern.size() - 1) % 64);
+        size_t dist = pattern.size();
+
+        for (char c : text) {
+            uint64_t const* pm_row = &block_peq[byte(c) * words];
+            uint64_t hp_carry = 1;
+            uint64_t hn_carry = 0;
+
+            for (size_t w = 0; w < words; ++w) {
+                column const& prev = old_columns[w + 1];
+                column const& prev_below = old_columns[w];
+                column const& curr_below = new_columns[w];
+                column& next = new_columns[w + 1];
+
+                uint64_t pm = pm_row[w];
+                uint64_t tr = ((((~prev.d0) & pm) << 1) |
+                               (((~prev_below.d0) & curr_below.pm) >> 63)) & prev.pm;
+                uint64_t x = pm | hn_carry;
+                uint64_t d0 = (((x & prev.vp) + prev.vp) ^ prev.vp) | x | prev.vn | tr;
+                uint64_t hp = prev.vn | ~(d0 | prev.vp);
+                uint64_t hn = d0 & prev.vp;
+
+                if (w == words - 1) {
+                    dist += (hp & last) != 0;
+                    dist -= (hn & last) != 0;
+                }
+
+                uint64_t hp_out = hp >> 63;
+                uint64_t hn_out = hn >> 63;
+                hp = (hp << 1) | hp_carry;
+                hn = (hn << 1) | hn_carry;
+                hp_carry = hp_out;
+                hn_carry = hn_out;
+
+                next.vp = hn | ~(d0 | hp);
+                next.vn = hp & d0;
+                next.d0 = d0;
+                next.pm = pm;
+            }
+            std::swap(old_columns, new_columns);
+        }
+
+        clear_blocked(pattern, words);
+        return dist;
+    }
+
+    // Allison-Dix: a zero bit of V marks a pattern row where the LCS grows.
+    // U picks the matching rows still set; the addition carries each of
+    // them up to the next unused row, which is what extending the LCS by
+    // the current text character does.
+    size_t lcs_single(std::string_view pattern, std::string_view text) {
+        load_single(pattern);
+        uint64_t v = ~uint64_t(0);
+        for (char c : text) {
+            uint64_t u = v & peq[byte(c)];
+            v = (v + u) | (v - u);
+        }
+        clear_single(pattern);
+        uint64_t rows = pattern.size() == 64 ? ~uint64_t(0) : (uint64_t(1) << pattern.size()) - 1;
+        return static_cast<size_t>(std::popcount(~v & rows));
+    }
+
+    // The same recurrence on the first 'words' blocks of old_columns[].vp,
+    // with the addition's carry rippling from block to block. V - U never
+    // borrows since U is a subset of V.
+    void lcs_advance(uint64_t const* pm_row, size_t words) {
+        uint64_t carry = 0;
+        for (size_t w = 0; w < words; ++w) {
+            uint64_t v = old_columns[w].vp;
+            uint64_t u = v & pm_row[w];
+            uint64_t sum = v + carry;
+            uint64_t next_carry = sum < v;
+            sum += u;
+            next_carry |= sum < u;
+            carry = next_carry;
+            old_columns[w].vp = sum | (v - u);
+        }
+    }
+
+    size_t lcs_blocked(std::string_view pattern, std::string_view text) {
+        size_t words = load_blocked(pattern);
+        for (char c : text) {
+            lcs_advance(&block_peq[byte(c) * words], words);
+        }
+        clear_blocked(pattern, words);
+
+        size_t length = 0;
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            length += ((old_columns[i / 64].vp >> (i % 64)) & 1) == 0;
+        }
+        return length;
+    }
+
+    // row[j] = LCS(text, pattern[0, j)) for j = 0..|pattern|; reversed, both
+    // strings are read back to front, so row[j] covers the last j characters
+    void lcs_row(std::string_view pattern, std::string_view text, bool reversed, std::vector<size_t>& row) {
+        size_t words = load_blocked(pattern, reversed);
+        for (size_t t = 0; t < text.size(); ++t) {
+            char c = reversed ? text[text.size() - 1 - t] : text[t];
+            lcs_advance(&block_peq[byte(c) * words], words);
+        }
+        clear_blocked(pattern, words, reversed);
+
+        row.resize(pattern.size() + 1);
+        row[0] = 0;
+        for (size_t j = 1; j <= pattern.size(); ++j) {
+            row[j] = row[j - 1] + (((old_columns[(j - 1) / 64].vp >> ((j - 1) % 64)) & 1) == 0);
+        }
     }
 
-    return prev_row[n];
+    void hirschberg(std::string_view a, size_t a_offset, std::string_view b, size_t b_offset,
+                    std::vector<std::pair<size_t, size_t>>& pairs) {
+        if (a.empty() || b.empty()) return;
+        if (a.size() == 1) {
+            size_t j = b.find(a[0]);
+            if (j != std::string_view::npos) pairs.emplace_back(a_offset, b_offset + j);
+            return;
+        }
+
+        const size_t mid = a.size() / 2;
+        std::vector<size_t>& forward = lcs_rows[0];
+        std::vector<size_t>& backward = lcs_rows[1];
+        lcs_row(b, a.substr(0, mid), false, forward);
+        lcs_row(b, a.substr(mid), true, backward);
+
+        // Split b where the top half's prefix LCS plus the bottom half's
+        // suffix LCS is largest; the rows are overwritten by the recursion
+        size_t split = 0;
+        size_t best = 0;
+        for (size_t j = 0; j <= b.size(); ++j) {
+            size_t total = forward[j] + backward[b.size() - j];
+            if (total > best) {
+                best = total;
+                split = j;
+            }
+        }
+        if (best == 0) return;
+
+        hirschberg(a.substr(0, mid), a_offset, b.substr(0, split), b_offset, pairs);
+        hirschberg(a.substr(mid), a_offset + mid, b.substr(split), b_offset + split, pairs);
+    }
+
+    // Ukkonen's cut-off: only cells with |i - j| <= k can hold a value <= k.
+    // Cells just outside the band are set to k + 1 so reads from them
+    // saturate, and the scan stops as soon as a whole band row exceeds k.
+    template <bool Transpositions>
+    std::optional<size_t> bounded(std::string_view s1, std::string_view s2, size_t k) {
+        trim_common_affix(s1, s2);
+        if (s1.size() > s2.size()) std::swap(s1, s2);
+        const size_t m = s1.size();
+        const size_t n = s2.size();
+
+        if (n - m > k) return std::nullopt;
+        if (m == 0) return n;
+
+        // A band as wide as a machine word is no cheaper than the bit-vector scan
+        if (2 * k + 1 >= 64) {
+            size_t dist = Transpositions ? (m <= 64 ? osa_single(s1, s2) : osa_blocked(s1, s2))
+                                         : (m <= 64 ? levenshtein_single(s1, s2) : levenshtein_blocked(s1, s2));
+            return dist <= k ? std::optional<size_t>(dist) : std::nullopt;
+        }
+
+        const size_t cutoff = k + 1;
+        for (auto& row : band_rows) {
+            if (row.size() < n + 1) row.resize(n + 1);
+        }
+        size_t* older = band_rows[0].data();
+        size_t* prev = band_rows[1].data();
+        size_t* curr = band_rows[2].data();
+
+        for (size_t j = 0; j <= std::min(n, k); ++j) prev[j] = j;
+        if (k + 1 <= n) prev[k + 1] = cutoff;
+
+        for (size_t i = 1; i <= m; ++i) {
+            const size_t lo = i > k ? i - k : 0;
+            const size_t hi = std::min(n, i + k);
+            size_t row_min = cutoff;
+
+            if (lo == 0) {
+                curr[0] = i;
+                row_min = i;
+            } else {
+                curr[lo - 1] = cutoff;
+            }
+
+            for (size_t j = std::max<size_t>(lo, 1); j <= hi; ++j) {
+                size_t cost = s1[i - 1] == s2[j - 1] ? 0 : 1;
+                size_t value = std::min({prev[j] + 1, curr[j - 1] + 1, prev[j - 1] + cost});
+                if constexpr (Transpositions) {
+                    if (i > 1 && j > 1 && s1[i - 1] == s2[j - 2] && s1[i - 2] == s2[j - 1]) {
+                        value = std::min(value, older[j - 2] + cost);
+                    }
+                }
+                value = std::min(value, cutoff);
+                curr[j] = value;
+                row_min = std::min(row_min, value);
+            }
+            if (hi + 1 <= n) curr[hi + 1] = cutoff;
+
+            if (row_min > k) return std::nullopt;
+
+            size_t* recycled = older;
+            older = prev;
+            prev = curr;
+            curr = recycled;
+        }
+
+        return prev[n] <= k ? std::optional<size_t>(prev[n]) : std::nullopt;
+    }
+};
+
+namespace detail {
+
+inline edit_distance_workspace& thread_workspace() {
+    thread_local edit_distance_workspace workspace;
+    return workspace;
+}
+
+} // namespace detail
+
+/**
+ * @brief Levenshtein distance (edit distance)
+ *
+ * Minimum number of single-character edits (insertions, deletions, substitutions)
+ * required to change one string into another.
+ *
+ * Uses Myers' bit-vector algorithm over the shorter string, one 64-bit word
+ * per 64 characters, after stripping the common prefix and suffix.
+ *
+ * Complexity: O(ceil(m/64)*n) time, no allocation once the workspace has grown
+ */
+inline size_t levenshtein_distance(std::string_view s1, std::string_view s2,
+                                   edit_distance_workspace& workspace) {
+    return workspace.levenshtein(s1, s2);
+}
+
+inline size_t levenshtein_distance(std::string_view s1, std::string_view s2) {
+    return levenshtein_distance(s1, s2, detail::thread_workspace());
+}
+
+/**
+ * @brief Levenshtein distance with a max_distance cutoff
+ *
+ * Returns the distance if it is at most k, nullopt otherwise. Rejects at
+ * once when the lengths differ by more than k, fills only the 2k+1 diagonal
+ * band of the DP matrix, and stops as soon as every cell of a band row
+ * exceeds k.
+ *
+ * Complexity: O(k*min(m,n)) time
+ */
+inline std::optional<size_t> levenshtein_distance_bounded(std::string_view s1, std::string_view s2, size_t k,
+                                                          edit_distance_workspace& workspace) {
+    return workspace.levenshtein_bounded(s1, s2, k);
+}
+
+inline std::optional<size_t> levenshtein_distance_bounded(std::string_view s1, std::string_view s2, size_t k) {
+    return levenshtein_distance_bounded(s1, s2, k, detail::thread_workspace());
 }
 
 /**
@@ -89,24 +555,62 @@ inline std::optional<size_t> hamming_distance(std::string_view s1, std::string_v
     return distance;
 }
 
-/**
- * @brief Jaro similarity
- *
- * Measures similarity between two strings, range [0, 1].
- * 0 = no similarity, 1 = identical
- *
- * Good for short strings like names.
- */
-inline double jaro_similarity(std::string_view s1, std::string_view s2) {
+namespace detail {
+
+// Characters of s1 and s2 are matching when equal and no further apart than
+// this (the standard Jaro window)
+inline size_t jaro_match_distance(size_t len1, size_t len2) {
+    size_t d = std::max(len1, len2) / 2;
+    return d > 0 ? d - 1 : 0;
+}
+
+inline double jaro_score(size_t matches, size_t transpositions, size_t len1, size_t len2) {
+    if (matches == 0) return 0.0;
+    double m = static_cast<double>(matches);
+    return (m / len1 + m / len2 + (m - transpositions / 2.0) / m) / 3.0;
+}
+
+// Jaro of s1 against s2 (both at most 64 characters), where peq[c] has bit
+// j set exactly when s2[j] == c for every character c of s1.
+//
+// Each character of s1 claims the first unclaimed equal character of s2
+// in its window, as the scalar algorithm does: the candidates are one AND,
+// the first of them is the lowest set bit. Transpositions pair the k-th
+// claimed positions of both strings.
+inline double jaro_bitmask(std::array<uint64_t, 256> const& peq, std::string_view s1, std::string_view s2) {
     const size_t len1 = s1.size();
     const size_t len2 = s2.size();
+    const size_t window = jaro_match_distance(len1, len2);
+    const uint64_t all2 = len2 == 64 ? ~uint64_t(0) : (uint64_t(1) << len2) - 1;
 
-    if (len1 == 0 && len2 == 0) return 1.0;
-    if (len1 == 0 || len2 == 0) return 0.0;
+    uint64_t claimed1 = 0;
+    uint64_t claimed2 = 0;
+    for (size_t i = 0; i < len1; ++i) {
+        uint64_t lower = i > window ? (uint64_t(1) << (i - window)) - 1 : 0;
+        uint64_t upper = i + window + 1 >= 64 ? ~uint64_t(0) : (uint64_t(1) << (i + window + 1)) - 1;
+        uint64_t candidates = peq[static_cast<unsigned char>(s1[i])] & upper & ~lower & all2 & ~claimed2;
+        if (candidates) {
+            claimed2 |= candidates & (~candidates + 1);
+            claimed1 |= uint64_t(1) << i;
+        }
+    }
 
-    // Maximum allowed distance for matching
-    size_t match_distance = std::max(len1, len2) / 2;
-    if (match_distance > 0) --match_distance;
+    const size_t matches = static_cast<size_t>(std::popcount(claimed1));
+    size_t transpositions = 0;
+    while (claimed1) {
+        size_t i = static_cast<size_t>(std::countr_zero(claimed1));
+        size_t j = static_cast<size_t>(std::countr_zero(claimed2));
+        transpositions += s1[i] != s2[j];
+        claimed1 &= claimed1 - 1;
+        claimed2 &= claimed2 - 1;
+    }
+    return jaro_score(matches, transpositions, len1, len2);
+}
+
+inline double jaro_scalar(std::string_view s1, std::string_view s2) {
+    const size_t len1 = s1.size();
+    const size_t len2 = s2.size();
+    const size_t match_distance = jaro_match_distance(len1, len2);
 
     std::vector<bool> s1_matches(len1, false);
     std::vector<bool> s2_matches(len2, false);
@@ -139,21 +643,11 @@ inline double jaro_similarity(std::string_view s1, std::string_view s2) {
         ++k;
     }
 
-    double m = static_cast<double>(matches);
-    return (m / len1 + m / len2 + (m - transpositions / 2.0) / m) / 3.0;
+    return jaro_score(matches, transpositions, len1, len2);
 }
 
-/**
- * @brief Jaro-Winkler similarity
- *
- * Extension of Jaro similarity that gives more weight to common prefixes.
- * Range [0, 1], where 1 = identical.
- *
- * Better than Jaro for strings with common prefixes (like names).
- */
-inline double jaro_winkler_similarity(std::string_view s1, std::string_view s2, double prefix_scale = 0.1) {
-    double jaro = jaro_similarity(s1, s2);
-
+// Winkler boost: up to 4 characters of common prefix, only for Jaro >= 0.7
+inline double winkler_boost(double jaro, std::string_view s1, std::string_view s2, double prefix_scale) {
     if (jaro < 0.7) return jaro;  // Only boost if already similar
 
     // Find common prefix (up to 4 characters)
@@ -171,34 +665,149 @@ inline double jaro_winkler_similarity(std::string_view s1, std::string_view s2,
     return jaro + prefix_len * prefix_scale * (1.0 - jaro);
 }
 
+} // namespace detail
+
 /**
- * @brief Longest Common Subsequence (LCS) length
+ * @brief Jaro similarity
  *
- * Length of longest subsequence common to both strings.
- * Note: subsequence doesn't need to be contiguous.
+ * Measures similarity between two strings, range [0, 1].
+ * 0 = no similarity, 1 = identical
+ *
+ * Good for short strings like names.
+ *
+ * When both strings have at most 64 characters, matches are found with
+ * 64-bit mask operations and nothing is allocated.
  */
-inline size_t lcs_length(std::string_view s1, std::string_view s2) {
-    const size_t m = s1.size();
-    const size_t n = s2.size();
+inline double jaro_similarity(std::string_view s1, std::string_view s2) {
+    if (s1.empty() && s2.empty()) return 1.0;
+    if (s1.empty() || s2.empty()) return 0.0;
+
+    if (s1.size() > 64 || s2.size() > 64) {
+        return detail::jaro_scalar(s1, s2);
+    }
 
-    if (m == 0 || n == 0) return 0;
+    // Only the entries that are read are cleared, not the whole table
+    std::array<uint64_t, 256> peq;
+    for (char c : s1) peq[static_cast<unsigned char>(c)] = 0;
+    for (char c : s2) peq[static_cast<unsigned char>(c)] = 0;
+    for (size_t j = 0; j < s2.size(); ++j) {
+        peq[static_cast<unsigned char>(s2[j])] |= uint64_t(1) << j;
+    }
+    return detail::jaro_bitmask(peq, s1, s2);
+}
 
-    // Use two rows for space efficiency
-    std::vector<size_t> prev(n + 1, 0);
-    std::vector<size_t> curr(n + 1, 0);
+/**
+ * @brief Jaro-Winkler similarity
+ *
+ * Extension of Jaro similarity that gives more weight to common prefixes.
+ * Range [0, 1], where 1 = identical.
+ *
+ * Better than Jaro for strings with common prefixes (like names).
+ */
+inline double jaro_winkler_similarity(std::string_view s1, std::string_view s2, double prefix_scale = 0.1) {
+    return detail::winkler_boost(jaro_similarity(s1, s2), s1, s2, prefix_scale);
+}
 
-    for (size_t i = 1; i <= m; ++i) {
-        for (size_t j = 1; j <= n; ++j) {
-            if (s1[i - 1] == s2[j - 1]) {
-                curr[j] = prev[j - 1] + 1;
-            } else {
-                curr[j] = std::max(prev[j], curr[j - 1]);
+/**
+ * @brief One Jaro query prepared for scoring against many candidates
+ *
+ * Builds the query's character masks once; each candidate then costs one
+ * pass over its characters with no allocation. Jaro is symmetric, so the
+ * scores equal jaro_similarity(query, candidate) exactly. Queries or
+ * candidates longer than 64 characters fall back to the scalar algorithm.
+ *
+ * The pattern refers to the query text, which must outlive it.
+ */
+class jaro_pattern {
+public:
+    explicit jaro_pattern(std::string_view query) : query(query) {
+        if (query.size() <= 64) {
+            for (size_t j = 0; j < query.size(); ++j) {
+                peq[static_cast<unsigned char>(query[j])] |= uint64_t(1) << j;
             }
         }
-        std::swap(prev, curr);
     }
 
-    return prev[n];
+    double jaro(std::string_view candidate) const {
+        if (query.empty() && candidate.empty()) return 1.0;
+        if (query.empty() || candidate.empty()) return 0.0;
+        if (query.size() > 64 || candidate.size() > 64) {
+            return detail::jaro_scalar(query, candidate);
+        }
+        // Claiming positions of the query rather than of the candidate is
+        // what lets the masks be shared; the result is the same
+        return detail::jaro_bitmask(peq, candidate, query);
+    }
+
+    double jaro_winkler(std::string_view candidate, double prefix_scale = 0.1) const {
+        return detail::winkler_boost(jaro(candidate), query, candidate, prefix_scale);
+    }
+
+private:
+    std::string_view query;
+    std::array<uint64_t, 256> peq{};
+};
+
+/**
+ * @brief Jaro similarity of one query against each candidate
+ *
+ * Writes jaro_similarity(query, candidates[i]) to out[i] for every i
+ * (out must be at least as long as candidates).
+ */
+inline void jaro_similarity_batch(std::string_view query, std::span<const std::string_view> candidates,
+                                  std::span<double> out) {
+    jaro_pattern pattern(query);
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        out[i] = pattern.jaro(candidates[i]);
+    }
+}
+
+/**
+ * @brief Jaro-Winkler similarity of one query against each candidate
+ *
+ * Batch form of jaro_winkler_similarity; see jaro_similarity_batch.
+ */
+inline void jaro_winkler_similarity_batch(std::string_view query, std::span<const std::string_view> candidates,
+                                          std::span<double> out, double prefix_scale = 0.1) {
+    jaro_pattern pattern(query);
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        out[i] = pattern.jaro_winkler(candidates[i], prefix_scale);
+    }
+}
+
+/**
+ * @brief Longest Common Subsequence (LCS) length
+ *
+ * Length of longest subsequence common to both strings.
+ * Note: subsequence doesn't need to be contiguous.
+ *
+ * Bit-parallel (Allison-Dix / Hyyro): one word operation per 64 characters
+ * of the shorter string for each character of the longer one.
+ *
+ * Complexity: O(ceil(m/64)*n) time, O(m/64) memory once the workspace has grown
+ */
+inline size_t lcs_length(std::string_view s1, std::string_view s2, edit_distance_workspace& workspace) {
+    return workspace.lcs(s1, s2);
+}
+
+inline size_t lcs_length(std::string_view s1, std::string_view s2) {
+    return lcs_length(s1, s2, detail::thread_workspace());
+}
+
+/**
+ * @brief One longest common subsequence, as aligned index pairs
+ *
+ * Returns increasing pairs (i, j) with s1[i] == s2[j]; there are exactly
+ * lcs_length(s1, s2) of them. Suitable for diffing long texts: memory is
+ * linear and time is O(m*n/64) up to a logarithmic factor.
+ */
+inline std::vector<std::pair<size_t, size_t>> lcs_alignment(std::string_view s1, std::string_view s2,
+                                                            edit_distance_workspace& workspace) {
+    return workspace.lcs_alignment(s1, s2);
+}
+
+inline std::vector<std::pair<size_t, size_t>> lcs_alignment(std::string_view s1, std::string_view s2) {
+    return lcs_alignment(s1, s2, detail::thread_workspace());
 }
 
 /**
@@ -221,40 +830,34 @@ inline double lcs_similarity(std::string_view s1, std::string_view s2) {
  *
  * Like Levenshtein but also allows transpositions (swapping adjacent characters).
  * More accurate for typos than plain Levenshtein.
+ *
+ * Computes the optimal string alignment variant (no substring is edited
+ * twice) with Hyyro's bit-vector extension of Myers' algorithm.
+ *
+ * Complexity: O(ceil(m/64)*n) time, no allocation once the workspace has grown
  */
-inline size_t damerau_levenshtein_distance(std::string_view s1, std::string_view s2) {
-    const size_t m = s1.size();
-    const size_t n = s2.size();
-
-    if (m == 0) return n;
-    if (n == 0) return m;
-
-    // Need full matrix for transpositions
-    std::vector<std::vector<size_t>> dp(m + 1, std::vector<size_t>(n + 1));
-
-    for (size_t i = 0; i <= m; ++i) dp[i][0] = i;
-    for (size_t j = 0; j <= n; ++j) dp[0][j] = j;
-
-    for (size_t i = 1; i <= m; ++i) {
-        for (size_t j = 1; j <= n; ++j) {
-            size_t cost = (s1[i - 1] == s2[j - 1]) ? 0 : 1;
+inline size_t damerau_levenshtein_distance(std::string_view s1, std::string_view s2,
+                                           edit_distance_workspace& workspace) {
+    return workspace.damerau_levenshtein(s1, s2);
+}
 
-            dp[i][j] = std::min({
-                dp[i - 1][j] + 1,       // deletion
-                dp[i][j - 1] + 1,       // insertion
-                dp[i - 1][j - 1] + cost // substitution
-            });
+inline size_t damerau_levenshtein_distance(std::string_view s1, std::string_view s2) {
+    return damerau_levenshtein_distance(s1, s2, detail::thread_workspace());
+}
 
-            // Transposition
-            if (i > 1 && j > 1 &&
-                s1[i - 1] == s2[j - 2] &&
-                s1[i - 2] == s2[j - 1]) {
-                dp[i][j] = std::min(dp[i][j], dp[i - 2][j - 2] + cost);
-            }
-        }
-    }
+/**
+ * @brief Damerau-Levenshtein (OSA) distance with a max_distance cutoff
+ *
+ * Banded counterpart of damerau_levenshtein_distance; see
+ * levenshtein_distance_bounded.
+ */
+inline std::optional<size_t> damerau_levenshtein_distance_bounded(std::string_view s1, std::string_view s2, size_t k,
+                                                                  edit_distance_workspace& workspace) {
+    return workspace.damerau_levenshtein_bounded(s1, s2, k);
+}
 
-    return dp[m][n];
+inline std::optional<size_t> damerau_levenshtein_distance_bounded(std::string_view s1, std::string_view s2, size_t k) {
+    return damerau_levenshtein_distance_bounded(s1, s2, k, detail::thread_workspace());
 }
 
 /**
@@ -264,6 +867,14 @@ inline size_t damerau_levenshtein_distance(std::string_view s1, std::string_view
  * Returns true if similarity >= threshold (default 0.8).
  */
 inline bool are_similar(std::string_view s1, std::string_view s2, double threshold = 0.8) {
+    // At most min(len) characters can match, which bounds Jaro from above;
+    // the Winkler boost can close at most 40% of the remaining gap
+    if (!s1.empty() && !s2.empty()) {
+        double shorter = static_cast<double>(std::min(s1.size(), s2.size()));
+        double jaro_bound = (shorter / s1.size() + shorter / s2.size() + 1.0) / 3.0;
+        double bound = jaro_bound < 0.7 ? jaro_bound : jaro_bound + 0.4 * (1.0 - jaro_bound);
+        if (bound < threshold) return false;
+    }
     return jaro_winkler_similarity(s1, s2) >= threshold;
 }
 
@@ -273,7 +884,7 @@ inline bool are_similar(std::string_view s1, std::string_view s2, double thresho
  * Returns true if Levenshtein distance <= max_distance.
  */
 inline bool within_distance(std::string_view s1, std::string_view s2, size_t max_distance) {
-    return levenshtein_distance(s1, s2) <= max_distance;
+    return levenshtein_distance_bounded(s1, s2, max_distance).has_value();
 }
 
 } // namespace similarity
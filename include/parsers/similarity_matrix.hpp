@@ -0,0 +1,239 @@
+#pragma once
+
+#include "parsers/similarity.hpp"
+#include "parsers/thread_pool.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace alga {
+namespace similarity {
+
+/**
+ * @brief Pairwise measure used by similarity_matrix
+ *
+ * levenshtein and damerau_levenshtein are distances: a pair is kept when
+ * its distance is at most the threshold. jaro_winkler and lcs (that is,
+ * lcs_similarity) are similarities: a pair is kept when its score is at
+ * least the threshold.
+ */
+enum class pair_metric { levenshtein, damerau_levenshtein, jaro_winkler, lcs };
+
+/**
+ * @brief One entry of the sparse similarity matrix
+ */
+struct similar_pair {
+    size_t first;   // Index of the first string, always < second
+    size_t second;  // Index of the second string
+    double score;   // Distance or similarity, as the metric defines it
+
+    bool operator==(similar_pair const&) const = default;
+};
+
+/**
+ * @brief Tuning knobs for similarity_matrix
+ */
+struct similarity_matrix_options {
+    thread_pool* pool = nullptr;       // nullptr: default_thread_pool()
+    size_t tile = 64;                  // Strings per tile on each side
+    size_t parallel_threshold = 512;   // Smaller inputs run on the caller only
+};
+
+namespace detail {
+
+// Character counts in 32 buckets (byte mod 32, so 'a' and 'A' share one).
+// Summing min over buckets never undercounts the characters two strings
+// have in common, which bounds every metric from the optimistic side.
+// Byte counters keep the comparison to a couple of vector instructions; a
+// string with a bucket past 255 is marked saturated and never filtered.
+struct char_histogram {
+    std::array<uint8_t, 32> counts{};
+    bool saturated = false;
+};
+
+inline char_histogram make_histogram(std::string_view s) {
+    char_histogram h;
+    for (char c : s) {
+        uint8_t& count = h.counts[static_cast<unsigned char>(c) % 32];
+        if (count == 255) {
+            h.saturated = true;
+        } else {
+            ++count;
+        }
+    }
+    return h;
+}
+
+// Upper bound on the characters shared by strings with these histograms;
+// shorter is the length of the shorter string, the bound when saturated
+inline size_t common_characters(char_histogram const& a, char_histogram const& b, size_t shorter) {
+    if (a.saturated || b.saturated) return shorter;
+    unsigned common = 0;
+    for (size_t i = 0; i < a.counts.size(); ++i) common += std::min(a.counts[i], b.counts[i]);
+    return common;
+}
+
+// Whether a pair with these lengths could pass, given an upper bound on the
+// characters they share (min(la, lb) when only lengths are known) and, for
+// Jaro-Winkler, on their common prefix
+inline bool may_pass(pair_metric metric, double threshold, size_t la, size_t lb, size_t common,
+                     size_t prefix = 4) {
+    switch (metric) {
+        case pair_metric::levenshtein:
+        case pair_metric::damerau_levenshtein:
+            // Characters not shared each need at least one edit
+            return static_cast<double>(std::max(la, lb) - common) <= threshold;
+        case pair_metric::jaro_winkler: {
+            if (la == 0 || lb == 0) return (la == lb ? 1.0 : 0.0) >= threshold;
+            double m = static_cast<double>(common);
+            double jaro = m == 0 ? 0.0 : (m / la + m / lb + 1.0) / 3.0;
+            double bound = jaro < 0.7 ? jaro : jaro + 0.1 * static_cast<double>(prefix) * (1.0 - jaro);
+            return bound >= threshold;
+        }
+        case pair_metric::lcs:
+            if (la + lb == 0) return 1.0 >= threshold;
+            return 2.0 * static_cast<double>(common) / static_cast<double>(la + lb) >= threshold;
+    }
+    return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief All pairs of strings whose score passes threshold
+ *
+ * Replaces an N x N loop over a pairwise function with a sparse result.
+ * Strings are ordered by length so that each string only meets the run of
+ * lengths that could still pass, and a character histogram bound discards
+ * most of the remaining pairs before any metric runs. Surviving pairs are
+ * scored with the bounded edit distances or a prepared Jaro pattern.
+ *
+ * Work is cut into tiles of options.tile strings on each side, which keeps
+ * both tiles' strings and histograms in cache, and row tiles are spread
+ * over the thread pool.
+ *
+ * @return Pairs with first < second, sorted by (first, second)
+ */
+inline std::vector<similar_pair> similarity_matrix(std::span<const std::string_view> strings, pair_metric metric,
+                                                   double threshold, similarity_matrix_options const& options = {}) {
+    const size_t n = strings.size();
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return strings[a].size() < strings[b].size();
+    });
+
+    std::vector<detail::char_histogram> histograms(n);
+    for (size_t r = 0; r < n; ++r) histograms[r] = detail::make_histogram(strings[order[r]]);
+
+    const bool is_distance = metric == pair_metric::levenshtein || metric == pair_metric::damerau_levenshtein;
+    if (is_distance && threshold < 0) return {};
+    const size_t max_distance = is_distance ? static_cast<size_t>(std::min(threshold, 1e15)) : 0;
+
+    const size_t tile = std::max<size_t>(options.tile, 1);
+    const size_t tiles = (n + tile - 1) / tile;
+    std::vector<std::vector<similar_pair>> found(tiles);
+
+    // Scores ranks r < s of a row tile against one column tile. A later
+    // column tile holds only strings at least as long as the row tile's, so
+    // once its shortest is too long for the row tile's longest, it and every
+    // tile after it are skipped by returning false.
+    auto score_tile = [&](size_t row_tile, size_t col_tile) {
+        const size_t row_begin = row_tile * tile;
+        const size_t row_end = std::min(n, row_begin + tile);
+        const size_t col_begin = col_tile * tile;
+        const size_t col_end = std::min(n, col_begin + tile);
+
+        size_t shortest_col = strings[order[col_begin]].size();
+        size_t longest_row = strings[order[row_end - 1]].size();
+        if (col_tile != row_tile && !detail::may_pass(metric, threshold, longest_row, shortest_col, longest_row)) {
+            return false;
+        }
+
+        auto& out = found[row_tile];
+        for (size_t r = row_begin; r < row_end; ++r) {
+            std::string_view a = strings[order[r]];
+            std::optional<jaro_pattern> pattern;
+            if (metric == pair_metric::jaro_winkler) pattern.emplace(a);
+
+            for (size_t s = std::max(col_begin, r + 1); s < col_end; ++s) {
+                std::string_view b = strings[order[s]];
+                if (!detail::may_pass(metric, threshold, a.size(), b.size(), a.size())) {
+                    break;  // Lengths only grow along the column
+                }
+                size_t prefix = 4;
+                if (metric == pair_metric::jaro_winkler) {
+                    prefix = 0;
+                    while (prefix < 4 && prefix < a.size() && a[prefix] == b[prefix]) ++prefix;
+                }
+                if (!detail::may_pass(metric, threshold, a.size(), b.size(),
+                                      detail::common_characters(histograms[r], histograms[s], a.size()), prefix)) {
+                    continue;
+                }
+
+                double score = 0;
+                bool keep = false;
+                switch (metric) {
+                    case pair_metric::levenshtein:
+                        if (auto d = levenshtein_distance_bounded(a, b, max_distance)) {
+                            score = static_cast<double>(*d);
+                            keep = true;
+                        }
+                        break;
+                    case pair_metric::damerau_levenshtein:
+                        if (auto d = damerau_levenshtein_distance_bounded(a, b, max_distance)) {
+                            score = static_cast<double>(*d);
+                            keep = true;
+                        }
+                        break;
+                    case pair_metric::jaro_winkler:
+                        score = pattern->jaro_winkler(b);
+                        keep = score >= threshold;
+                        break;
+                    case pair_metric::lcs:
+                        score = lcs_similarity(a, b);
+                        keep = score >= threshold;
+                        break;
+                }
+                if (keep) {
+                    size_t i = order[r];
+                    size_t j = order[s];
+                    out.push_back({std::min(i, j), std::max(i, j), score});
+                }
+            }
+        }
+        return true;
+    };
+
+    auto run_rows = [&](size_t begin, size_t end) {
+        for (size_t row_tile = begin; row_tile < end; ++row_tile) {
+            size_t col_tile = row_tile;
+            while (col_tile < tiles && score_tile(row_tile, col_tile)) ++col_tile;
+        }
+    };
+
+    if (n < options.parallel_threshold) {
+        run_rows(0, tiles);
+    } else {
+        thread_pool& pool = options.pool ? *options.pool : default_thread_pool();
+        pool.parallel_for(tiles, 1, run_rows);
+    }
+
+    std::vector<similar_pair> pairs;
+    size_t total = 0;
+    for (auto const& part : found) total += part.size();
+    pairs.reserve(total);
+    for (auto const& part : found) pairs.insert(pairs.end(), part.begin(), part.end());
+    std::sort(pairs.begin(), pairs.end(), [](similar_pair const& x, similar_pair const& y) {
+        return x.first != y.first ? x.first < y.first : x.second < y.second;
+    });
+    return pairs;
+}
+
+} // namespace similarity
+} // namespace alga
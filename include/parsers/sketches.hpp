@@ -0,0 +1,925 @@
+#pragma once
+
+#include "parsers/hash_mix.hpp"
+#include "parsers/statistics.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace alga {
+namespace statistics {
+
+namespace detail {
+
+// Salted std::hash, spread over all 64 bits
+template<typename T>
+uint64_t sketch_hash(const T& element, uint64_t seed) {
+    return alga::detail::mix64(static_cast<uint64_t>(std::hash<T>{}(element)) ^ seed);
+}
+
+inline constexpr uint64_t default_sketch_seed = 0x9e3779b97f4a7c15ULL;
+
+} // namespace detail
+
+/**
+ * @brief Approximate counts in fixed memory (Count-Min Sketch)
+ *
+ * depth rows of width counters; an element adds to one counter per row
+ * and its count is the smallest of those counters. Estimates never fall
+ * below the true count, and with probability 1 - delta exceed it by at
+ * most epsilon * total(), using ceil(e / epsilon) x ceil(ln(1 / delta))
+ * counters whatever the vocabulary size.
+ *
+ * Sketches built with the same epsilon, delta and seed merge by adding
+ * counters, giving exactly the sketch of the combined stream.
+ */
+template<typename T>
+class CountMinSketch {
+public:
+    explicit CountMinSketch(double epsilon = 1e-3, double delta = 1e-2,
+                            uint64_t seed = detail::default_sketch_seed)
+        : columns(static_cast<size_t>(std::ceil(std::exp(1.0) / std::clamp(epsilon, 1e-9, 1.0)))),
+          rows(static_cast<size_t>(std::ceil(std::log(1.0 / std::clamp(delta, 1e-12, 0.5))))),
+          seed(seed),
+          counters(columns * rows, 0) {}
+
+    void add(const T& element, size_t n = 1) {
+        const uint64_t h = detail::sketch_hash(element, seed);
+        for (size_t r = 0; r < rows; ++r) counters[cell(h, r)] += n;
+        total_count += n;
+    }
+
+    void add_all(const std::vector<T>& elements) {
+        for (const auto& elem : elements) {
+            add(elem);
+        }
+    }
+
+    /**
+     * @brief Estimated count, never below the true count
+     */
+    size_t count(const T& element) const {
+        const uint64_t h = detail::sketch_hash(element, seed);
+        size_t estimate = SIZE_MAX;
+        for (size_t r = 0; r < rows; ++r) estimate = std::min(estimate, counters[cell(h, r)]);
+        return total_count == 0 ? 0 : estimate;
+    }
+
+    double frequency(const T& element) const {
+        if (total_count == 0) return 0.0;
+        return static_cast<double>(count(element)) / total_count;
+    }
+
+    size_t total() const { return total_count; }
+    size_t width() const { return columns; }
+    size_t depth() const { return rows; }
+
+    /**
+     * @brief Add another sketch's counts; false if the shapes or seeds differ
+     */
+    bool merge(const CountMinSketch& other) {
+        if (other.columns != columns || other.rows != rows || other.seed != seed) return false;
+        for (size_t i = 0; i < counters.size(); ++i) counters[i] += other.counters[i];
+        total_count += other.total_count;
+        return true;
+    }
+
+    void clear() {
+        std::fill(counters.begin(), counters.end(), 0);
+        total_count = 0;
+    }
+
+private:
+    // Row r's column by double hashing, from the two halves of one hash
+    size_t cell(uint64_t h, size_t r) const {
+        uint64_t h1 = h & 0xffffffffULL;
+        uint64_t h2 = (h >> 32) | 1;
+        return r * columns + static_cast<size_t>((h1 + r * h2) % columns);
+    }
+
+    size_t columns;
+    size_t rows;
+    uint64_t seed;
+    std::vector<size_t> counters;  // rows x columns, row-major
+    size_t total_count = 0;
+};
+
+/**
+ * @brief Approximate number of distinct elements (HyperLogLog)
+ *
+ * 2^precision one-byte registers, each holding the longest run of leading
+ * zeros seen among the hashes routed to it. The relative standard error
+ * is 1.04 / sqrt(2^precision): about 0.8% for the default 14, in 16 KiB.
+ * The estimate comes from the histogram of register values, which stays
+ * unbiased from the smallest cardinalities up, with no switch-over to
+ * linear counting.
+ *
+ * Sketches with the same precision and seed merge by taking the larger
+ * register, giving exactly the sketch of the combined stream.
+ */
+template<typename T>
+class HyperLogLog {
+public:
+    explicit HyperLogLog(unsigned precision = 14, uint64_t seed = detail::default_sketch_seed)
+        : bits(std::clamp(precision, 4u, 18u)), seed(seed), registers(size_t(1) << bits, 0) {}
+
+    /**
+     * @brief Smallest sketch whose relative standard error is at most error
+     */
+    static HyperLogLog for_error(double error, uint64_t seed = detail::default_sketch_seed) {
+        double m = std::pow(1.04 / std::max(error, 1e-4), 2.0);
+        return HyperLogLog(static_cast<unsigned>(std::ceil(std::log2(m))), seed);
+    }
+
+    void add(const T& element) {
+        const uint64_t h = detail::sketch_hash(element, seed);
+        size_t index = static_cast<size_t>(h >> (64 - bits));
+        uint64_t rest = h << bits;
+        auto rank = static_cast<uint8_t>(rest == 0 ? 64 - bits + 1 : std::countl_zero(rest) + 1);
+        registers[index] = std::max(registers[index], rank);
+    }
+
+    void add_all(const std::vector<T>& elements) {
+        for (const auto& elem : elements) {
+            add(elem);
+        }
+    }
+
+    /**
+     * @brief Estimated number of distinct elements added
+     */
+    size_t unique_count() const {
+        // Ertl's improved estimator ("New cardinality estimation algorithms
+        // for HyperLogLog sketches", 2017): the register histogram replaces
+        // the switch between linear counting and the raw estimate, whose
+        // bias just above that switch exceeds the standard error
+        const unsigned q = 64 - bits;
+        std::vector<size_t> histogram(q + 2, 0);
+        for (uint8_t r : registers) {
+            ++histogram[r];
+        }
+        const double m = static_cast<double>(registers.size());
+        double z = m * tau(1.0 - static_cast<double>(histogram[q + 1]) / m);
+        for (unsigned k = q; k >= 1; --k) {
+            z = 0.5 * (z + static_cast<double>(histogram[k]));
+        }
+        z += m * sigma(static_cast<double>(histogram[0]) / m);
+        const double alpha = 0.5 / std::log(2.0);
+        return static_cast<size_t>(std::llround(alpha * m * m / z));
+    }
+
+    double relative_error() const {
+        return 1.04 / std::sqrt(static_cast<double>(registers.size()));
+    }
+
+    unsigned precision() const { return bits; }
+
+    /**
+     * @brief Fold in another sketch; false if the precision or seed differs
+     */
+    bool merge(const HyperLogLog& other) {
+        if (other.bits != bits || other.seed != seed) return false;
+        for (size_t i = 0; i < registers.size(); ++i) {
+            registers[i] = std::max(registers[i], other.registers[i]);
+        }
+        return true;
+    }
+
+    void clear() {
+        std::fill(registers.begin(), registers.end(), 0);
+    }
+
+private:
+    // x + sum over k >= 1 of x^(2^k) 2^(k-1): the share of empty registers
+    static double sigma(double x) {
+        if (x == 1.0) return std::numeric_limits<double>::infinity();
+        double y = 1.0;
+        double z = x;
+        double previous;
+        do {
+            x *= x;
+            previous = z;
+            z += x * y;
+            y += y;
+        } while (z != previous);
+        return z;
+    }
+
+    // Correction for registers that saturated at the largest rank
+    static double tau(double x) {
+        if (x == 0.0 || x == 1.0) return 0.0;
+        double y = 1.0;
+        double z = 1.0 - x;
+        double previous;
+        do {
+            x = std::sqrt(x);
+            previous = z;
+            y *= 0.5;
+            z -= (1.0 - x) * (1.0 - x) * y;
+        } while (z != previous);
+        return z / 3.0;
+    }
+
+    unsigned bits;
+    uint64_t seed;
+    std::vector<uint8_t> registers;
+};
+
+/**
+ * @brief Streaming top-k tracker (Space-Saving, Metwally et al.)
+ *
+ * Tracks at most capacity elements with a counter each. A new element
+ * that finds every counter taken replaces the one with the smallest
+ * count m, inheriting m + 1 and recording m as its possible
+ * overestimate. Memory stays O(capacity) however long the stream, and at
+ * any moment:
+ * - every element occurring more than total() / capacity times is tracked;
+ * - a tracked element's true count lies in [count - error, count].
+ *
+ * The counters sit in a min-heap, so each add is O(log capacity) and
+ * top_n is available at any point of the stream. With std::string_view
+ * elements the tracker keeps its own copies of the tracked strings.
+ *
+ * Trackers merge as mergeable summaries (Agarwal et al.): an element
+ * missing from one side is credited with that side's smallest count as
+ * possible error, and the capacity highest combined counts are kept, so
+ * both guarantees hold for the combined stream.
+ */
+template<typename T>
+class SpaceSaving {
+public:
+    /**
+     * @brief Element type of results: std::string for std::string_view
+     *
+     * Results own their elements, so they stay valid when a later add()
+     * evicts the counter they were read from, or merge() replaces them all.
+     */
+    using item_type = std::conditional_t<std::is_same_v<T, std::string_view>, std::string, T>;
+
+    /**
+     * @brief A tracked element, its estimated count and possible overestimate
+     */
+    struct entry {
+        item_type item;
+        size_t count;
+        size_t error;
+
+        bool operator==(entry const&) const = default;
+    };
+
+    explicit SpaceSaving(size_t capacity = 1000) : max_size(std::max<size_t>(capacity, 1)) {
+        slots.reserve(max_size);
+        heap.reserve(max_size);
+    }
+
+    SpaceSaving(SpaceSaving const& other)
+        : slots(other.slots), heap(other.heap), max_size(other.max_size), total_count(other.total_count) {
+        slots.reserve(max_size);
+        rebuild_index();
+    }
+
+    SpaceSaving(SpaceSaving&&) noexcept = default;
+
+    SpaceSaving& operator=(SpaceSaving other) noexcept {
+        std::swap(slots, other.slots);
+        std::swap(heap, other.heap);
+        std::swap(index, other.index);
+        std::swap(max_size, other.max_size);
+        std::swap(total_count, other.total_count);
+        return *this;
+    }
+
+    /**
+     * @brief Tracker whose counts overestimate by at most epsilon * total()
+     */
+    static SpaceSaving for_error(double epsilon) {
+        return SpaceSaving(static_cast<size_t>(std::ceil(1.0 / std::clamp(epsilon, 1e-9, 1.0))));
+    }
+
+    /**
+     * @brief Add n occurrences of an element
+     */
+    void add(const T& element, size_t n = 1) {
+        total_count += n;
+        auto it = index.find(element);
+        if (it != index.end()) {
+            slots[it->second].count += n;
+            sift_down(slots[it->second].heap_pos);
+            return;
+        }
+
+        if (slots.size() < max_size) {
+            auto s = static_cast<uint32_t>(slots.size());
+            slots.push_back({stored_type(element), n, 0, static_cast<uint32_t>(heap.size())});
+            heap.push_back(s);
+            index.emplace(key_of(slots[s]), s);
+            sift_up(slots[s].heap_pos);
+            return;
+        }
+
+        // Take over the smallest counter
+        uint32_t s = heap.front();
+        index.erase(key_of(slots[s]));
+        slots[s].item = stored_type(element);
+        slots[s].error = slots[s].count;
+        slots[s].count += n;
+        index.emplace(key_of(slots[s]), s);
+        sift_down(0);
+    }
+
+    void add_all(const std::vector<T>& elements) {
+        for (const auto& elem : elements) {
+            add(elem);
+        }
+    }
+
+    /**
+     * @brief Estimated count: an upper bound for tracked elements, 0 otherwise
+     */
+    size_t count(const T& element) const {
+        auto it = index.find(element);
+        return it != index.end() ? slots[it->second].count : 0;
+    }
+
+    /**
+     * @brief Occurrences of an element that are certain: count - error
+     */
+    size_t guaranteed_count(const T& element) const {
+        auto it = index.find(element);
+        return it != index.end() ? slots[it->second].count - slots[it->second].error : 0;
+    }
+
+    bool contains(const T& element) const {
+        return index.find(element) != index.end();
+    }
+
+    /**
+     * @brief Number of elements added
+     */
+    size_t total() const { return total_count; }
+
+    /**
+     * @brief Number of elements being tracked
+     */
+    size_t unique_count() const { return slots.size(); }
+
+    size_t capacity() const { return max_size; }
+
+    /**
+     * @brief Tracked elements, highest estimated count first
+     */
+    std::vector<entry> entries() const {
+        std::vector<entry> all;
+        all.reserve(slots.size());
+        for (auto const& s : slots) all.push_back({s.item, s.count, s.error});
+        std::sort(all.begin(), all.end(), [](entry const& a, entry const& b) { return higher(a, b); });
+        return all;
+    }
+
+    /**
+     * @brief The n tracked elements with the highest estimated counts
+     *
+     * Ties are broken by element order when T has one, as in
+     * FrequencyCounter::top_n.
+     */
+    std::vector<std::pair<item_type, size_t>> top_n(size_t n) const {
+        auto all = entries();
+        std::vector<std::pair<item_type, size_t>> top;
+        top.reserve(std::min(n, all.size()));
+        for (size_t i = 0; i < all.size() && i < n; ++i) top.emplace_back(std::move(all[i].item), all[i].count);
+        return top;
+    }
+
+    std::vector<std::pair<item_type, size_t>> most_common() const {
+        return top_n(slots.size());
+    }
+
+    std::optional<item_type> mode() const {
+        if (slots.empty()) return std::nullopt;
+        return top_n(1).front().first;
+    }
+
+    /**
+     * @brief Fold in another tracker's counters
+     */
+    void merge(const SpaceSaving& other) {
+        const size_t own_floor = floor_count();
+        const size_t other_floor = other.floor_count();
+
+        std::vector<entry> combined;
+        combined.reserve(slots.size() + other.slots.size());
+        for (auto const& s : slots) {
+            auto it = other.index.find(key_of(s));
+            if (it != other.index.end()) {
+                auto const& o = other.slots[it->second];
+                combined.push_back({s.item, s.count + o.count, s.error + o.error});
+            } else {
+                combined.push_back({s.item, s.count + other_floor, s.error + other_floor});
+            }
+        }
+        for (auto const& o : other.slots) {
+            if (!contains(key_of(o))) {
+                combined.push_back({o.item, o.count + own_floor, o.error + own_floor});
+            }
+        }
+        std::sort(combined.begin(), combined.end(), [](entry const& a, entry const& b) { return higher(a, b); });
+        if (combined.size() > max_size) combined.resize(max_size);
+
+        std::vector<slot> merged;
+        merged.reserve(max_size);
+        for (auto& e : combined) merged.push_back({std::move(e.item), e.count, e.error, 0});
+        slots = std::move(merged);
+        heap.clear();
+        for (uint32_t s = 0; s < slots.size(); ++s) {
+            slots[s].heap_pos = s;
+            heap.push_back(s);
+        }
+        // Sorted by descending count; reverse positions to form a min-heap
+        std::reverse(heap.begin(), heap.end());
+        for (size_t pos = 0; pos < heap.size(); ++pos) slots[heap[pos]].heap_pos = static_cast<uint32_t>(pos);
+        rebuild_index();
+        total_count += other.total_count;
+    }
+
+    void clear() {
+        slots.clear();
+        heap.clear();
+        index.clear();
+        total_count = 0;
+    }
+
+private:
+    // Views must point into storage the tracker owns
+    using stored_type = item_type;
+
+    struct slot {
+        stored_type item;
+        size_t count;
+        size_t error;
+        uint32_t heap_pos;
+    };
+
+    // Count an untracked element may have had: the smallest counter once full
+    size_t floor_count() const {
+        return slots.size() < max_size || heap.empty() ? 0 : slots[heap.front()].count;
+    }
+
+    static T key_of(slot const& s) {
+        return T(s.item);
+    }
+
+    static bool higher(entry const& a, entry const& b) {
+        if (a.count != b.count) return a.count > b.count;
+        if constexpr (std::totally_ordered<T>) {
+            return a.item < b.item;
+        } else {
+            return false;
+        }
+    }
+
+    void rebuild_index() {
+        index.clear();
+        for (uint32_t s = 0; s < slots.size(); ++s) index.emplace(key_of(slots[s]), s);
+    }
+
+    void swap_heap(size_t a, size_t b) {
+        std::swap(heap[a], heap[b]);
+        slots[heap[a]].heap_pos = static_cast<uint32_t>(a);
+        slots[heap[b]].heap_pos = static_cast<uint32_t>(b);
+    }
+
+    void sift_up(size_t pos) {
+        while (pos > 0) {
+            size_t parent = (pos - 1) / 2;
+            if (slots[heap[parent]].count <= slots[heap[pos]].count) break;
+            swap_heap(pos, parent);
+            pos = parent;
+        }
+    }
+
+    void sift_down(size_t pos) {
+        for (;;) {
+            size_t smallest = pos;
+            for (size_t child = 2 * pos + 1; child <= 2 * pos + 2 && child < heap.size(); ++child) {
+                if (slots[heap[child]].count < slots[heap[smallest]].count) smallest = child;
+            }
+            if (smallest == pos) return;
+            swap_heap(pos, smallest);
+            pos = smallest;
+        }
+    }
+
+    std::vector<slot> slots;      // Never reallocated, so string_view keys stay valid
+    std::vector<uint32_t> heap;   // Slot ids, min-heap on count
+    std::unordered_map<T, uint32_t> index;
+    size_t max_size;
+    size_t total_count = 0;
+};
+
+/**
+ * @brief Error bounds and sizes for FrequencySketch
+ */
+struct sketch_options {
+    double epsilon = 1e-3;          // Count-Min overestimate, as a fraction of total()
+    double delta = 1e-2;            // Probability of exceeding it
+    unsigned precision = 14;        // HyperLogLog registers: 2^precision
+    size_t heavy_hitters = 1000;    // Space-Saving counters
+    uint64_t seed = detail::default_sketch_seed;
+};
+
+/**
+ * @brief Constant-memory stand-in for FrequencyCounter
+ *
+ * Answers the same queries from three sketches: count and frequency from
+ * a Count-Min Sketch, unique_count from HyperLogLog, and most_common,
+ * top_n and mode from Space-Saving. Memory depends on sketch_options,
+ * not on the vocabulary, and sketches with the same options merge.
+ *
+ * shannon_entropy, normalized_entropy, simpson_diversity and
+ * type_token_ratio accept it, and are then approximate: the heavy hitters
+ * contribute their estimated counts and the rest of the total is spread
+ * evenly over the remaining estimated distinct elements. Measures that
+ * need the whole histogram (Gini, hapax and dis legomena) are not
+ * available.
+ */
+template<typename T>
+class FrequencySketch {
+public:
+    explicit FrequencySketch(sketch_options const& options = {})
+        : counts(options.epsilon, options.delta, options.seed),
+          distinct(options.precision, options.seed),
+          heavy(options.heavy_hitters) {}
+
+    void add(const T& element) {
+        add(element, 1);
+    }
+
+    void add(const T& element, size_t n) {
+        counts.add(element, n);
+        distinct.add(element);
+        heavy.add(element, n);
+    }
+
+    void add_all(const std::vector<T>& elements) {
+        for (const auto& elem : elements) {
+            add(elem);
+        }
+    }
+
+    /**
+     * @brief Estimated count, never below the true count
+     */
+    size_t count(const T& element) const {
+        size_t estimate = counts.count(element);
+        if (heavy.contains(element)) estimate = std::min(estimate, heavy.count(element));
+        return estimate;
+    }
+
+    size_t total() const { return counts.total(); }
+
+    /**
+     * @brief Estimated number of distinct elements
+     */
+    size_t unique_count() const {
+        return std::max(distinct.unique_count(), heavy.unique_count());
+    }
+
+    double frequency(const T& element) const {
+        if (total() == 0) return 0.0;
+        return static_cast<double>(count(element)) / total();
+    }
+
+    using item_type = typename SpaceSaving<T>::item_type;
+
+    std::vector<std::pair<item_type, size_t>> most_common() const { return heavy.most_common(); }
+    std::vector<std::pair<item_type, size_t>> top_n(size_t n) const { return heavy.top_n(n); }
+    std::optional<item_type> mode() const { return heavy.mode(); }
+
+    /**
+     * @brief Tracked heavy hitters with their possible overestimates
+     */
+    std::vector<typename SpaceSaving<T>::entry> heavy_hitters() const { return heavy.entries(); }
+
+    /**
+     * @brief Fold in another sketch; false if it was built with other options
+     */
+    bool merge(const FrequencySketch& other) {
+        if (counts.width() != other.counts.width() || counts.depth() != other.counts.depth() ||
+            distinct.precision() != other.distinct.precision()) {
+            return false;
+        }
+        if (!counts.merge(other.counts) || !distinct.merge(other.distinct)) return false;
+        heavy.merge(other.heavy);
+        return true;
+    }
+
+    void clear() {
+        counts.clear();
+        distinct.clear();
+        heavy.clear();
+    }
+
+private:
+    CountMinSketch<T> counts;
+    HyperLogLog<T> distinct;
+    SpaceSaving<T> heavy;
+};
+
+namespace detail {
+
+// Calls f(p, weight) for the heavy hitters' proportions (weight 1) and
+// once for the even share of each remaining element (weight = their number)
+template<typename T, typename F>
+void for_each_estimated_share(const FrequencySketch<T>& sketch, F&& f) {
+    const double n = static_cast<double>(sketch.total());
+    double head = 0.0;
+    size_t tracked = 0;
+    for (auto const& e : sketch.heavy_hitters()) {
+        double c = std::min(static_cast<double>(sketch.count(e.item)), n - head);
+        if (c <= 0) break;
+        f(c / n, 1.0);
+        head += c;
+        ++tracked;
+    }
+    double rest = n - head;
+    if (rest <= 0) return;
+    double others = std::max(1.0, static_cast<double>(sketch.unique_count()) - static_cast<double>(tracked));
+    f(rest / (n * others), others);
+}
+
+} // namespace detail
+
+/**
+ * @brief Approximate Shannon entropy of a sketched stream
+ */
+template<typename T>
+double shannon_entropy(const FrequencySketch<T>& sketch) {
+    if (sketch.total() == 0) return 0.0;
+    double entropy = 0.0;
+    detail::for_each_estimated_share(sketch, [&](double p, double weight) {
+        if (p > 0) entropy -= weight * p * std::log2(p);
+    });
+    return entropy;
+}
+
+/**
+ * @brief Approximate Simpson's diversity index of a sketched stream
+ */
+template<typename T>
+double simpson_diversity(const FrequencySketch<T>& sketch) {
+    if (sketch.total() <= 1) return 0.0;
+    double sum_squared_proportions = 0.0;
+    detail::for_each_estimated_share(sketch, [&](double p, double weight) {
+        sum_squared_proportions += weight * p * p;
+    });
+    return 1.0 - sum_squared_proportions;
+}
+
+/**
+ * @brief Approximate quantiles in bounded memory (KLL, Karnin, Lang and Liberty)
+ *
+ * Values enter level 0. When a level fills it is sorted and every other
+ * value, starting at random from the first or second, moves up a level
+ * where it stands for twice as many values. Level capacities shrink by a
+ * factor 2/3 from the top level down, so the sketch holds O(k) values
+ * however long the stream, and a quantile's rank is typically off by
+ * about 1.7 / k of count() (under 1% at the default k). Below roughly k
+ * values nothing is compacted and answers are exact.
+ *
+ * Sketches built on different threads merge into a sketch of the
+ * combined stream with the same guarantee.
+ */
+template<typename T>
+class QuantileSketch {
+public:
+    explicit QuantileSketch(size_t k = 200, uint64_t seed = detail::default_sketch_seed)
+        : k(std::max<size_t>(k, 8)), seed(seed) {
+        grow();
+    }
+
+    void add(const T& value) {
+        levels[0].push_back(value);
+        ++n;
+        if (++held >= limit) compress();
+    }
+
+    template<std::ranges::input_range Range>
+    void add_all(Range&& values) {
+        for (auto&& value : values) {
+            add(value);
+        }
+    }
+
+    size_t count() const { return n; }
+    bool empty() const { return n == 0; }
+
+    /**
+     * @brief Number of values the sketch currently keeps
+     */
+    size_t retained() const { return held; }
+
+    /**
+     * @brief Approximate q-quantile, q in [0, 1]; nullopt if empty
+     *
+     * The smallest kept value whose estimated rank reaches q * count(), so
+     * the median of an even number of values is the lower middle one.
+     */
+    std::optional<T> quantile(double q) const {
+        if (n == 0) return std::nullopt;
+        const double target = std::clamp(q, 0.0, 1.0) * static_cast<double>(n);
+        auto weighted = sorted_values();
+        uint64_t cumulative = 0;
+        for (auto const& [value, weight] : weighted) {
+            cumulative += weight;
+            if (static_cast<double>(cumulative) >= target) return value;
+        }
+        return weighted.back().first;
+    }
+
+    std::optional<T> median() const { return quantile(0.5); }
+
+    /**
+     * @brief Approximate fraction of values less than or equal to value
+     */
+    double rank(const T& value) const {
+        if (n == 0) return 0.0;
+        uint64_t below = 0;
+        for (size_t h = 0; h < levels.size(); ++h) {
+            for (auto const& v : levels[h]) {
+                if (!(value < v)) below += uint64_t(1) << h;
+            }
+        }
+        return static_cast<double>(below) / static_cast<double>(n);
+    }
+
+    void merge(const QuantileSketch& other) {
+        while (levels.size() < other.levels.size()) grow();
+        for (size_t h = 0; h < other.levels.size(); ++h) {
+            levels[h].insert(levels[h].end(), other.levels[h].begin(), other.levels[h].end());
+        }
+        n += other.n;
+        held += other.held;
+        while (held >= limit) compress();
+    }
+
+    void clear() {
+        levels.clear();
+        n = held = 0;
+        grow();
+    }
+
+private:
+    size_t capacity(size_t level) const {
+        const auto depth = static_cast<double>(levels.size() - level - 1);
+        return static_cast<size_t>(std::ceil(static_cast<double>(k) * std::pow(2.0 / 3.0, depth))) + 1;
+    }
+
+    void grow() {
+        levels.emplace_back();
+        limit = 0;
+        for (size_t h = 0; h < levels.size(); ++h) limit += capacity(h);
+    }
+
+    // Compact the lowest full levels until the sketch is back under its limit
+    void compress() {
+        for (size_t h = 0; h < levels.size(); ++h) {
+            if (levels[h].size() < capacity(h)) continue;
+            if (h + 1 == levels.size()) grow();
+
+            std::vector<T>& level = levels[h];
+            std::optional<T> odd;
+            if (level.size() % 2 == 1) {
+                odd = std::move(level.back());
+                level.pop_back();
+            }
+            std::sort(level.begin(), level.end());
+            const size_t offset = detail::sketch_hash(++compactions, seed) & 1;
+            for (size_t i = offset; i < level.size(); i += 2) {
+                levels[h + 1].push_back(std::move(level[i]));
+            }
+            held -= level.size() / 2;
+            level.clear();
+            if (odd) level.push_back(std::move(*odd));
+
+            if (held < limit) break;
+        }
+    }
+
+    std::vector<std::pair<T, uint64_t>> sorted_values() const {
+        std::vector<std::pair<T, uint64_t>> weighted;
+        weighted.reserve(held);
+        for (size_t h = 0; h < levels.size(); ++h) {
+            for (auto const& v : levels[h]) weighted.emplace_back(v, uint64_t(1) << h);
+        }
+        std::sort(weighted.begin(), weighted.end(), [](auto const& a, auto const& b) {
+            return a.first < b.first;
+        });
+        return weighted;
+    }
+
+    size_t k;
+    uint64_t seed;
+    uint64_t compactions = 0;
+    size_t n = 0;
+    size_t held = 0;
+    size_t limit = 0;
+    std::vector<std::vector<T>> levels;  // levels[h] values each stand for 2^h
+};
+
+/**
+ * @brief numeric_summary for values that arrive one at a time
+ *
+ * Count, mean, variance, min and max come from RunningStats and are the
+ * same as numeric_summary's; the median comes from a QuantileSketch and
+ * is approximate once more than about k values have been added (for an
+ * even count it is the lower middle value, not the mean of the middle
+ * two). Memory is O(k) and the values are never stored.
+ *
+ * Besides plain values, add() takes the results of the numeric parsers
+ * (anything with val(), such as floating_point) and optionals of them,
+ * skipping failed parses, so a lazy range of parses can go straight
+ * into add_all. Summaries merge, for one accumulator per thread.
+ */
+template<typename T>
+class StreamingSummary {
+public:
+    explicit StreamingSummary(size_t k = 200, uint64_t seed = detail::default_sketch_seed)
+        : quantiles(k, seed) {}
+
+    void add(const T& value) {
+        stats.add(value);
+        quantiles.add(value);
+    }
+
+    template<typename Parsed>
+        requires requires(const Parsed& p) { { p.val() } -> std::convertible_to<T>; }
+    void add(const Parsed& parsed) {
+        add(static_cast<T>(parsed.val()));
+    }
+
+    template<typename Parsed>
+    void add(const std::optional<Parsed>& maybe) {
+        if (maybe) add(*maybe);
+    }
+
+    template<std::ranges::input_range Range>
+    void add_all(Range&& values) {
+        for (auto&& value : values) {
+            add(value);
+        }
+    }
+
+    void merge(const StreamingSummary& other) {
+        stats.merge(other.stats);
+        quantiles.merge(other.quantiles);
+    }
+
+    size_t count() const { return stats.count(); }
+    bool empty() const { return stats.empty(); }
+
+    const RunningStats<T>& moments() const { return stats; }
+
+    std::optional<T> quantile(double q) const { return quantiles.quantile(q); }
+    std::optional<T> median() const { return quantiles.median(); }
+
+    /**
+     * @brief The summary so far; nullopt if nothing was added
+     */
+    std::optional<NumericSummary<T>> summary() const {
+        if (stats.empty()) return std::nullopt;
+
+        NumericSummary<T> result;
+        result.count = stats.count();
+        result.min = stats.min();
+        result.max = stats.max();
+        result.mean = stats.mean();
+        result.variance = stats.variance();
+        result.std_dev = stats.std_dev();
+        result.median = *quantiles.median();
+        return result;
+    }
+
+    void clear() {
+        stats.clear();
+        quantiles.clear();
+    }
+
+private:
+    RunningStats<T> stats;
+    QuantileSketch<T> quantiles;
+};
+
+} // namespace statistics
+} // namespace alga
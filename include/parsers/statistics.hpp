@@ -1,11 +1,13 @@
 #pragma once
 
+#include "parsers/flat_hash_map.hpp"
 #include <unordered_map>
 #include <map>
 #include <vector>
 #include <string>
 #include <algorithm>
 #include <cmath>
+#include <concepts>
 #include <optional>
 #include <numeric>
 
@@ -16,13 +18,48 @@ namespace statistics {
  * @brief Frequency counter for any hashable type
  *
  * Counts occurrences of elements and provides frequency analysis.
+ *
+ * Storage is the map from element to count. The default flat_hash_map
+ * keeps elements and counts in one open-addressed array, so add() is a
+ * hash and usually a single cache line; FrequencyCounter<std::string_view>
+ * copies each distinct token into the map's arena, so views of transient
+ * buffers can be counted. Any map with operator[], find, end, size,
+ * reserve, clear and iteration over (element, count) pairs can be used,
+ * std::unordered_map<T, size_t> included (which does not own string_view
+ * keys).
  */
-template<typename T>
+template<typename T, typename Storage = flat_hash_map<T, size_t>>
 class FrequencyCounter {
+public:
+    using storage_type = Storage;
+
 private:
-    std::unordered_map<T, size_t> counts;
+    Storage counts;
     size_t total_count;
 
+    // Higher count first; equal counts in element order when T has one, so
+    // the ranking does not depend on the storage's iteration order
+    template<typename A, typename B>
+    static bool more_common(const A& a, const B& b) {
+        if (a.second != b.second) return a.second > b.second;
+        if constexpr (std::totally_ordered<T>) {
+            return a.first < b.first;
+        } else {
+            return false;
+        }
+    }
+
+    // Lower count first; equal counts in the same element order as more_common
+    template<typename A, typename B>
+    static bool less_common(const A& a, const B& b) {
+        if (a.second != b.second) return a.second < b.second;
+        if constexpr (std::totally_ordered<T>) {
+            return a.first < b.first;
+        } else {
+            return false;
+        }
+    }
+
 public:
     FrequencyCounter() : total_count(0) {}
 
@@ -34,6 +71,29 @@ public:
         ++total_count;
     }
 
+    /**
+     * @brief Add n occurrences of an element
+     */
+    void add(const T& element, size_t n) {
+        counts[element] += n;
+        total_count += n;
+    }
+
+    /**
+     * @brief Add every count of another counter to this one
+     *
+     * Counters filled independently, say one per thread, merge into the
+     * counter a single pass over all the elements would have produced.
+     */
+    template<typename OtherStorage>
+    void merge(const FrequencyCounter<T, OtherStorage>& other) {
+        counts.reserve(counts.size() + other.unique_count());
+        for (const auto& [element, count] : other.get_counts()) {
+            counts[element] += count;
+        }
+        total_count += other.total();
+    }
+
     /**
      * @brief Add multiple elements
      */
@@ -43,6 +103,13 @@ public:
         }
     }
 
+    /**
+     * @brief Make room for n distinct elements
+     */
+    void reserve(size_t n) {
+        counts.reserve(n);
+    }
+
     /**
      * @brief Get count for a specific element
      */
@@ -79,7 +146,7 @@ public:
     std::vector<std::pair<T, size_t>> most_common() const {
         std::vector<std::pair<T, size_t>> sorted(counts.begin(), counts.end());
         std::sort(sorted.begin(), sorted.end(),
-                  [](const auto& a, const auto& b) { return a.second > b.second; });
+                  [](const auto& a, const auto& b) { return more_common(a, b); });
         return sorted;
     }
 
@@ -87,9 +154,25 @@ public:
      * @brief Get top N most common elements
      */
     std::vector<std::pair<T, size_t>> top_n(size_t n) const {
-        auto all = most_common();
-        if (all.size() <= n) return all;
-        return std::vector<std::pair<T, size_t>>(all.begin(), all.begin() + n);
+        if (n >= counts.size()) return most_common();
+
+        // Bounded heap whose front is the least common of the best n so far,
+        // so U elements cost O(U log n) and only candidates are copied
+        auto cmp = [](const auto& a, const auto& b) { return more_common(a, b); };
+        std::vector<std::pair<T, size_t>> best;
+        best.reserve(n + 1);
+        for (const auto& entry : counts) {
+            if (best.size() < n) {
+                best.emplace_back(entry.first, entry.second);
+                std::push_heap(best.begin(), best.end(), cmp);
+            } else if (n > 0 && more_common(entry, best.front())) {
+                std::pop_heap(best.begin(), best.end(), cmp);
+                best.back() = {entry.first, entry.second};
+                std::push_heap(best.begin(), best.end(), cmp);
+            }
+        }
+        std::sort_heap(best.begin(), best.end(), cmp);
+        return best;
     }
 
     /**
@@ -98,7 +181,7 @@ public:
     std::vector<std::pair<T, size_t>> least_common() const {
         std::vector<std::pair<T, size_t>> sorted(counts.begin(), counts.end());
         std::sort(sorted.begin(), sorted.end(),
-                  [](const auto& a, const auto& b) { return a.second < b.second; });
+                  [](const auto& a, const auto& b) { return less_common(a, b); });
         return sorted;
     }
 
@@ -107,14 +190,17 @@ public:
      */
     std::optional<T> mode() const {
         if (counts.empty()) return std::nullopt;
-        auto common = most_common();
-        return common[0].first;
+        auto best = counts.begin();
+        for (auto it = counts.begin(); it != counts.end(); ++it) {
+            if (more_common(*it, *best)) best = it;
+        }
+        return best->first;
     }
 
     /**
      * @brief Get all counts as a map
      */
-    const std::unordered_map<T, size_t>& get_counts() const {
+    const Storage& get_counts() const {
         return counts;
     }
 
@@ -133,8 +219,8 @@ public:
  * Measures information content / diversity of a distribution.
  * Higher entropy = more diverse / unpredictable.
  */
-template<typename T>
-double shannon_entropy(const FrequencyCounter<T>& counter) {
+template<typename T, typename Storage>
+double shannon_entropy(const FrequencyCounter<T, Storage>& counter) {
     if (counter.total() == 0) return 0.0;
 
     double entropy = 0.0;
@@ -153,8 +239,8 @@ double shannon_entropy(const FrequencyCounter<T>& counter) {
  *
  * Normalizes by the maximum possible entropy for the given number of unique elements.
  */
-template<typename T>
-double normalized_entropy(const FrequencyCounter<T>& counter) {
+template<typename Counter>
+double normalized_entropy(const Counter& counter) {
     if (counter.unique_count() <= 1) return 0.0;
 
     double max_entropy = std::log2(counter.unique_count());
@@ -169,8 +255,8 @@ double normalized_entropy(const FrequencyCounter<T>& counter) {
  * Probability that two randomly selected elements are different.
  * Range: 0 (no diversity) to 1 (maximum diversity).
  */
-template<typename T>
-double simpson_diversity(const FrequencyCounter<T>& counter) {
+template<typename T, typename Storage>
+double simpson_diversity(const FrequencyCounter<T, Storage>& counter) {
     if (counter.total() <= 1) return 0.0;
 
     double sum_squared_proportions = 0.0;
@@ -201,41 +287,102 @@ struct NumericSummary {
 };
 
 /**
- * @brief Calculate summary statistics for numeric data
+ * @brief Single-pass count, mean, variance, min and max
+ *
+ * Uses Welford's update, so the variance does not suffer the cancellation
+ * of a running sum of squares, and holds O(1) state however many values
+ * are added. Accumulators filled on different threads combine with
+ * merge() (Chan et al.) into the accumulator of the concatenated input.
  */
 template<typename T>
-std::optional<NumericSummary<T>> numeric_summary(const std::vector<T>& data) {
-    if (data.empty()) return std::nullopt;
+class RunningStats {
+public:
+    void add(const T& value) {
+        if (n == 0) {
+            lo = hi = value;
+        } else {
+            if (value < lo) lo = value;
+            if (hi < value) hi = value;
+        }
+        ++n;
+        double delta = static_cast<double>(value) - m;
+        m += delta / static_cast<double>(n);
+        m2 += delta * (static_cast<double>(value) - m);
+    }
 
-    NumericSummary<T> summary;
-    summary.count = data.size();
+    void merge(const RunningStats& other) {
+        if (other.n == 0) return;
+        if (n == 0) {
+            *this = other;
+            return;
+        }
+        if (other.lo < lo) lo = other.lo;
+        if (hi < other.hi) hi = other.hi;
+        const double na = static_cast<double>(n);
+        const double nb = static_cast<double>(other.n);
+        const double delta = other.m - m;
+        n += other.n;
+        m += delta * nb / static_cast<double>(n);
+        m2 += other.m2 + delta * delta * na * nb / static_cast<double>(n);
+    }
 
-    // Min and max
-    summary.min = *std::min_element(data.begin(), data.end());
-    summary.max = *std::max_element(data.begin(), data.end());
+    size_t count() const { return n; }
+    bool empty() const { return n == 0; }
+    T min() const { return lo; }
+    T max() const { return hi; }
+    double mean() const { return m; }
+
+    /**
+     * @brief Population variance
+     */
+    double variance() const { return n == 0 ? 0.0 : m2 / static_cast<double>(n); }
+
+    double std_dev() const { return std::sqrt(variance()); }
+
+    void clear() { *this = RunningStats(); }
+
+private:
+    size_t n = 0;
+    T lo{};
+    T hi{};
+    double m = 0.0;
+    double m2 = 0.0;
+};
 
-    // Mean
-    double sum = std::accumulate(data.begin(), data.end(), 0.0);
-    summary.mean = sum / data.size();
+/**
+ * @brief Calculate summary statistics for numeric data
+ *
+ * One pass for the moments and a selection (not a full sort) of a copy
+ * for the median. For values that arrive as a stream, StreamingSummary
+ * in sketches.hpp gives the same summary without holding the values.
+ */
+template<typename T>
+std::optional<NumericSummary<T>> numeric_summary(const std::vector<T>& data) {
+    if (data.empty()) return std::nullopt;
 
-    // Variance and standard deviation
-    double sq_sum = 0.0;
+    RunningStats<T> stats;
     for (const auto& value : data) {
-        double diff = value - summary.mean;
-        sq_sum += diff * diff;
+        stats.add(value);
     }
-    summary.variance = sq_sum / data.size();
-    summary.std_dev = std::sqrt(summary.variance);
 
-    // Median (requires sorted copy)
-    std::vector<T> sorted_data = data;
-    std::sort(sorted_data.begin(), sorted_data.end());
-
-    if (sorted_data.size() % 2 == 0) {
-        size_t mid = sorted_data.size() / 2;
-        summary.median = (sorted_data[mid - 1] + sorted_data[mid]) / 2;
+    NumericSummary<T> summary;
+    summary.count = stats.count();
+    summary.min = stats.min();
+    summary.max = stats.max();
+    summary.mean = stats.mean();
+    summary.variance = stats.variance();
+    summary.std_dev = stats.std_dev();
+
+    // Median: the middle element, or the mean of the middle two
+    std::vector<T> selected = data;
+    const size_t mid = selected.size() / 2;
+    auto middle = selected.begin() + static_cast<std::ptrdiff_t>(mid);
+    std::nth_element(selected.begin(), middle, selected.end());
+    if (selected.size() % 2 == 0) {
+        T lower = *std::max_element(selected.begin(), middle);
+        summary.median = (lower + *middle) / 2;
     } else {
-        summary.median = sorted_data[sorted_data.size() / 2];
+        summary.median = *middle;
     }
 
     return summary;
@@ -247,8 +394,8 @@ std::optional<NumericSummary<T>> numeric_summary(const std::vector<T>& data) {
  * Range: 0 (perfect equality) to 1 (maximum inequality).
  * Useful for analyzing distribution of frequencies.
  */
-template<typename T>
-double gini_coefficient(const FrequencyCounter<T>& counter) {
+template<typename T, typename Storage>
+double gini_coefficient(const FrequencyCounter<T, Storage>& counter) {
     if (counter.total() == 0) return 0.0;
 
     // Get sorted counts
@@ -277,8 +424,8 @@ double gini_coefficient(const FrequencyCounter<T>& counter) {
  * Ratio of unique elements to total elements.
  * Range: 0 to 1, higher = more diverse vocabulary.
  */
-template<typename T>
-double type_token_ratio(const FrequencyCounter<T>& counter) {
+template<typename Counter>
+double type_token_ratio(const Counter& counter) {
     if (counter.total() == 0) return 0.0;
     return static_cast<double>(counter.unique_count()) / counter.total();
 }
@@ -289,8 +436,8 @@ double type_token_ratio(const FrequencyCounter<T>& counter) {
  * Number of elements that appear exactly once.
  * Useful for assessing vocabulary richness.
  */
-template<typename T>
-size_t hapax_legomena_count(const FrequencyCounter<T>& counter) {
+template<typename T, typename Storage>
+size_t hapax_legomena_count(const FrequencyCounter<T, Storage>& counter) {
     size_t hapax_count = 0;
     for (const auto& [element, count] : counter.get_counts()) {
         if (count == 1) {
@@ -305,8 +452,8 @@ size_t hapax_legomena_count(const FrequencyCounter<T>& counter) {
  *
  * Number of elements that appear exactly twice.
  */
-template<typename T>
-size_t dis_legomena_count(const FrequencyCounter<T>& counter) {
+template<typename T, typename Storage>
+size_t dis_legomena_count(const FrequencyCounter<T, Storage>& counter) {
     size_t dis_count = 0;
     for (const auto& [element, count] : counter.get_counts()) {
         if (count == 2) {
@@ -342,8 +489,8 @@ struct DistributionAnalysis {
 /**
  * @brief Comprehensive distribution analysis
  */
-template<typename T>
-DistributionAnalysis<T> analyze_distribution(const FrequencyCounter<T>& counter) {
+template<typename T, typename Storage>
+DistributionAnalysis<T> analyze_distribution(const FrequencyCounter<T, Storage>& counter) {
     DistributionAnalysis<T> analysis;
 
     analysis.total_elements = counter.total();
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "porter2stemmer.hpp"
+#include "stem_cache.hpp"
+#include "thread_pool.hpp"
+#include <span>
+#include <stdexcept>
+
+namespace alga
+{
+    /**
+     * @brief Tuning knobs for stem_batch
+     */
+    struct stem_batch_options
+    {
+        thread_pool* pool = nullptr;        // nullptr: default_thread_pool()
+        stem_cache* cache = nullptr;        // nullptr: stem every word directly
+        size_t parallel_threshold = 8192;   // Smaller batches run on the caller only
+        size_t grain = 1024;                // Words per chunk claimed by a thread
+    };
+
+    /**
+     * @brief Stem every word of a batch into caller-provided output
+     *
+     * out[i] receives the result of make_basic_porter2_stem<Storage>(words[i]),
+     * or nullopt for invalid input; out must have at least words.size()
+     * elements, or std::invalid_argument is thrown. Batches of
+     * parallel_threshold words or more are split across the thread pool in
+     * chunks of grain words.
+     *
+     * With inline_porter2_stem output and reused storage, stemming a batch
+     * performs no allocation at all.
+     *
+     * @return Number of words that were stemmed successfully
+     */
+    template <typename Storage>
+    size_t stem_batch(std::span<const string_view> words,
+                      std::span<optional<basic_porter2_stem<Storage>>> out,
+                      stem_batch_options const& options = {})
+    {
+        if (out.size() < words.size()) {
+            throw std::invalid_argument("stem_batch: output span shorter than input");
+        }
+
+        auto stem_range = [&](size_t begin, size_t end) {
+            size_t stemmed = 0;
+            for (size_t i = begin; i < end; ++i) {
+                out[i] = options.cache
+                    ? make_basic_porter2_stem<Storage>(words[i], *options.cache)
+                    : make_basic_porter2_stem<Storage>(words[i]);
+                stemmed += out[i].has_value();
+            }
+            return stemmed;
+        };
+
+        if (words.size() < options.parallel_threshold) {
+            return stem_range(0, words.size());
+        }
+
+        std::atomic<size_t> stemmed{0};
+        thread_pool& pool = options.pool ? *options.pool : default_thread_pool();
+        pool.parallel_for(words.size(), options.grain, [&](size_t begin, size_t end) {
+            stemmed.fetch_add(stem_range(begin, end), std::memory_order_relaxed);
+        });
+        return stemmed.load();
+    }
+
+    /**
+     * @brief stem_batch into std::string-backed porter2_stem output
+     */
+    inline size_t stem_batch(std::span<const string_view> words,
+                             std::span<optional<porter2_stem>> out,
+                             stem_batch_options const& options = {})
+    {
+        return stem_batch<string>(words, out, options);
+    }
+}
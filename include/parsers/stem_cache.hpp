@@ -0,0 +1,335 @@
+#pragma once
+
+#include "porter2stemmer.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace alga
+{
+    /**
+     * @brief Sharded, thread-safe CLOCK cache of Porter2 stems
+     *
+     * Maps lowercased words to their stems under a fixed byte budget split
+     * evenly across shards. Hits take only the shard's shared lock and mark
+     * the entry referenced with a relaxed atomic store, so concurrent hits
+     * never serialize. Misses are stemmed outside the lock and inserted under
+     * the exclusive lock, evicting entries with the CLOCK second-chance sweep
+     * until the shard is back within budget.
+     *
+     * New entries start unreferenced, so words seen only once are the first
+     * to go and a burst of rare words cannot flush the frequent ones.
+     *
+     * The budget counts key and stem characters plus entry_overhead bytes per
+     * entry for the slot and hash node.
+     */
+    class stem_cache
+    {
+    public:
+        /**
+         * @brief Snapshot of the cache counters
+         */
+        struct stats
+        {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t evictions = 0;
+            size_t entries = 0;
+            size_t bytes = 0;
+
+            double hit_rate() const
+            {
+                uint64_t lookups = hits + misses;
+                return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+            }
+        };
+
+        static constexpr size_t entry_overhead = 64;
+
+        explicit stem_cache(size_t byte_budget = size_t(1) << 20, size_t shard_count = 16)
+            : shards(std::make_unique<shard[]>(shard_count == 0 ? 1 : shard_count))
+            , count(shard_count == 0 ? 1 : shard_count)
+            , budget(byte_budget)
+            , shard_budget(byte_budget / count)
+        {
+        }
+
+        stem_cache(stem_cache const&) = delete;
+        stem_cache& operator=(stem_cache const&) = delete;
+
+        /**
+         * @brief Stem a lowercased word through the cache
+         *
+         * word must be lowercase alphabetic, as produced by
+         * detail::lowercase_for_stemming; only its first
+         * porter2_max_word_length characters are stemmed, as in
+         * porter2stemmer. The stem is written to out, which must hold that
+         * many characters and may alias word.
+         *
+         * @return Length of the stem written to out
+         */
+        size_t stem(string_view word, char* out)
+        {
+            word = word.substr(0, porter2_max_word_length);
+            shard& s = shard_for(word);
+            {
+                std::shared_lock lock(s.mutex);
+                auto it = s.index.find(word);
+                if (it != s.index.end()) {
+                    entry& e = s.slots[it->second];
+                    e.referenced.store(true, std::memory_order_relaxed);
+                    s.hits.fetch_add(1, std::memory_order_relaxed);
+                    string_view cached = e.stem();
+                    std::memmove(out, cached.data(), cached.size());
+                    return cached.size();
+                }
+            }
+
+            s.misses.fetch_add(1, std::memory_order_relaxed);
+            std::memmove(out, word.data(), word.size());
+            char key[porter2_max_word_length];
+            std::memcpy(key, out, word.size());
+            size_t length = porter2stemmer(std::span<char>(out, word.size()));
+            insert(s, string_view(key, word.size()), string_view(out, length));
+            return length;
+        }
+
+        stats statistics() const
+        {
+            stats result;
+            for (size_t i = 0; i < count; ++i) {
+                shard const& s = shards[i];
+                std::shared_lock lock(s.mutex);
+                result.hits += s.hits.load(std::memory_order_relaxed);
+                result.misses += s.misses.load(std::memory_order_relaxed);
+                result.evictions += s.evictions.load(std::memory_order_relaxed);
+                result.entries += s.index.size();
+                result.bytes += s.bytes;
+            }
+            return result;
+        }
+
+        /**
+         * @brief Drop every entry and zero the counters
+         */
+        void clear()
+        {
+            for (size_t i = 0; i < count; ++i) {
+                shard& s = shards[i];
+                std::unique_lock lock(s.mutex);
+                s.index.clear();
+                s.slots.clear();
+                s.free_slots.clear();
+                s.hand = 0;
+                s.bytes = 0;
+                s.hits.store(0, std::memory_order_relaxed);
+                s.misses.store(0, std::memory_order_relaxed);
+                s.evictions.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        size_t byte_budget() const { return budget; }
+        size_t shard_count() const { return count; }
+
+    private:
+        struct entry
+        {
+            string text;  // Key followed by stem; index keys view into it
+            uint8_t key_size = 0;
+            std::atomic<bool> referenced{false};
+            bool live = false;
+
+            string_view key() const { return string_view(text.data(), key_size); }
+            string_view stem() const { return string_view(text).substr(key_size); }
+            size_t cost() const { return text.size() + entry_overhead; }
+        };
+
+        struct alignas(64) shard
+        {
+            mutable std::shared_mutex mutex;
+            std::deque<entry> slots;  // Stable addresses for the index keys
+            std::vector<uint32_t> free_slots;
+            std::unordered_map<string_view, uint32_t> index;
+            size_t hand = 0;
+            size_t bytes = 0;
+            std::atomic<uint64_t> hits{0};
+            std::atomic<uint64_t> misses{0};
+            std::atomic<uint64_t> evictions{0};
+        };
+
+        shard& shard_for(string_view word)
+        {
+            // Use the high bits so shard choice is independent of the index buckets
+            uint64_t h = std::hash<string_view>{}(word);
+            h *= 0x9e3779b97f4a7c15ULL;
+            return shards[(h >> 32) % count];
+        }
+
+        void insert(shard& s, string_view key, string_view stemmed)
+        {
+            size_t cost = key.size() + stemmed.size() + entry_overhead;
+            if (cost > shard_budget) {
+                return;
+            }
+
+            std::unique_lock lock(s.mutex);
+            if (s.index.contains(key)) {
+                return;
+            }
+
+            while (s.bytes + cost > shard_budget) {
+                evict_one(s);
+            }
+
+            uint32_t slot;
+            if (!s.free_slots.empty()) {
+                slot = s.free_slots.back();
+                s.free_slots.pop_back();
+            } else {
+                slot = static_cast<uint32_t>(s.slots.size());
+                s.slots.emplace_back();
+            }
+
+            entry& e = s.slots[slot];
+            e.text.assign(key);
+            e.text.append(stemmed);
+            e.key_size = static_cast<uint8_t>(key.size());
+            e.referenced.store(false, std::memory_order_relaxed);
+            e.live = true;
+            s.index.emplace(e.key(), slot);
+            s.bytes += e.cost();
+        }
+
+        // Caller holds the exclusive lock and s.bytes > 0
+        void evict_one(shard& s)
+        {
+            for (;;) {
+                if (s.hand >= s.slots.size()) {
+                    s.hand = 0;
+                }
+                entry& e = s.slots[s.hand];
+                size_t slot = s.hand++;
+
+                if (!e.live || e.referenced.exchange(false, std::memory_order_relaxed)) {
+                    continue;
+                }
+
+                s.index.erase(e.key());
+                s.bytes -= e.cost();
+                e.text.clear();
+                e.live = false;
+                s.free_slots.push_back(static_cast<uint32_t>(slot));
+                s.evictions.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+
+        std::unique_ptr<shard[]> shards;
+        size_t count;
+        size_t budget;
+        size_t shard_budget;
+    };
+
+    /**
+     * @brief Process-wide stem cache used by cached_porter2_stemmer by default
+     */
+    inline stem_cache& global_stem_cache()
+    {
+        static stem_cache cache;
+        return cache;
+    }
+
+    namespace detail
+    {
+        template <typename Storage>
+        basic_porter2_stem<Storage> stem_lowercase(string_view word, stem_cache& cache)
+        {
+            char buffer[porter2_max_word_length];
+            size_t length = cache.stem(word.substr(0, porter2_max_word_length), buffer);
+            return basic_porter2_stem<Storage>(*make_basic_lc_alpha<Storage>(string_view(buffer, length)));
+        }
+    }
+
+    /**
+     * @brief make_basic_porter2_stem that looks the stem up in cache first
+     *
+     * Validation and lowercasing still run on every call; only the stemming
+     * itself is memoized.
+     */
+    template <typename Storage>
+    optional<basic_porter2_stem<Storage>> make_basic_porter2_stem(string_view input, stem_cache& cache)
+    {
+        char buffer[porter2_max_word_length];
+        auto head = detail::lowercase_for_stemming(input, buffer);
+        if (!head) {
+            return std::nullopt;
+        }
+
+        size_t length = cache.stem(string_view(buffer, *head), buffer);
+        return basic_porter2_stem<Storage>(*make_basic_lc_alpha<Storage>(string_view(buffer, length)));
+    }
+
+    inline optional<porter2_stem> make_porter2_stem(string_view input, stem_cache& cache)
+    {
+        return make_basic_porter2_stem<string>(input, cache);
+    }
+
+    /**
+     * @brief Porter2 stemmer that memoizes through a stem_cache
+     *
+     * Drop-in replacement for basic_porter2_stemmer. Uses global_stem_cache()
+     * unless constructed with a cache of its own.
+     */
+    template <typename Storage>
+    struct basic_cached_porter2_stemmer
+    {
+        using input_type = string_view;
+        using output_type = basic_porter2_stem<Storage>;
+
+        stem_cache* cache = &global_stem_cache();
+
+        basic_cached_porter2_stemmer() = default;
+        explicit basic_cached_porter2_stemmer(stem_cache& c) : cache(&c) {}
+
+        optional<output_type> operator()(string_view input) const
+        {
+            return make_basic_porter2_stem<Storage>(input, *cache);
+        }
+
+        template <typename S>
+        optional<output_type> operator()(basic_lc_alpha<S> const& input) const
+        {
+            return detail::stem_lowercase<Storage>(input.view(), *cache);
+        }
+
+        template<typename Iterator>
+        pair<Iterator, optional<output_type>> parse(Iterator begin, Iterator end) const
+        {
+            string word;
+            Iterator current = begin;
+
+            while (current != end && std::isalpha(*current)) {
+                word += std::tolower(*current);
+                ++current;
+            }
+
+            if (word.empty()) {
+                return {current, std::nullopt};
+            }
+
+            return {current, detail::stem_lowercase<Storage>(word, *cache)};
+        }
+    };
+
+    using cached_porter2_stemmer = basic_cached_porter2_stemmer<string>;
+    using cached_inline_porter2_stemmer = basic_cached_porter2_stemmer<inline_string<24>>;
+}
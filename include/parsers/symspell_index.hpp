@@ -0,0 +1,407 @@
+#pragma once
+
+#include "parsers/hash_mix.hpp"
+#include "parsers/similarity.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace alga {
+namespace similarity {
+
+namespace detail {
+
+// n as a 32-bit table field, or std::length_error naming what overflowed
+inline uint32_t checked_u32(size_t n, char const* what) {
+    if (n > std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error(std::string("symspell_index: ") + what + " exceed the 32-bit range");
+    }
+    return static_cast<uint32_t>(n);
+}
+
+} // namespace detail
+
+/**
+ * @brief Edit distance used to verify symspell_index candidates
+ */
+enum class edit_metric {
+    levenshtein,
+    damerau_levenshtein  // Optimal string alignment, as damerau_levenshtein_distance
+};
+
+/**
+ * @brief Symmetric-delete (SymSpell) index over a dictionary
+ *
+ * Every string obtainable from a dictionary word by deleting up to
+ * max_distance characters is hashed into a flat open-addressing table of
+ * posting lists. Two words within edit distance k share a string reachable
+ * from each by at most k deletions, so a lookup only generates the
+ * query's own deletions, probes the table for each, and verifies the
+ * handful of candidates with the bounded distance. This holds for both
+ * Levenshtein and optimal string alignment distance, so one index serves
+ * both.
+ *
+ * Only 64-bit hashes of the deletions are stored, so the table is a few
+ * flat arrays that save() writes and load() reads back without rebuilding.
+ * A hash collision only adds a candidate that verification rejects.
+ */
+class symspell_index {
+public:
+    /**
+     * @brief Dictionary word found by a query
+     */
+    struct match {
+        size_t index;     // Position of the word in dictionary order
+        size_t distance;  // Its distance to the query
+
+        friend bool operator==(match const&, match const&) = default;
+    };
+
+    symspell_index() = default;
+
+    /**
+     * @brief Index dictionary for lookups up to max_distance edits
+     *
+     * Duplicate words keep their first position. Build cost and memory grow
+     * with the number of deletions, roughly len^k / k! per word.
+     *
+     * Word ids, word bytes and posting entries are stored in 32 bits; a
+     * dictionary exceeding any of them throws std::length_error.
+     */
+    explicit symspell_index(std::vector<std::string> const& dictionary, size_t max_distance = 2)
+        : max_edits(static_cast<uint32_t>(max_distance)) {
+        std::unordered_set<std::string_view> seen;
+        std::vector<std::pair<uint64_t, uint32_t>> entries;
+        std::vector<std::string> deletes;
+
+        word_offsets.push_back(0);
+        for (auto const& word : dictionary) {
+            if (!seen.insert(word).second) {
+                continue;
+            }
+            uint32_t id = detail::checked_u32(word_offsets.size() - 1, "distinct words");
+            word_blob += word;
+            word_offsets.push_back(detail::checked_u32(word_blob.size(), "dictionary bytes"));
+
+            generate_deletes(word, max_distance, deletes);
+            for (auto const& d : deletes) {
+                entries.emplace_back(alga::detail::hash_bytes(d), id);
+            }
+        }
+
+        // Group by hash into CSR posting lists, ids ascending within a list
+        std::sort(entries.begin(), entries.end());
+        entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+        detail::checked_u32(entries.size(), "posting entries");  // Bounds every begin and count below
+
+        size_t groups = 0;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            groups += i == 0 || entries[i].first != entries[i - 1].first;
+        }
+        size_t capacity = 16;
+        while (capacity < groups * 2) capacity *= 2;
+        slots.assign(capacity, slot{});
+        postings.reserve(entries.size());
+
+        for (size_t i = 0; i < entries.size();) {
+            size_t j = i;
+            while (j < entries.size() && entries[j].first == entries[i].first) {
+                postings.push_back(entries[j].second);
+                ++j;
+            }
+            slot& s = slots[probe_for_insert(entries[i].first)];
+            s.hash = entries[i].first;
+            s.begin = static_cast<uint32_t>(postings.size() - (j - i));
+            s.count = static_cast<uint32_t>(j - i);
+            i = j;
+        }
+    }
+
+    size_t size() const { return word_offsets.empty() ? 0 : word_offsets.size() - 1; }
+    bool empty() const { return size() == 0; }
+
+    /**
+     * @brief Largest distance the index answers exactly
+     */
+    size_t max_distance() const { return max_edits; }
+
+    std::string_view operator[](size_t index) const {
+        return std::string_view(word_blob).substr(word_offsets[index], word_offsets[index + 1] - word_offsets[index]);
+    }
+
+    /**
+     * @brief All words within max_distance of query, closest first
+     *
+     * max_distance is capped at the distance the index was built for. Equal
+     * distances are ordered by dictionary position.
+     */
+    std::vector<match> within(std::string_view query, size_t max_distance,
+                              edit_metric metric = edit_metric::levenshtein) const {
+        std::vector<match> result;
+        max_distance = std::min<size_t>(max_distance, max_edits);
+        for (uint32_t id : candidates(query, max_distance)) {
+            if (auto d = verify(query, (*this)[id], max_distance, metric)) {
+                result.push_back(match{id, *d});
+            }
+        }
+        std::sort(result.begin(), result.end(), [](match const& a, match const& b) {
+            return a.distance != b.distance ? a.distance < b.distance : a.index < b.index;
+        });
+        return result;
+    }
+
+    /**
+     * @brief Closest word within max_distance, earliest in the dictionary on ties
+     */
+    std::optional<match> closest(std::string_view query, size_t max_distance,
+                                 edit_metric metric = edit_metric::levenshtein) const {
+        std::optional<match> best;
+        max_distance = std::min<size_t>(max_distance, max_edits);
+        for (uint32_t id : candidates(query, max_distance)) {
+            // Candidates come in ascending order, so only strictly closer ones count
+            if (best && best->distance == 0) break;
+            size_t bound = best ? best->distance - 1 : max_distance;
+            if (auto d = verify(query, (*this)[id], bound, metric)) {
+                best = match{id, *d};
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief Write the index in a binary format that load() reads back
+     *
+     * Integers are written in host byte order.
+     */
+    bool save(std::ostream& out) const {
+        write_pod(out, magic);
+        write_pod(out, max_edits);
+        write_vector(out, word_offsets);
+        write_pod(out, static_cast<uint64_t>(word_blob.size()));
+        out.write(word_blob.data(), static_cast<std::streamsize>(word_blob.size()));
+        write_vector(out, slots);
+        write_vector(out, postings);
+        return static_cast<bool>(out);
+    }
+
+    bool save(std::string const& path) const {
+        std::ofstream out(path, std::ios::binary);
+        return out && save(out);
+    }
+
+    /**
+     * @brief Read an index written by save(), nullopt if malformed
+     */
+    static std::optional<symspell_index> load(std::istream& in) {
+        symspell_index index;
+        uint64_t file_magic = 0;
+        uint64_t blob_size = 0;
+        if (!read_pod(in, file_magic) || file_magic != magic ||
+            !read_pod(in, index.max_edits) ||
+            !read_vector(in, index.word_offsets) ||
+            !read_pod(in, blob_size) ||
+            index.word_offsets.empty() || blob_size != index.word_offsets.back()) {
+            return std::nullopt;
+        }
+        if (!read_bytes(in, index.word_blob, blob_size) ||
+            !read_vector(in, index.slots) || !read_vector(in, index.postings)) {
+            return std::nullopt;
+        }
+        if (!index.consistent()) {
+            return std::nullopt;
+        }
+        return index;
+    }
+
+    static std::optional<symspell_index> load(std::string const& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            return std::nullopt;
+        }
+        return load(in);
+    }
+
+private:
+    struct slot {
+        uint64_t hash = 0;
+        uint32_t begin = 0;
+        uint32_t count = 0;  // 0 marks an empty slot
+    };
+
+    static constexpr uint64_t magic = 0x314d5953'41474c41ULL;  // "ALGASYM1"
+
+    uint32_t max_edits = 0;
+    std::string word_blob;               // All words back to back
+    std::vector<uint32_t> word_offsets;  // Word i is [offsets[i], offsets[i + 1])
+    std::vector<slot> slots;             // Open addressing, power-of-two size
+    std::vector<uint32_t> postings;      // Word ids per slot
+
+    // The word itself plus every distinct string left after deleting up to
+    // max_distance of its characters
+    static void generate_deletes(std::string_view word, size_t max_distance, std::vector<std::string>& out) {
+        out.clear();
+        out.emplace_back(word);
+        size_t level_begin = 0;
+        for (size_t depth = 0; depth < max_distance; ++depth) {
+            size_t level_end = out.size();
+            for (size_t i = level_begin; i < level_end; ++i) {
+                for (size_t pos = 0; pos < out[i].size(); ++pos) {
+                    std::string shorter = out[i];
+                    shorter.erase(pos, 1);
+                    out.push_back(std::move(shorter));
+                }
+            }
+            // Deduplicate the new level only; earlier levels are shorter
+            std::sort(out.begin() + static_cast<std::ptrdiff_t>(level_end), out.end());
+            out.erase(std::unique(out.begin() + static_cast<std::ptrdiff_t>(level_end), out.end()), out.end());
+            level_begin = level_end;
+        }
+    }
+
+    size_t probe_for_insert(uint64_t h) const {
+        size_t mask = slots.size() - 1;
+        size_t i = static_cast<size_t>(h) & mask;
+        while (slots[i].count != 0) i = (i + 1) & mask;
+        return i;
+    }
+
+    slot const* find(uint64_t h) const {
+        if (slots.empty()) return nullptr;
+        size_t mask = slots.size() - 1;
+        for (size_t i = static_cast<size_t>(h) & mask; slots[i].count != 0; i = (i + 1) & mask) {
+            if (slots[i].hash == h) return &slots[i];
+        }
+        return nullptr;
+    }
+
+    // Distinct ids of words sharing a deletion with query, ascending
+    std::vector<uint32_t> candidates(std::string_view query, size_t max_distance) const {
+        std::vector<uint32_t> ids;
+        std::vector<std::string> deletes;
+        generate_deletes(query, max_distance, deletes);
+        for (auto const& d : deletes) {
+            if (slot const* s = find(alga::detail::hash_bytes(d))) {
+                ids.insert(ids.end(), postings.begin() + s->begin, postings.begin() + s->begin + s->count);
+            }
+        }
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        return ids;
+    }
+
+    static std::optional<size_t> verify(std::string_view query, std::string_view word, size_t k, edit_metric metric) {
+        return metric == edit_metric::levenshtein ? levenshtein_distance_bounded(query, word, k)
+                                                  : damerau_levenshtein_distance_bounded(query, word, k);
+    }
+
+    bool consistent() const {
+        if (word_offsets.empty() || word_offsets.front() != 0 || word_offsets.back() != word_blob.size() ||
+            !std::is_sorted(word_offsets.begin(), word_offsets.end())) {
+            return false;
+        }
+        if (slots.empty() || (slots.size() & (slots.size() - 1)) != 0) {
+            return false;
+        }
+        // find() stops at an empty slot, so there must be one, and every
+        // occupied slot must be the first match on its own probe chain
+        size_t words = size();
+        bool has_empty = false;
+        for (size_t i = 0; i < slots.size(); ++i) {
+            slot const& s = slots[i];
+            if (s.count == 0) {
+                has_empty = true;
+                continue;
+            }
+            if (static_cast<size_t>(s.begin) + s.count > postings.size()) return false;
+        }
+        if (!has_empty) return false;
+        for (auto const& s : slots) {
+            if (s.count != 0 && find(s.hash) != &s) return false;
+        }
+        return std::all_of(postings.begin(), postings.end(), [words](uint32_t id) { return id < words; });
+    }
+
+    template<typename T>
+    static void write_pod(std::ostream& out, T const& value) {
+        out.write(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    static bool read_pod(std::istream& in, T& value) {
+        in.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return static_cast<bool>(in);
+    }
+
+    template<typename T>
+    static void write_vector(std::ostream& out, std::vector<T> const& values) {
+        write_pod(out, static_cast<uint64_t>(values.size()));
+        out.write(reinterpret_cast<char const*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+    }
+
+    // Bytes left in a seekable stream; nullopt if the stream cannot tell
+    static std::optional<uint64_t> remaining_bytes(std::istream& in) {
+        auto here = in.tellg();
+        if (here == std::istream::pos_type(-1)) return std::nullopt;
+        in.seekg(0, std::ios::end);
+        auto end = in.tellg();
+        in.seekg(here);
+        if (!in || end == std::istream::pos_type(-1)) {
+            in.clear();
+            in.seekg(here);
+            return std::nullopt;
+        }
+        return static_cast<uint64_t>(end - here);
+    }
+
+    static bool read_bytes(std::istream& in, std::string& bytes, uint64_t size) {
+        if (auto left = remaining_bytes(in); left && size > *left) {
+            return false;
+        }
+        constexpr uint64_t chunk = uint64_t(1) << 20;
+        bytes.clear();
+        for (uint64_t done = 0; done < size;) {
+            uint64_t n = std::min(chunk, size - done);
+            bytes.resize(static_cast<size_t>(done + n));
+            in.read(bytes.data() + done, static_cast<std::streamsize>(n));
+            if (!in) {
+                return false;
+            }
+            done += n;
+        }
+        return true;
+    }
+
+    template<typename T>
+    static bool read_vector(std::istream& in, std::vector<T>& values) {
+        uint64_t count = 0;
+        if (!read_pod(in, count)) {
+            return false;
+        }
+        // Grow chunk by chunk so a corrupt count fails on a short read
+        // instead of allocating whatever it claims
+        constexpr uint64_t chunk = uint64_t(1) << 16;
+        values.clear();
+        for (uint64_t done = 0; done < count;) {
+            uint64_t n = std::min(chunk, count - done);
+            values.resize(static_cast<size_t>(done + n));
+            in.read(reinterpret_cast<char*>(values.data() + done), static_cast<std::streamsize>(n * sizeof(T)));
+            if (!in) {
+                return false;
+            }
+            done += n;
+        }
+        return true;
+    }
+};
+
+} // namespace similarity
+} // namespace alga
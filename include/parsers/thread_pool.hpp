@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace alga
+{
+    /**
+     * @brief Fixed set of worker threads for data-parallel loops
+     *
+     * parallel_for splits [0, n) into chunks that the calling thread and the
+     * workers claim from a shared atomic counter, so fast threads keep taking
+     * chunks until none are left and uneven chunks balance themselves. The
+     * caller always takes part and returns once every chunk has run, which
+     * also makes nested parallel_for calls from inside a body safe.
+     */
+    class thread_pool
+    {
+    public:
+        /**
+         * @param workers Number of background threads; the caller is extra
+         */
+        explicit thread_pool(size_t workers = default_workers())
+        {
+            threads.reserve(workers);
+            for (size_t i = 0; i < workers; ++i) {
+                threads.emplace_back([this]() { run(); });
+            }
+        }
+
+        thread_pool(thread_pool const&) = delete;
+        thread_pool& operator=(thread_pool const&) = delete;
+
+        ~thread_pool()
+        {
+            {
+                std::lock_guard lock(mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (auto& t : threads) {
+                t.join();
+            }
+        }
+
+        /**
+         * @brief Threads that run a parallel_for, counting the caller
+         */
+        size_t concurrency() const { return threads.size() + 1; }
+
+        /**
+         * @brief Call body(begin, end) over [0, n) in chunks of at most grain
+         *
+         * Blocks until all chunks have run. Chunks may run in any order and on
+         * any thread, so body must only write to state owned by its range.
+         *
+         * If body throws, chunks not yet started are skipped, and once the
+         * running ones have finished the first exception is rethrown here.
+         */
+        template <typename F>
+        void parallel_for(size_t n, size_t grain, F&& body)
+        {
+            if (n == 0) {
+                return;
+            }
+            grain = std::max<size_t>(grain, 1);
+            size_t chunks = (n + grain - 1) / grain;
+            if (chunks == 1 || threads.empty()) {
+                body(size_t(0), n);
+                return;
+            }
+
+            auto job = std::make_shared<loop>();
+            job->n = n;
+            job->grain = grain;
+            job->chunks = chunks;
+            job->body = [&body](size_t begin, size_t end) { body(begin, end); };
+
+            size_t helpers = std::min(threads.size(), chunks - 1);
+            {
+                std::lock_guard lock(mutex);
+                for (size_t i = 0; i < helpers; ++i) {
+                    tasks.push_back(job);
+                }
+            }
+            if (helpers == 1) {
+                wake.notify_one();
+            } else {
+                wake.notify_all();
+            }
+
+            job->work();
+
+            // Helpers that have not started yet find no chunks left and
+            // never touch body, so only completed chunks need waiting for
+            size_t done = job->done.load(std::memory_order_acquire);
+            while (done < chunks) {
+                job->done.wait(done, std::memory_order_acquire);
+                done = job->done.load(std::memory_order_acquire);
+            }
+            if (job->error) {
+                std::rethrow_exception(job->error);
+            }
+        }
+
+    private:
+        struct loop
+        {
+            size_t n = 0;
+            size_t grain = 1;
+            size_t chunks = 0;
+            std::function<void(size_t, size_t)> body;
+            std::atomic<size_t> next{0};
+            std::atomic<size_t> done{0};
+            std::atomic<bool> failed{false};
+            std::exception_ptr error;  // First exception from body, set once
+
+            void work()
+            {
+                for (;;) {
+                    size_t chunk = next.fetch_add(1, std::memory_order_relaxed);
+                    if (chunk >= chunks) {
+                        return;
+                    }
+                    // A chunk counts as done even if it threw or was skipped,
+                    // so the caller always stops waiting
+                    if (!failed.load(std::memory_order_relaxed)) {
+                        size_t begin = chunk * grain;
+                        try {
+                            body(begin, std::min(n, begin + grain));
+                        } catch (...) {
+                            if (!failed.exchange(true, std::memory_order_relaxed)) {
+                                error = std::current_exception();
+                            }
+                        }
+                    }
+                    if (done.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks) {
+                        done.notify_all();
+                    }
+                }
+            }
+        };
+
+        static size_t default_workers()
+        {
+            unsigned hw = std::thread::hardware_concurrency();
+            return hw > 1 ? hw - 1 : 0;
+        }
+
+        void run()
+        {
+            for (;;) {
+                std::shared_ptr<loop> job;
+                {
+                    std::unique_lock lock(mutex);
+                    wake.wait(lock, [this]() { return stopping || !tasks.empty(); });
+                    if (tasks.empty()) {
+                        return;
+                    }
+                    job = std::move(tasks.front());
+                    tasks.pop_front();
+                }
+                job->work();
+            }
+        }
+
+        std::vector<std::thread> threads;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::deque<std::shared_ptr<loop>> tasks;
+        bool stopping = false;
+    };
+
+    /**
+     * @brief Process-wide pool sized to the hardware, created on first use
+     */
+    inline thread_pool& default_thread_pool()
+    {
+        static thread_pool pool;
+        return pool;
+    }
+}
@@ -314,6 +314,24 @@ TEST_F(NgramStemmerTest, NgramValueSemantics) {
     // This is a known issue in the ngram_stemmer design that needs template constraints
 }
 
+TEST_F(NgramStemmerTest, InlineStorageNgram) {
+    inline_porter2_stemmer inline_stemmer;
+    auto run = *inline_stemmer("running");
+    auto walk = *inline_stemmer("walking");
+    auto jump = *inline_stemmer("jumping");
+    
+    EXPECT_TRUE(run.lc().str().is_inline());
+    EXPECT_EQ(run.view(), running_stem.view());
+    
+    auto bigram = make_bigram(run, walk);
+    auto trigram = bigram * jump;
+    EXPECT_EQ(std::string(trigram), "run walk jump");
+    EXPECT_EQ(trigram, make_trigram(run, walk, jump));
+    
+    inline_trigram_stem copied = trigram;
+    EXPECT_EQ(copied[2], jump);
+}
+
 // ============================================================================
 // Monadic Combinators Tests - SKIP FOR NOW DUE TO COMPILATION ISSUES
 // ============================================================================
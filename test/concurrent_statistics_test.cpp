@@ -0,0 +1,134 @@
+/**
+ * @file concurrent_statistics_test.cpp
+ * @brief Tests for parallel and concurrent frequency counting
+ */
+
+#include <gtest/gtest.h>
+#include "parsers/concurrent_statistics.hpp"
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace alga;
+using namespace alga::statistics;
+
+namespace {
+    // Zipf-like tokens, so there are many ties among the rare ones
+    std::vector<std::string> random_tokens(size_t count, uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<double> u(0.0, 1.0);
+        std::vector<std::string> tokens;
+        tokens.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            auto rank = static_cast<size_t>(1.0 / (u(gen) + 1e-3));
+            tokens.push_back("w" + std::to_string(rank));
+        }
+        return tokens;
+    }
+}
+
+TEST(FrequencyCounterMergeTest, MergeEqualsSinglePass) {
+    auto tokens = random_tokens(5000, 1);
+    FrequencyCounter<std::string> whole;
+    FrequencyCounter<std::string> left;
+    FrequencyCounter<std::string, std::unordered_map<std::string, size_t>> right;
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        whole.add(tokens[i]);
+        if (i % 3 == 0) {
+            left.add(tokens[i]);
+        } else {
+            right.add(tokens[i]);
+        }
+    }
+    left.merge(right);
+    EXPECT_EQ(left.total(), whole.total());
+    EXPECT_EQ(left.most_common(), whole.most_common());
+    EXPECT_EQ(left.least_common(), whole.least_common());
+}
+
+TEST(ParallelFrequencyCountTest, MatchesSequentialCounter) {
+    auto tokens = random_tokens(100000, 2);
+    auto sequential = make_frequency_counter(tokens);
+
+    thread_pool pool(3);
+    auto parallel = parallel_frequency_count(tokens, {.pool = &pool, .parallel_threshold = 1});
+    EXPECT_EQ(parallel.total(), sequential.total());
+    EXPECT_EQ(parallel.unique_count(), sequential.unique_count());
+    EXPECT_EQ(parallel.most_common(), sequential.most_common());
+    EXPECT_EQ(parallel.top_n(25), sequential.top_n(25));
+
+    auto small = parallel_frequency_count(std::vector<int>{3, 1, 3});
+    EXPECT_EQ(small.count(3), 2UL);
+}
+
+TEST(ParallelFrequencyCountTest, StringViewTokens) {
+    auto tokens = random_tokens(20000, 3);
+    std::vector<std::string_view> views(tokens.begin(), tokens.end());
+    thread_pool pool(2);
+    auto parallel = parallel_frequency_count(views, {.pool = &pool, .parallel_threshold = 1});
+    auto sequential = make_frequency_counter(tokens);
+    ASSERT_EQ(parallel.unique_count(), sequential.unique_count());
+    for (auto const& [token, count] : sequential.get_counts()) {
+        EXPECT_EQ(parallel.count(token), count);
+    }
+}
+
+TEST(ParallelFrequencyCountTest, EmptyRangeWithZeroThreshold) {
+    auto empty = parallel_frequency_count(std::vector<int>{}, {.parallel_threshold = 0});
+    EXPECT_EQ(empty.total(), 0UL);
+    EXPECT_EQ(empty.unique_count(), 0UL);
+}
+
+TEST(ConcurrentFrequencyCounterTest, ThreadsAddingAtOnce) {
+    auto tokens = random_tokens(80000, 4);
+    ConcurrentFrequencyCounter<std::string> live(8);
+
+    std::vector<std::thread> threads;
+    const size_t workers = 4;
+    for (size_t t = 0; t < workers; ++t) {
+        threads.emplace_back([&, t]() {
+            for (size_t i = t; i < tokens.size(); i += workers) live.add(tokens[i]);
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    auto sequential = make_frequency_counter(tokens);
+    EXPECT_EQ(live.total(), tokens.size());
+    EXPECT_EQ(live.unique_count(), sequential.unique_count());
+    EXPECT_EQ(live.count("w1"), sequential.count("w1"));
+    EXPECT_EQ(live.most_common(), sequential.most_common());
+    EXPECT_EQ(live.top_n(10), sequential.top_n(10));
+    EXPECT_DOUBLE_EQ(shannon_entropy(live.snapshot()), shannon_entropy(sequential));
+
+    live.clear();
+    EXPECT_EQ(live.total(), 0UL);
+}
+
+TEST(ConcurrentFrequencyCounterTest, MergesThreadLocalCounters) {
+    ConcurrentFrequencyCounter<int> live(3);  // Rounded up to 4 shards
+    FrequencyCounter<int> local;
+    for (int i = 0; i < 100; ++i) local.add(i % 7);
+    live.merge(local);
+    live.add(0, 5);
+    EXPECT_EQ(live.count(0), 20UL);
+    EXPECT_EQ(live.total(), 105UL);
+    EXPECT_EQ(live.top_n(1)[0].first, 0);
+}
+
+TEST(ConcurrentFrequencyCounterTest, StringViewResultsOutliveSnapshot) {
+    ConcurrentFrequencyCounter<std::string_view> live(4);
+    std::string buffer;
+    for (auto w : {"alpha", "beta", "alpha", "a-token-longer-than-small-string-buffers"}) {
+        buffer = w;
+        live.add(buffer);
+    }
+    auto top = live.top_n(2);
+    ASSERT_EQ(top.size(), 2UL);
+    EXPECT_EQ(top[0], (std::pair<std::string, size_t>{"alpha", 2}));
+    auto all = live.most_common();
+    ASSERT_EQ(all.size(), 3UL);
+    EXPECT_EQ(all[1].first, "a-token-longer-than-small-string-buffers");
+}
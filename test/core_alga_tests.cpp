@@ -9,9 +9,14 @@
 #include "parsers/lc_alpha.hpp"
 #include "parsers/porter2stemmer.hpp"
 #include "parsers/algebraic_operators.hpp"
+#include "porter2_reference.hpp"
 #include <string>
 #include <optional>
 #include <vector>
+#include <random>
+#include <span>
+#include <algorithm>
+#include <limits>
 
 using namespace alga;
 
@@ -235,6 +240,139 @@ TEST_F(LcAlphaTest, ValueSemantics) {
     EXPECT_NO_THROW(original.empty());
 }
 
+// Test vectorized validation across SIMD block boundaries
+TEST_F(LcAlphaTest, LongMixedCaseLowercased) {
+    std::string input;
+    std::string expected;
+    for (size_t i = 0; i < 100; ++i) {
+        char c = static_cast<char>('a' + i % 26);
+        input += (i % 3 == 0) ? static_cast<char>(c - 'a' + 'A') : c;
+        expected += c;
+    }
+    
+    auto result = make_lc_alpha(input);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->str(), expected);
+}
+
+TEST_F(LcAlphaTest, InvalidCharacterAtAnyPosition) {
+    for (size_t len : {1UL, 15UL, 16UL, 17UL, 31UL, 32UL, 33UL, 70UL}) {
+        for (size_t pos = 0; pos < len; ++pos) {
+            for (char bad : {'@', '[', '`', '{', '1', ' ', '\xC3', '\xE1'}) {
+                std::string input(len, 'Q');
+                input[pos] = bad;
+                EXPECT_FALSE(make_lc_alpha(input).has_value())
+                    << "len=" << len << " pos=" << pos << " char=" << static_cast<int>(bad);
+            }
+        }
+    }
+}
+
+TEST_F(LcAlphaTest, AlphabetBoundaries) {
+    auto result = make_lc_alpha("AZazAZazAZazAZazAZazAZazAZazAZazAZaz");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->str(), "azazazazazazazazazazazazazazazazazaz");
+}
+
+TEST_F(LcAlphaTest, BatchValidation) {
+    std::string buffer = "Hello WORLD 42 Tokens";
+    std::vector<std::pair<size_t, size_t>> tokens = {
+        {0, 5}, {6, 5}, {12, 2}, {15, 6}, {20, 10}
+    };
+    
+    lc_alpha_arena arena;
+    EXPECT_EQ(make_lc_alpha_batch(buffer, tokens, arena), 3UL);
+    ASSERT_EQ(arena.size(), 5UL);
+    
+    EXPECT_TRUE(arena.valid(0));
+    EXPECT_EQ(arena[0], "hello");
+    EXPECT_EQ(arena[1], "world");
+    EXPECT_FALSE(arena.valid(2));
+    EXPECT_EQ(arena[2], "");
+    EXPECT_EQ(arena[3], "tokens");
+    EXPECT_FALSE(arena.valid(4));  // out of range
+    EXPECT_EQ(arena.bytes(), "helloworldtokens");
+    
+    auto owned = arena.get(1);
+    ASSERT_TRUE(owned.has_value());
+    EXPECT_EQ(*owned, *make_lc_alpha("world"));
+    EXPECT_FALSE(arena.get(2).has_value());
+}
+
+TEST_F(LcAlphaTest, BatchRejectsHugeTokens) {
+    std::string buffer = "Good bad";
+    size_t huge = std::numeric_limits<size_t>::max();
+    std::vector<std::pair<size_t, size_t>> tokens = {
+        {0, 4}, {0, huge}, {huge, 3}, {5, 3}
+    };
+    
+    lc_alpha_arena arena;
+    EXPECT_EQ(make_lc_alpha_batch(buffer, tokens, arena), 2UL);
+    ASSERT_EQ(arena.size(), 4UL);
+    EXPECT_FALSE(arena.valid(1));
+    EXPECT_FALSE(arena.valid(2));
+    EXPECT_EQ(arena.bytes(), "goodbad");
+}
+
+TEST_F(LcAlphaTest, BatchAppendsToArena) {
+    std::string first = "ab CD";
+    std::string second = "Ef";
+    std::vector<std::pair<size_t, size_t>> first_tokens = {{0, 2}, {3, 2}};
+    std::vector<std::pair<size_t, size_t>> second_tokens = {{0, 2}};
+    
+    lc_alpha_arena arena;
+    make_lc_alpha_batch(first, first_tokens, arena);
+    make_lc_alpha_batch(second, second_tokens, arena);
+    
+    ASSERT_EQ(arena.size(), 3UL);
+    EXPECT_EQ(arena[0], "ab");
+    EXPECT_EQ(arena[1], "cd");
+    EXPECT_EQ(arena[2], "ef");
+    
+    arena.clear();
+    EXPECT_TRUE(arena.empty());
+}
+
+TEST_F(LcAlphaTest, InlineStorageShortWord) {
+    auto word = make_basic_lc_alpha<inline_string<24>>("HeLLo");
+    ASSERT_TRUE(word.has_value());
+    EXPECT_EQ(word->view(), "hello");
+    EXPECT_TRUE(word->str().is_inline());
+    EXPECT_EQ(std::string(*word), "hello");
+    
+    EXPECT_FALSE(make_basic_lc_alpha<inline_string<24>>("hello1").has_value());
+}
+
+TEST_F(LcAlphaTest, InlineStorageSpillsLongWords) {
+    std::string long_word(40, 'X');
+    auto word = make_basic_lc_alpha<inline_string<24>>(long_word);
+    ASSERT_TRUE(word.has_value());
+    EXPECT_FALSE(word->str().is_inline());
+    EXPECT_EQ(word->view(), std::string(40, 'x'));
+    
+    auto copy = *word;
+    auto moved = std::move(*word);
+    EXPECT_EQ(copy, moved);
+}
+
+TEST_F(LcAlphaTest, InlineStorageMonoid) {
+    using inline_lc_alpha = basic_lc_alpha<inline_string<24>>;
+    auto hello = *make_basic_lc_alpha<inline_string<24>>("hello");
+    auto world = *make_basic_lc_alpha<inline_string<24>>("world");
+    
+    auto combined = hello * world;
+    EXPECT_EQ(combined.view(), "helloworld");
+    EXPECT_TRUE(combined.str().is_inline());
+    EXPECT_EQ(inline_lc_alpha{} * hello, hello);
+    EXPECT_EQ((hello ^ 3).view(), "hellohellohello");
+    EXPECT_EQ((hello ^ 6).view(), "hellohellohellohellohellohello");
+    EXPECT_LT(hello, world);
+    
+    auto opt = make_basic_lc_alpha<inline_string<24>>("ab") * make_basic_lc_alpha<inline_string<24>>("cd");
+    ASSERT_TRUE(opt.has_value());
+    EXPECT_EQ(opt->view(), "abcd");
+}
+
 // ============================================================================
 // Porter2 Stemmer Tests
 // ============================================================================
@@ -339,6 +477,89 @@ TEST_F(Porter2StemmerTest, Porter2StemValueSemantics) {
     EXPECT_EQ(*original, assigned);
 }
 
+// Differential test: the in-place buffer stemmer and the std::string entry
+// point must match the original std::string implementation byte for byte
+class Porter2InPlaceTest : public ::testing::Test {
+protected:
+    static std::vector<std::string> word_list() {
+        static const std::vector<std::string> roots = {
+            "run", "walk", "happy", "connect", "general", "commun", "arsen", "nation",
+            "relat", "cry", "say", "by", "hope", "hop", "luxuri", "sky", "news", "atlas",
+            "gas", "kiwi", "gap", "tie", "ski", "die", "lie", "only", "early", "gent",
+            "proceed", "exceed", "inning", "outing", "herring", "bias", "andes", "cosmos",
+            "agree", "feed", "bleed", "fill", "control", "roll", "adopt", "electric",
+            "formal", "sensitiv", "hopeful", "good", "rational", "condition", "valenc",
+            "hesitanc", "dig", "conform", "radical", "differ", "vile", "analog", "fulli",
+            "yell", "ayy", "yoyo", "player", "bey", "obey", "employ", "toy", "eye",
+            "a", "ab", "abc", "e", "i", "s", "us", "ss", "y", "ly", "li", "logi"
+        };
+        static const std::vector<std::string> suffixes = {
+            "", "s", "es", "ed", "ing", "ly", "edly", "ingly", "eed", "eedly", "ied", "ies",
+            "sses", "us", "ss", "'", "'s", "'s'", "y", "ational", "tional", "enci", "anci",
+            "abli", "entli", "izer", "ization", "ation", "ator", "alism", "aliti", "alli",
+            "fulness", "ousli", "ousness", "iveness", "iviti", "biliti", "bli", "fulli",
+            "lessli", "logi", "li", "cli", "eli", "alize", "icate", "iciti", "ical", "ful",
+            "ness", "ative", "al", "ance", "ence", "er", "ic", "able", "ible", "ant",
+            "ement", "ment", "ent", "ism", "ate", "iti", "ous", "ive", "ize", "sion", "tion",
+            "ion", "e", "le", "ll", "at", "bl", "iz", "bb", "tt"
+        };
+        
+        std::vector<std::string> words;
+        for (auto const& root : roots) {
+            for (auto const& suffix : suffixes) {
+                words.push_back(root + suffix);
+                words.push_back("'" + root + suffix);
+            }
+        }
+        
+        // Random words over a vowel-heavy alphabet, including over-long ones
+        std::mt19937 gen(12345);
+        std::string alphabet = "aeiouybcdglmnrstyy'";
+        std::uniform_int_distribution<size_t> len_dist(0, 45);
+        std::uniform_int_distribution<size_t> char_dist(0, alphabet.size() - 1);
+        for (int i = 0; i < 20000; ++i) {
+            std::string w(len_dist(gen), 'a');
+            for (auto& c : w) c = alphabet[char_dist(gen)];
+            words.push_back(w);
+        }
+        return words;
+    }
+};
+
+TEST_F(Porter2InPlaceTest, MatchesReferenceStemmer) {
+    size_t checked = 0;
+    for (auto const& word : word_list()) {
+        std::string expected = word;
+        porter2_reference::porter2stemmer(expected);
+        
+        std::string via_string = word;
+        porter2stemmer(via_string);
+        ASSERT_EQ(via_string, expected) << "input: " << word;
+        
+        char buffer[64];
+        std::copy(word.begin(), word.end(), buffer);
+        size_t length = porter2stemmer(std::span<char>(buffer, word.size()));
+        
+        ASSERT_EQ(std::string(buffer, length), expected) << "input: " << word;
+        ++checked;
+    }
+    EXPECT_GT(checked, 30000UL);
+}
+
+TEST_F(Porter2InPlaceTest, FixedBufferWithLength) {
+    char word[36] = "Generalizations";
+    std::transform(word, word + 15, word, ::tolower);
+    size_t length = porter2stemmer(std::span<char>(word, 15));
+    EXPECT_EQ(std::string(word, length), "general");
+}
+
+TEST_F(Porter2InPlaceTest, FactoryUsesFullInputForValidation) {
+    std::string long_word(40, 'a');
+    EXPECT_TRUE(make_porter2_stem(long_word).has_value());
+    long_word[38] = '1';
+    EXPECT_FALSE(make_porter2_stem(long_word).has_value());
+}
+
 // ============================================================================
 // Function Application Tests
 // ============================================================================
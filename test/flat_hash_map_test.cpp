@@ -0,0 +1,171 @@
+/**
+ * @file flat_hash_map_test.cpp
+ * @brief Tests for the open-addressing hash map and string arena
+ */
+
+#include <gtest/gtest.h>
+#include "parsers/flat_hash_map.hpp"
+#include <map>
+#include <new>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace alga;
+
+namespace {
+    // Throws std::bad_alloc once calls_left reaches zero, to fail in mid-rehash
+    struct failing_hash {
+        static inline int calls_left = -1;
+
+        size_t operator()(std::string const& key) const {
+            if (calls_left == 0) throw std::bad_alloc();
+            if (calls_left > 0) --calls_left;
+            return std::hash<std::string>{}(key);
+        }
+    };
+}
+
+TEST(FlatHashMapTest, InsertAndFind) {
+    flat_hash_map<std::string, int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find("missing"), map.end());
+    EXPECT_EQ(map.begin(), map.end());
+
+    map["one"] = 1;
+    map["two"] = 2;
+    ++map["one"];
+    EXPECT_EQ(map.size(), 2UL);
+    EXPECT_EQ(map.find("one")->second, 2);
+    EXPECT_TRUE(map.contains("two"));
+    EXPECT_FALSE(map.contains("three"));
+    EXPECT_EQ(map["three"], 0);  // Value-initialized on first access
+    EXPECT_EQ(map.size(), 3UL);
+}
+
+TEST(FlatHashMapTest, MatchesUnorderedMapThroughGrowth) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> key_dist(0, 5000);
+    flat_hash_map<int, size_t> map;
+    std::unordered_map<int, size_t> reference;
+
+    for (int i = 0; i < 40000; ++i) {
+        int key = key_dist(gen);
+        ++map[key];
+        ++reference[key];
+    }
+
+    ASSERT_EQ(map.size(), reference.size());
+    for (auto const& [key, count] : reference) {
+        auto it = map.find(key);
+        ASSERT_NE(it, map.end()) << key;
+        EXPECT_EQ(it->second, count);
+    }
+    size_t visited = 0;
+    for (auto const& [key, count] : map) {
+        EXPECT_EQ(reference.at(key), count);
+        ++visited;
+    }
+    EXPECT_EQ(visited, reference.size());
+    EXPECT_FALSE(map.contains(-1));
+}
+
+TEST(FlatHashMapTest, CollidingLowBits) {
+    // Multiples of a large power of two share their low bits before mixing
+    flat_hash_map<uint64_t, int> map;
+    for (uint64_t i = 0; i < 1000; ++i) map[i << 20] = static_cast<int>(i);
+    for (uint64_t i = 0; i < 1000; ++i) EXPECT_EQ(map.find(i << 20)->second, static_cast<int>(i));
+    EXPECT_EQ(map.size(), 1000UL);
+}
+
+TEST(FlatHashMapTest, CopyMoveAndClear) {
+    flat_hash_map<std::string, int> map;
+    for (int i = 0; i < 100; ++i) map[std::to_string(i)] = i;
+
+    auto copy = map;
+    copy["0"] = -1;
+    EXPECT_EQ(map.find("0")->second, 0);
+    EXPECT_EQ(copy.size(), 100UL);
+
+    auto moved = std::move(copy);
+    EXPECT_EQ(moved.find("0")->second, -1);
+    EXPECT_EQ(moved.find("99")->second, 99);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains("5"));
+    map["5"] = 5;
+    EXPECT_EQ(map.size(), 1UL);
+}
+
+TEST(FlatHashMapTest, FailedGrowthLeavesMapUnchanged) {
+    flat_hash_map<std::string, int, failing_hash> map;
+    for (int i = 0; i < 14; ++i) map["key" + std::to_string(i)] = i;  // The next insert grows
+
+    failing_hash::calls_left = 5;  // The new key, then four of the existing keys
+    EXPECT_THROW(map["key14"] = 14, std::bad_alloc);
+    failing_hash::calls_left = -1;
+
+    EXPECT_EQ(map.size(), 14UL);
+    EXPECT_FALSE(map.contains("key14"));
+    for (int i = 0; i < 14; ++i) EXPECT_EQ(map.find("key" + std::to_string(i))->second, i);
+
+    for (int i = 14; i < 100; ++i) map["key" + std::to_string(i)] = i;
+    EXPECT_EQ(map.size(), 100UL);
+    EXPECT_EQ(map.find("key7")->second, 7);
+}
+
+TEST(FlatHashMapTest, StringViewKeysAreOwned) {
+    flat_hash_map<std::string_view, size_t> map;
+    {
+        std::string buffer;
+        for (auto word : {"alpha", "beta", "alpha", "gamma"}) {
+            buffer = word;  // Reused for every token
+            ++map[buffer];
+        }
+        buffer = "overwritten";
+    }
+    EXPECT_EQ(map.find("alpha")->second, 2UL);
+    EXPECT_EQ(map.find("gamma")->second, 1UL);
+
+    // Copies own their own arena
+    auto copy = map;
+    map.clear();
+    EXPECT_EQ(copy.find("beta")->second, 1UL);
+    std::map<std::string, size_t> sorted;
+    for (auto const& [key, count] : copy) sorted[std::string(key)] = count;
+    EXPECT_EQ(sorted, (std::map<std::string, size_t>{{"alpha", 2}, {"beta", 1}, {"gamma", 1}}));
+}
+
+TEST(StringArenaTest, StoresStableCopies) {
+    string_arena arena(8);
+    std::vector<std::string_view> views;
+    std::vector<std::string> expected;
+    for (int i = 0; i < 50; ++i) {
+        std::string s(static_cast<size_t>(i % 13), static_cast<char>('a' + i % 26));
+        expected.push_back(s);
+        views.push_back(arena.store(s));
+    }
+    string_arena moved = std::move(arena);
+    for (size_t i = 0; i < views.size(); ++i) EXPECT_EQ(views[i], expected[i]);
+    EXPECT_GT(moved.size(), 0UL);
+}
+
+TEST(StringArenaTest, MovedFromArenaDoesNotShareBlocks) {
+    string_arena source(64);
+    auto kept = source.store("kept");
+    string_arena target(std::move(source));
+    EXPECT_EQ(source.size(), 0UL);
+
+    // Reusing the moved-from arena must not write into target's block
+    source.store("overwrite");
+    EXPECT_EQ(kept, "kept");
+
+    string_arena assigned;
+    assigned = std::move(target);
+    target.store("again");
+    EXPECT_EQ(kept, "kept");
+    EXPECT_EQ(assigned.size(), 4UL);
+}
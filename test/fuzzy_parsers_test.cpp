@@ -5,6 +5,8 @@
 
 #include <gtest/gtest.h>
 #include "parsers/fuzzy_parsers.hpp"
+#include <list>
+#include <memory>
 #include <string>
 
 using namespace alga;
@@ -56,6 +58,34 @@ TEST_F(WordParserTest, EmptyInput) {
     EXPECT_FALSE(result.has_value());
 }
 
+TEST_F(WordParserTest, ViewParserSlicesInput) {
+    auto parser = word_view_parser();
+    std::string input = "hello world";
+
+    auto [pos, result] = parser.parse(input.begin(), input.end());
+
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(*result, "hello");
+    EXPECT_EQ(result->data(), input.data());  // No copy
+    EXPECT_EQ(*pos, ' ');
+
+    std::string digits = "42";
+    EXPECT_FALSE(parser.parse(digits.begin(), digits.end()).second.has_value());
+}
+
+TEST_F(WordParserTest, NonContiguousInput) {
+    std::list<char> input = {'a', 'b', '1'};
+    auto [pos, result] = word_parser().parse(input.begin(), input.end());
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(*result, "ab");
+    EXPECT_EQ(*pos, '1');
+
+    // Matchers take the copying path on such input
+    auto [pos2, matched] = fuzzy_match("ac", 1).parse(input.begin(), input.end());
+    ASSERT_TRUE(matched.has_value());
+    EXPECT_EQ(*matched, "ab");
+}
+
 // ============================================================================
 // Fuzzy Match Tests
 // ============================================================================
@@ -152,6 +182,58 @@ TEST_F(PhoneticMatchTest, CommonNames) {
     EXPECT_EQ(*result1, "Rupert");
 }
 
+TEST_F(PhoneticMatchTest, MetaphoneAndCombinedEncodings) {
+    auto metaphone = phonetic_match<metaphone_encoding>("Knight");
+    std::string night = "Night";
+    auto [pos, result] = metaphone.parse(night.begin(), night.end());
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(*result, "Night");
+
+    // Soundex alone pairs Robert with Rupert; Metaphone does not
+    std::string rupert = "Rupert";
+    EXPECT_TRUE(phonetic_match("Robert").parse(rupert.begin(), rupert.end()).second.has_value());
+    auto combined = phonetic_match<combined_encoding>("Robert");
+    EXPECT_FALSE(combined.parse(rupert.begin(), rupert.end()).second.has_value());
+    std::string robirt = "Robirt";
+    EXPECT_TRUE(combined.parse(robirt.begin(), robirt.end()).second.has_value());
+}
+
+TEST_F(PhoneticMatchTest, AnyOfManyTargets) {
+    auto parser = phonetic_match_any({"Smith", "Jones", "Catherine"});
+    for (std::string input : {"Smyth", "Johns", "Cathrine"}) {
+        auto [pos, result] = parser.parse(input.begin(), input.end());
+        ASSERT_TRUE(result.has_value()) << input;
+        EXPECT_EQ(*result, input);
+        EXPECT_EQ(pos, input.end());
+    }
+
+    std::string other = "Williams";
+    auto [pos, result] = parser.parse(other.begin(), other.end());
+    EXPECT_FALSE(result.has_value());
+    EXPECT_EQ(pos, other.begin());
+
+    auto metaphone = phonetic_match_any<metaphone_encoding>({"Knight", "Write"});
+    std::string right = "Rite";
+    EXPECT_TRUE(metaphone.parse(right.begin(), right.end()).second.has_value());
+}
+
+TEST_F(PhoneticMatchTest, IndexBackedDictionary) {
+    auto index = std::make_shared<phonetic::PhoneticIndex>();
+    for (auto name : {"Smith", "Catherine", "Jones"}) index->insert(name);
+    auto parser = phonetic_match(std::shared_ptr<const phonetic::PhoneticIndex>(index));
+
+    std::string input = "Kathryn said";
+    auto [pos, result] = parser.parse(input.begin(), input.end());
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(*result, "Kathryn");
+    EXPECT_EQ(*pos, ' ');
+
+    std::string other = "Zbigniew";
+    auto [pos2, result2] = parser.parse(other.begin(), other.end());
+    EXPECT_FALSE(result2.has_value());
+    EXPECT_EQ(pos2, other.begin());
+}
+
 // ============================================================================
 // Similarity Match Tests
 // ============================================================================
@@ -232,6 +314,31 @@ TEST_F(FuzzyChoiceTest, TypoInChoice) {
     EXPECT_EQ(*result, "world");
 }
 
+TEST_F(FuzzyChoiceTest, FirstOfEquallyCloseCandidatesWins) {
+    auto parser = fuzzy_choice({"cart", "care", "cat"}, 2);
+    std::string input = "car";
+
+    auto [pos, result] = parser.parse(input.begin(), input.end());
+
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(*result, "cart");
+}
+
+TEST_F(FuzzyChoiceTest, UnboundedDistanceFunction) {
+    // Plain two-argument distance functions are still accepted
+    FuzzyChoiceMatcher parser(
+        std::vector<std::string>{"apple", "apply"}, 1,
+        [](const std::string& a, const std::string& b) {
+            return similarity::levenshtein_distance(a, b);
+        });
+    std::string input = "appla";
+
+    auto [pos, result] = parser.parse(input.begin(), input.end());
+
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(*result, "apple");
+}
+
 // ============================================================================
 // Case Insensitive Tests
 // ============================================================================
@@ -332,6 +439,38 @@ TEST_F(CombinedFuzzyTest, NoMatch) {
     EXPECT_FALSE(result.has_value());
 }
 
+TEST_F(CombinedFuzzyTest, StageCounters) {
+    auto parser = combined_fuzzy("Python", 2);
+    auto copy = parser;  // Copies report to the same counters
+    for (std::string input : {"Python", "PYTHON", "Pyton", "Py", "Pithon", "Java"}) {
+        copy.parse(input.begin(), input.end());
+    }
+
+    auto stats = parser.stats();
+    EXPECT_EQ(stats.accepted_at(cascade_stage::exact), 1UL);
+    EXPECT_EQ(stats.accepted_at(cascade_stage::case_insensitive), 1UL);
+    EXPECT_EQ(stats.rejected_at(cascade_stage::length_filter), 1UL);  // Py
+    EXPECT_EQ(stats.accepted_at(cascade_stage::phonetic), 2UL);       // Pyton, Pithon
+    EXPECT_EQ(stats.rejected_at(cascade_stage::edit_distance), 1UL);  // Java
+    EXPECT_EQ(stats.total(), 6UL);
+
+    parser.reset_stats();
+    EXPECT_EQ(copy.stats().total(), 0UL);
+}
+
+TEST_F(CombinedFuzzyTest, OptionalStages) {
+    // Without the length filter, sound-alikes of any length get through
+    std::string input = "Leahy";
+    EXPECT_FALSE(combined_fuzzy("Lee", 1).parse(input.begin(), input.end()).second.has_value());
+    auto loose = combined_fuzzy("Lee", 1, {.length_filter = false});
+    EXPECT_TRUE(loose.parse(input.begin(), input.end()).second.has_value());
+
+    auto strict = combined_fuzzy("Python", 0, {.case_insensitive = false, .phonetic = false});
+    std::string lower = "python";
+    EXPECT_FALSE(strict.parse(lower.begin(), lower.end()).second.has_value());
+    EXPECT_EQ(strict.stats().rejected_at(cascade_stage::edit_distance), 1UL);
+}
+
 // ============================================================================
 // Practical Use Cases
 // ============================================================================
@@ -0,0 +1,160 @@
+/**
+ * @file intern_pool_test.cpp
+ * @brief Tests for string interning and integer stem / n-gram IDs
+ */
+
+#include <gtest/gtest.h>
+#include "parsers/intern_pool.hpp"
+#include "parsers/statistics.hpp"
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace alga;
+
+// ============================================================================
+// intern_pool Tests
+// ============================================================================
+
+TEST(InternPoolTest, DenseIdsInInsertionOrder) {
+    intern_pool pool;
+    EXPECT_EQ(pool.intern("alpha"), 1U);
+    EXPECT_EQ(pool.intern("beta"), 2U);
+    EXPECT_EQ(pool.intern("alpha"), 1U);
+    EXPECT_EQ(pool.intern("gamma"), 3U);
+    EXPECT_EQ(pool.size(), 3UL);
+}
+
+TEST(InternPoolTest, DefaultIdIsNeverIssued) {
+    intern_pool pool;
+    EXPECT_EQ(pool.lookup(intern_pool::invalid_id), "");
+    EXPECT_NE(pool.intern(""), intern_pool::invalid_id);
+
+    auto first = intern(*make_lc_alpha("zyzzyva"));
+    EXPECT_TRUE(first.valid());
+    EXPECT_FALSE(intern_id{}.valid());
+    EXPECT_NE(intern_id{}, first);
+    EXPECT_EQ(intern_id{}.view(), "");
+}
+
+TEST(InternPoolTest, LookupAndFind) {
+    intern_pool pool;
+    auto id = pool.intern("stem");
+    EXPECT_EQ(pool.lookup(id), "stem");
+    EXPECT_EQ(pool.find("stem"), id);
+    EXPECT_FALSE(pool.find("missing").has_value());
+    EXPECT_EQ(pool.size(), 1UL);
+
+    // IDs the pool never issued
+    EXPECT_EQ(pool.lookup(id + 1), "");
+    EXPECT_EQ(intern_pool().lookup(intern_id{}.value), "");
+}
+
+TEST(InternPoolTest, ViewsStayValidAfterGrowth) {
+    intern_pool pool;
+    auto first = pool.lookup(pool.intern("first"));
+    for (int i = 0; i < 10000; ++i) {
+        pool.intern("word" + std::to_string(i));
+    }
+    EXPECT_EQ(first, "first");
+}
+
+TEST(InternPoolTest, ConcurrentInterning) {
+    intern_pool pool;
+    std::vector<std::string> words;
+    for (int i = 0; i < 500; ++i) {
+        words.push_back("w" + std::to_string(i));
+    }
+
+    std::vector<std::vector<intern_pool::id_type>> results(8);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < results.size(); ++t) {
+        threads.emplace_back([&, t]() {
+            for (auto const& w : words) {
+                results[t].push_back(pool.intern(w));
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    EXPECT_EQ(pool.size(), words.size());
+    for (auto const& r : results) {
+        EXPECT_EQ(r, results[0]);
+    }
+    for (size_t i = 0; i < words.size(); ++i) {
+        EXPECT_EQ(pool.lookup(results[0][i]), words[i]);
+    }
+}
+
+// ============================================================================
+// Stem ID Tests
+// ============================================================================
+
+TEST(StemIdTest, EqualStemsShareId) {
+    auto a = make_stem_id("running");
+    auto b = make_stem_id("runs");
+    auto c = make_stem_id("walking");
+    ASSERT_TRUE(a && b && c);
+
+    EXPECT_EQ(*a, *b);
+    EXPECT_NE(*a, *c);
+    EXPECT_EQ(a->view(), "run");
+    EXPECT_EQ(std::string(*c), "walk");
+    EXPECT_FALSE(make_stem_id("run42").has_value());
+}
+
+TEST(StemIdTest, InternLcAlphaAndStem) {
+    auto word = *make_lc_alpha("Run");
+    auto stem = *make_porter2_stem("running");
+    EXPECT_EQ(intern(word), intern(stem));
+}
+
+TEST(StemIdTest, HashableInContainers) {
+    std::unordered_set<stem_id> ids;
+    for (auto w : {"connect", "connected", "connecting", "connection", "walk"}) {
+        ids.insert(*make_stem_id(w));
+    }
+    EXPECT_EQ(ids.size(), 2UL);
+}
+
+TEST(StemIdTest, FrequencyCounterOnIds) {
+    statistics::FrequencyCounter<stem_id> counter;
+    for (auto w : {"jumps", "jumping", "jumped", "swim", "swimming"}) {
+        counter.add(*make_stem_id(w));
+    }
+    EXPECT_EQ(counter.unique_count(), 2UL);
+    auto mode = counter.mode();
+    ASSERT_TRUE(mode.has_value());
+    EXPECT_EQ(mode->view(), "jump");
+}
+
+// ============================================================================
+// N-gram ID Tests
+// ============================================================================
+
+TEST(NgramIdTest, BigramPacksIntoSixtyFourBits) {
+    auto bigram = make_bigram(*make_porter2_stem("running"), *make_porter2_stem("dogs"));
+    auto key = intern(bigram);
+    static_assert(sizeof(key) == 8);
+
+    EXPECT_EQ(std::string(key), "run dog");
+    EXPECT_EQ(key.packed() >> 32, key.ids[0]);
+    EXPECT_EQ(key.packed() & 0xFFFFFFFFULL, key.ids[1]);
+    EXPECT_EQ(key, make_ngram_id(*make_stem_id("runs"), *make_stem_id("dog")));
+}
+
+TEST(NgramIdTest, TrigramKeyInMap) {
+    static_assert(sizeof(ngram_id<3>) == 12);
+
+    std::unordered_map<ngram_id<3>, size_t> counts;
+    auto t1 = intern(make_trigram(*make_porter2_stem("the"), *make_porter2_stem("cats"),
+                                  *make_porter2_stem("ran")));
+    auto t2 = intern(make_trigram(*make_porter2_stem("the"), *make_porter2_stem("cat"),
+                                  *make_porter2_stem("ran")));
+    ++counts[t1];
+    ++counts[t2];
+    EXPECT_EQ(counts.size(), 1UL);
+    EXPECT_EQ(counts[t1], 2UL);
+}
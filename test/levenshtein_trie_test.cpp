@@ -0,0 +1,124 @@
+/**
+ * @file levenshtein_trie_test.cpp
+ * @brief Tests for the Levenshtein trie index and indexed fuzzy choice
+ */
+
+#include <gtest/gtest.h>
+#include "parsers/levenshtein_trie.hpp"
+#include "parsers/fuzzy_parsers.hpp"
+#include "random_words.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace alga;
+using namespace alga::similarity;
+using test_words::random_words;
+
+namespace {
+    // First candidate with the minimum distance, as FuzzyChoiceMatcher always did
+    std::optional<std::pair<std::string, size_t>> linear_closest(
+        std::vector<std::string> const& words, std::string const& query, size_t max_distance) {
+        size_t best = SIZE_MAX;
+        std::string const* word = nullptr;
+        for (auto const& w : words) {
+            size_t d = levenshtein_distance(query, w);
+            if (d < best) {
+                best = d;
+                word = &w;
+            }
+        }
+        if (word == nullptr || best > max_distance) return std::nullopt;
+        return std::make_pair(*word, best);
+    }
+}
+
+TEST(LevenshteinTrieTest, EmptyTrie) {
+    levenshtein_trie trie;
+    EXPECT_TRUE(trie.empty());
+    EXPECT_FALSE(trie.closest("anything", 5).has_value());
+}
+
+TEST(LevenshteinTrieTest, DuplicatesKeepFirstIndex) {
+    levenshtein_trie trie;
+    EXPECT_EQ(trie.insert("apple"), 0UL);
+    EXPECT_EQ(trie.insert("apply"), 1UL);
+    EXPECT_EQ(trie.insert("apple"), 0UL);
+    EXPECT_EQ(trie.insert("app"), 2UL);
+    EXPECT_EQ(trie.size(), 3UL);
+    EXPECT_EQ(trie[1], "apply");
+}
+
+TEST(LevenshteinTrieTest, ClosestWithinRadius) {
+    levenshtein_trie trie(std::vector<std::string>{"book", "books", "cake", "boo", "cape", "cart"});
+    auto m = trie.closest("bock", 1);
+    ASSERT_TRUE(m.has_value());
+    EXPECT_EQ(trie[m->index], "book");
+    EXPECT_EQ(m->distance, 1UL);
+
+    EXPECT_FALSE(trie.closest("zzzzzz", 2).has_value());
+    EXPECT_EQ(trie[trie.closest("cak", 1)->index], "cake");
+}
+
+TEST(LevenshteinTrieTest, EmptyWordAndQuery) {
+    levenshtein_trie trie(std::vector<std::string>{"ab", "", "a"});
+    auto m = trie.closest("", 1);
+    ASSERT_TRUE(m.has_value());
+    EXPECT_EQ(m->index, 1UL);
+    EXPECT_EQ(m->distance, 0UL);
+    EXPECT_EQ(trie[trie.closest("b", 1)->index], "ab");
+}
+
+TEST(LevenshteinTrieTest, UnlimitedRadiusFindsNearest) {
+    levenshtein_trie trie(std::vector<std::string>{"zzzzzzzz", "abcdefgh", "qqq"});
+    auto m = trie.closest("abc", SIZE_MAX);
+    ASSERT_TRUE(m.has_value());
+    EXPECT_EQ(trie[m->index], "qqq");
+    EXPECT_EQ(m->distance, 3UL);
+}
+
+TEST(LevenshteinTrieTest, LongWordsBeyondQueryRadius) {
+    // Only depths up to |query| + max_distance are searched
+    std::string long_word(5000, 'a');
+    levenshtein_trie trie(std::vector<std::string>{long_word, "aaab", long_word + "b"});
+    EXPECT_EQ(trie[trie.closest("aaaa", 1)->index], "aaab");
+    EXPECT_FALSE(trie.closest("aaaaaaa", 2).has_value());
+    auto m = trie.closest(long_word + "c", 1);
+    ASSERT_TRUE(m.has_value());
+    EXPECT_EQ(m->index, 0UL);
+}
+
+TEST(LevenshteinTrieTest, MatchesLinearScan) {
+    std::mt19937 gen(99);
+    auto dictionary = random_words(gen, 3000, 9, 6);
+    levenshtein_trie trie(dictionary);
+    auto queries = random_words(gen, 500, 10, 6);
+
+    for (size_t max_distance : {0UL, 1UL, 2UL, 3UL}) {
+        for (auto const& q : queries) {
+            auto expected = linear_closest(dictionary, q, max_distance);
+            auto actual = trie.closest(q, max_distance);
+            ASSERT_EQ(actual.has_value(), expected.has_value()) << q << " k=" << max_distance;
+            if (expected) {
+                EXPECT_EQ(trie[actual->index], expected->first) << q << " k=" << max_distance;
+                EXPECT_EQ(actual->distance, expected->second);
+            }
+        }
+    }
+}
+
+TEST(LevenshteinTrieTest, FuzzyChoiceUsesIndexWithSameResults) {
+    std::mt19937 gen(7);
+    auto dictionary = random_words(gen, 1000, 7, 6);
+    auto indexed = fuzzy::fuzzy_choice(dictionary, 2);
+    fuzzy::FuzzyChoiceMatcher linear(dictionary, 2, [](std::string const& a, std::string const& b) {
+        return levenshtein_distance(a, b);
+    });
+
+    for (auto const& q : random_words(gen, 300, 8, 6)) {
+        auto [pos1, r1] = indexed.parse(q.begin(), q.end());
+        auto [pos2, r2] = linear.parse(q.begin(), q.end());
+        EXPECT_EQ(r1, r2) << q;
+        EXPECT_EQ(pos1, pos2);
+    }
+}
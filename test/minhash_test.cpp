@@ -0,0 +1,137 @@
+/**
+ * @file minhash_test.cpp
+ * @brief Tests for q-gram profiles, MinHash and LSH blocking
+ */
+
+#include <gtest/gtest.h>
+#include "parsers/minhash.hpp"
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace alga;
+using namespace alga::similarity;
+
+namespace {
+    std::string random_text(std::mt19937& gen, size_t length) {
+        std::uniform_int_distribution<int> letter(0, 25);
+        std::string s(length, 'a');
+        for (auto& c : s) c = static_cast<char>('a' + letter(gen));
+        return s;
+    }
+
+    // Copy of s with a few characters replaced
+    std::string perturb(std::mt19937& gen, std::string s, size_t edits) {
+        for (size_t k = 0; k < edits; ++k) s[gen() % s.size()] = 'Z';
+        return s;
+    }
+}
+
+TEST(QGramTest, ProfilesAreSortedAndDistinct) {
+    auto grams = qgram_profile("abababab", 2);
+    EXPECT_EQ(grams.size(), 2UL);  // "ab" and "ba"
+    EXPECT_TRUE(std::is_sorted(grams.begin(), grams.end()));
+
+    EXPECT_TRUE(qgram_profile("", 3).empty());
+    EXPECT_EQ(qgram_profile("ab", 3).size(), 1UL);
+    EXPECT_EQ(qgram_profile("ab", 3), qgram_profile("ab", 5));
+}
+
+TEST(QGramTest, JaccardSimilarity) {
+    EXPECT_DOUBLE_EQ(qgram_similarity("night", "night"), 1.0);
+    EXPECT_DOUBLE_EQ(qgram_similarity("", ""), 1.0);
+    EXPECT_DOUBLE_EQ(qgram_similarity("abc", ""), 0.0);
+    // nig igh ght vs nac ach cht: nothing shared
+    EXPECT_DOUBLE_EQ(qgram_similarity("night", "nacht"), 0.0);
+    // abcd -> abc bcd; abce -> abc bce: 1 shared of 3
+    EXPECT_DOUBLE_EQ(qgram_similarity("abcd", "abce"), 1.0 / 3.0);
+}
+
+TEST(MinHashTest, EstimatesJaccard) {
+    std::mt19937 gen(8);
+    minhash hasher(512);
+    for (int trial = 0; trial < 20; ++trial) {
+        std::string a = random_text(gen, 200);
+        std::string b = perturb(gen, a, static_cast<size_t>(trial * 3));
+        double exact = qgram_similarity(a, b);
+        double estimate = minhash::estimate(hasher.signature(a), hasher.signature(b));
+        EXPECT_NEAR(estimate, exact, 0.08) << "trial " << trial;
+    }
+}
+
+TEST(MinHashTest, SameSeedSameSignature) {
+    minhash first(64, 1);
+    minhash second(64, 1);
+    minhash other(64, 2);
+    EXPECT_EQ(first.signature("signature"), second.signature("signature"));
+    EXPECT_NE(first.signature("signature"), other.signature("signature"));
+    EXPECT_DOUBLE_EQ(minhash::estimate(first.signature("abcdef"), first.signature("abcdef")), 1.0);
+}
+
+TEST(MinHashTest, RejectsShortOutputSpan) {
+    minhash hasher(16);
+    auto profile = qgram_profile("signature");
+    std::vector<uint64_t> out(15);
+    EXPECT_THROW(hasher.signature(profile, out), std::invalid_argument);
+    out.resize(17);
+    hasher.signature(profile, out);
+    EXPECT_TRUE(std::equal(out.begin(), out.begin() + 16, hasher.signature("signature").begin()));
+}
+
+TEST(LshIndexTest, ThresholdFollowsBandsAndRows) {
+    EXPECT_NEAR(lsh_index(16, 4).threshold(), 0.5, 1e-12);
+    EXPECT_GT(lsh_index(4, 8).threshold(), lsh_index(32, 8).threshold());
+}
+
+TEST(LshIndexTest, FindsNearDuplicatesNotStrangers) {
+    std::mt19937 gen(21);
+    lsh_index index(20, 5);
+    std::vector<std::string> texts;
+    for (size_t i = 0; i < 200; ++i) {
+        texts.push_back(random_text(gen, 120));
+        EXPECT_EQ(index.insert(texts.back()), i);
+    }
+
+    auto near = index.query(perturb(gen, texts[42], 2));
+    EXPECT_NE(std::find(near.begin(), near.end(), 42UL), near.end());
+    EXPECT_LT(near.size(), 5UL);
+    EXPECT_TRUE(index.query(random_text(gen, 120)).empty());
+}
+
+TEST(LshIndexTest, CandidatePairsAreDistinctAndOrdered) {
+    lsh_index index(8, 2);
+    for (auto s : {"duplicate entry", "duplicate entry", "duplicate entry", "unrelated"}) index.insert(s);
+    auto pairs = index.candidate_pairs();
+    std::vector<std::pair<size_t, size_t>> expected = {{0, 1}, {0, 2}, {1, 2}};
+    EXPECT_EQ(pairs, expected);
+}
+
+TEST(LshIndexTest, HotBucketPairsCountedOnce) {
+    // Identical strings collide in every band
+    lsh_index index(32, 2);
+    for (int i = 0; i < 300; ++i) index.insert("");
+    auto pairs = index.candidate_pairs();
+    ASSERT_EQ(pairs.size(), 300UL * 299 / 2);
+    EXPECT_EQ(pairs.front(), std::make_pair(size_t(0), size_t(1)));
+    EXPECT_EQ(pairs.back(), std::make_pair(size_t(298), size_t(299)));
+}
+
+TEST(NearDuplicatesTest, AgreesWithAllPairsOnClearDuplicates) {
+    std::mt19937 gen(5);
+    std::vector<std::string> records;
+    for (size_t i = 0; i < 300; ++i) {
+        records.push_back(random_text(gen, 60));
+        if (i % 3 == 0) records.push_back(perturb(gen, records.back(), 1));
+    }
+    std::vector<std::string_view> strings(records.begin(), records.end());
+
+    auto exact = similarity_matrix(strings, pair_metric::lcs, 0.9);
+    auto blocked = near_duplicates(strings, pair_metric::lcs, 0.9, {.bands = 20, .rows = 5});
+    ASSERT_EQ(exact.size(), 100UL);
+    EXPECT_EQ(blocked, exact);
+
+    auto edits = near_duplicates(strings, pair_metric::levenshtein, 1);
+    EXPECT_EQ(edits.size(), 100UL);
+}
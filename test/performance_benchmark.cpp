@@ -20,6 +20,7 @@
 #include <iomanip>
 #include "parsers/lc_alpha.hpp"
 #include "parsers/porter2stemmer.hpp"
+#include "parsers/stem_cache.hpp"
 #include "parsers/combinatorial_parser_fixed.hpp"
 
 using namespace alga;
@@ -205,6 +206,36 @@ public:
                 alpha_index++;
             }
         });
+        
+        // Benchmark the in-place entry point on words that reach steps 2-4
+        std::vector<std::string> suffixed_words;
+        const std::vector<std::string> suffixes = {
+            "ational", "ization", "fulness", "iveness", "biliti", "alize", "icate",
+            "ement", "ance", "ible", "ism", "ous", "ative", "ness", "ically", "ion"
+        };
+        for (size_t i = 0; i < medium_words.size(); ++i) {
+            suffixed_words.push_back(medium_words[i] + suffixes[i % suffixes.size()]);
+        }
+        
+        size_t suffixed_index = 0;
+        char buffer[porter2_max_word_length];
+        benchmark_function("Porter2 in-place stemming (suffixed words)", [&]() {
+            auto const& word = suffixed_words[suffixed_index % suffixed_words.size()];
+            size_t length = std::min(word.size(), porter2_max_word_length);
+            std::copy_n(word.data(), length, buffer);
+            volatile size_t stemmed = porter2stemmer(std::span<char>(buffer, length));
+            (void)stemmed;
+            suffixed_index++;
+        });
+        
+        stem_cache cache;
+        size_t cached_index = 0;
+        benchmark_function("Porter2 stemming through stem_cache (suffixed words)", [&]() {
+            auto result = make_porter2_stem(suffixed_words[cached_index % suffixed_words.size()], cache);
+            (void)result;
+            cached_index++;
+        });
+        std::cout << "  Cache hit rate: " << cache.statistics().hit_rate() * 100 << "%\n\n";
     }
     
     // ============================================================================
@@ -308,7 +339,7 @@ public:
             for (size_t i = 0; i < test_count; ++i) {
                 std::string word = generate_alpha_string(8 + (i % 10));
                 if (auto alpha = make_lc_alpha(word)) {
-                    stems.push_back(stemmer(*alpha));
+                    stems.push_back(*stemmer(*alpha));
                 }
             }
             
@@ -369,7 +400,7 @@ public:
             stems.reserve(size);
             
             for (const auto& alpha : alphas) {
-                stems.push_back(stemmer(alpha));
+                stems.push_back(*stemmer(alpha));
             }
             
             end = std::chrono::high_resolution_clock::now();
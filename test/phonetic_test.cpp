@@ -5,6 +5,8 @@
 
 #include <gtest/gtest.h>
 #include "parsers/phonetic.hpp"
+#include "phonetic_reference.hpp"
+#include <random>
 #include <string>
 
 using namespace alga;
@@ -261,6 +263,140 @@ TEST(PhoneticUseCases, DeduplicationCandidate) {
     EXPECT_EQ(soundex("Robert"), soundex("Rupert"));
 }
 
+// ============================================================================
+// Packed Codes and Table-driven Encoders
+// ============================================================================
+
+static_assert(Soundex::code("Robert") == 0x52313633);  // "R163", at compile time
+static_assert(Metaphone::code("knight") == 0x4e4b540000000000ULL);  // "NKT"
+
+TEST(PackedPhoneticCodes, MatchStringCodes) {
+    EXPECT_EQ(unpack_code(soundex_code("Washington")), "W252");
+    EXPECT_EQ(unpack_code(soundex_code("")), "0000");
+    EXPECT_EQ(unpack_code(metaphone_code("through")), "TRK");
+    EXPECT_EQ(metaphone_code(""), 0UL);
+    EXPECT_EQ(unpack_code(metaphone_code("example", 7)), metaphone("example", 7));
+}
+
+TEST(PackedPhoneticCodes, IntegerOrderIsStringOrder) {
+    std::vector<std::string> words = {"Smith", "Jones", "Ashcraft", "Lee", "Zachary", "Baker", "Able"};
+    for (auto const& a : words) {
+        for (auto const& b : words) {
+            EXPECT_EQ(soundex_code(a) < soundex_code(b), soundex(a) < soundex(b)) << a << " / " << b;
+            EXPECT_EQ(metaphone_code(a) < metaphone_code(b), metaphone(a) < metaphone(b)) << a << " / " << b;
+        }
+    }
+}
+
+TEST(PackedPhoneticCodes, MetaphoneLengthCappedForPacking) {
+    // X emits two letters, so a 7-letter limit can produce 8
+    EXPECT_EQ(unpack_code(metaphone_code("bcdfgjx", 7)), "BKTFKJKS");
+    EXPECT_EQ(unpack_code(metaphone_code("bcdfgjlmnr", 20)), metaphone("bcdfgjlmnr", 7));
+}
+
+TEST(TableDrivenEncoders, MatchOriginalImplementation) {
+    // Letters of both cases, common digraph letters, and non-letter bytes
+    const std::string alphabet = "aeiouAEIOUbcdfghjklmnpqrstvwxyzBCGHKMNPSTWXY'-1 \x80\xff";
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<size_t> len_dist(0, 12);
+    std::uniform_int_distribution<size_t> char_dist(0, alphabet.size() - 1);
+
+    for (int trial = 0; trial < 20000; ++trial) {
+        std::string word(len_dist(gen), ' ');
+        for (auto& c : word) c = alphabet[char_dist(gen)];
+
+        ASSERT_EQ(soundex(word), phonetic_reference::Soundex::encode(word)) << word;
+        for (size_t max_length : {0UL, 1UL, 4UL, 7UL, 10UL}) {
+            ASSERT_EQ(metaphone(word, max_length), phonetic_reference::Metaphone::encode(word, max_length))
+                << word << " max " << max_length;
+        }
+    }
+}
+
+// ============================================================================
+// Double Metaphone Tests
+// ============================================================================
+
+TEST(DoubleMetaphoneTest, KnownCodes) {
+    struct expected { const char* word; const char* primary; const char* alternate; };
+    for (auto e : std::vector<expected>{
+             {"Thompson", "TMPS", "TMPS"}, {"Schmidt", "XMT", "SMT"}, {"Smith", "SM0", "XMT"},
+             {"Michael", "MKL", "MXL"}, {"Xavier", "SF", "SFR"}, {"Jose", "HS", "HS"},
+             {"Arnow", "ARN", "ARNF"}, {"Filipowicz", "FLPT", "FLPF"}, {"Caesar", "SSR", "SSR"},
+             {"Zhao", "J", "J"}, {"Knight", "NT", "NT"}, {"Dumb", "TM", "TM"},
+             {"Gallegos", "KLKS", "KKS"}, {"Edge", "AJ", "AJ"}, {"laugh", "LF", "LF"}}) {
+        auto [primary, alternate] = double_metaphone(e.word);
+        EXPECT_EQ(primary, e.primary) << e.word;
+        EXPECT_EQ(alternate, e.alternate) << e.word;
+    }
+}
+
+TEST(DoubleMetaphoneTest, LengthAndWhitespace) {
+    EXPECT_EQ(double_metaphone("Thompson", 8).first, "TMPSN");
+    EXPECT_EQ(double_metaphone("Washington", 8), std::make_pair(std::string("AXNKTN"), std::string("FXNKTN")));
+    EXPECT_EQ(double_metaphone("  Smith\t"), double_metaphone("smith"));
+    EXPECT_EQ(double_metaphone("").first, "");
+}
+
+TEST(DoubleMetaphoneTest, SoundsLikeUsesEitherCode) {
+    EXPECT_TRUE(sounds_like_double_metaphone("Smith", "Schmidt"));  // SM0/XMT vs XMT/SMT
+    EXPECT_TRUE(sounds_like_double_metaphone("Catherine", "Kathryn"));
+    EXPECT_FALSE(sounds_like_double_metaphone("Smith", "Jones"));
+}
+
+TEST(DoubleMetaphoneTest, PackedMatchesStrings) {
+    std::mt19937 gen(4);
+    const std::string alphabet = "aeiouybcdfghjklmnpqrstvwxzCHSGW ";
+    std::uniform_int_distribution<size_t> len_dist(0, 12);
+    std::uniform_int_distribution<size_t> char_dist(0, alphabet.size() - 1);
+    for (int trial = 0; trial < 5000; ++trial) {
+        std::string word(len_dist(gen), ' ');
+        for (auto& c : word) c = alphabet[char_dist(gen)];
+        for (size_t max_length : {4UL, 8UL}) {
+            auto packed = double_metaphone_code_of(word, max_length);
+            auto text = double_metaphone(word, max_length);
+            ASSERT_EQ(unpack_code(packed.primary), text.first) << word;
+            // The alternate may end in a space ("raj" -> R / RJ ), kept as is
+            ASSERT_EQ(unpack_code(packed.alternate), text.second) << word;
+        }
+    }
+}
+
+// ============================================================================
+// PhoneticIndex Tests
+// ============================================================================
+
+TEST(PhoneticIndexTest, LooksUpEveryRecordThatSoundsAlike) {
+    PhoneticIndex index;
+    std::vector<std::string> names = {"Smith", "Schmidt", "Smyth", "Jones", "Johns", "Catherine", "Kathryn"};
+    for (size_t i = 0; i < names.size(); ++i) {
+        EXPECT_EQ(index.insert(names[i]), i);
+    }
+    EXPECT_EQ(index.size(), names.size());
+
+    EXPECT_EQ(index.lookup("Smithe"), (std::vector<uint32_t>{0, 1, 2}));
+    EXPECT_EQ(index.lookup("Kathrin"), (std::vector<uint32_t>{5, 6}));
+    EXPECT_TRUE(index.sounds_like_any("Jonze"));
+    EXPECT_FALSE(index.sounds_like_any("Zbigniew"));
+    EXPECT_TRUE(index.lookup("Zbigniew").empty());
+}
+
+TEST(PhoneticIndexTest, SoundexAndMetaphoneKeys) {
+    PhoneticIndex soundex_index(phonetic_algorithm::soundex);
+    soundex_index.insert("Robert");
+    soundex_index.insert("Rupert");
+    soundex_index.insert("Rubin");
+    EXPECT_EQ(soundex_index.lookup("Robbert"), (std::vector<uint32_t>{0, 1}));
+    EXPECT_EQ(soundex_index.postings_for(soundex_code("Rubin")).size(), 1UL);
+
+    PhoneticIndex metaphone_index(phonetic_algorithm::metaphone);
+    metaphone_index.insert("knight");
+    metaphone_index.insert("night");
+    EXPECT_EQ(metaphone_index.lookup("nite").size(), 0UL);
+    EXPECT_EQ(metaphone_index.lookup("knite").size(), 0UL);
+    EXPECT_EQ(metaphone_index.lookup("nigt"), (std::vector<uint32_t>{0, 1}));
+}
+
 // ============================================================================
 // Main
 // ============================================================================
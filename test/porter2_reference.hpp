@@ -0,0 +1,502 @@
+#pragma once
+
+// Original std::string Porter2 implementation, kept verbatim as a test oracle
+// for the in-place stemmer in include/parsers/porter2stemmer.cpp.
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <unordered_map>
+#include <string>
+
+namespace porter2_reference {
+using std::string;
+
+static size_t firstNonVowelAfterVowel(const string& word, size_t start);
+static size_t getStartR1(const string& word);
+static size_t getStartR2(const string& word, size_t startR1);
+static void changeY(string& word);
+static void step0(string& word);
+static bool step1A(string& word);
+static void step1B(string& word, size_t startR1);
+static void step1C(string& word);
+static void step2(string& word, size_t startR1);
+static void step3(string& word, size_t startR1, size_t startR2);
+static void step4(string& word, size_t startR2);
+static void step5(string& word, size_t startR1, size_t startR2);
+static bool isShort(const string& word);
+static bool special(string& word);
+static bool isVowel(char ch);
+static bool isVowelY(char ch);
+static bool endsWith(const string& word, const string& str);
+static bool endsInDouble(const string& word);
+static bool replaceIfExists(string& word,
+                        const string& suffix, const string& replacement,
+                        size_t start);
+static bool isValidLIEnding(char ch);
+static bool containsVowel(const string& word, size_t start, size_t end);
+
+inline void porter2stemmer(string & word)
+{
+    // special case short words
+    if(word.size() <= 2)
+        return;
+
+    // max word length is 35 for English
+    if(word.size() > 35)
+        word = word.substr(0, 35);
+
+    if(word[0] == '\'')
+        word = word.substr(1, word.size() - 1);
+
+    if(special(word))
+        return;
+
+    changeY(word);
+    size_t startR1 = getStartR1(word);
+    size_t startR2 = getStartR2(word, startR1);
+
+    step0(word);
+
+    if(step1A(word))
+    {
+        std::replace(word.begin(), word.end(), 'Y', 'y');
+        return;
+    }
+
+    step1B(word, startR1);
+    step1C(word);
+    step2(word, startR1);
+    step3(word, startR1, startR2);
+    step4(word, startR2);
+    step5(word, startR1, startR2);
+
+    std::replace(word.begin(), word.end(), 'Y', 'y');
+    return;
+}
+
+
+/**
+ * The procedures below this comment are internal to the implementation
+ * of porter2stemmer and not externally visible.
+ */
+static size_t getStartR1(const string& word)
+{
+    // special cases
+    if (word.substr(0, 5) == "gener")
+        return 5;
+    if (word.substr(0, 6) == "commun")
+        return 6;
+    if (word.substr(0, 5) == "arsen")
+        return 5;
+    // general case
+    return firstNonVowelAfterVowel(word, 1);
+}
+
+size_t getStartR2(const string& word, size_t startR1)
+{
+    if (startR1 == word.size())
+        return startR1;
+
+    return firstNonVowelAfterVowel(word, startR1+1);
+}
+
+static size_t firstNonVowelAfterVowel(
+    const string& word,
+    size_t start)
+{
+    for(size_t i = start; i != 0 && i < word.size(); ++i)
+    {
+        if(!isVowelY(word[i]) && isVowelY(word[i-1]))
+            return i + 1;
+    }
+
+    return word.size();
+}
+
+static void changeY(string& word)
+{
+    if(word.find_first_of("y") == string::npos)
+        return;
+
+    if(word[0] == 'y')
+        word[0] = 'Y';
+
+    for(size_t i = 1; i < word.size(); ++i)
+    {
+        if(word[i] == 'y' && isVowel(word[i - 1]))
+            word[i++] = 'Y';    // skip next iteration
+    }
+}
+
+/**
+  Step 0
+*/
+static void step0(string& word)
+{
+    // short circuit the longest suffix
+    replaceIfExists(word, "'s'", "", 0)
+    || replaceIfExists(word, "'s", "", 0)
+    || replaceIfExists(word, "'", "", 0);
+}
+
+/**
+  Step 1a:
+
+  sses
+    replace by ss
+
+  ied   ies
+    replace by i if preceded by more than one letter, otherwise by ie
+    (so ties -> tie, cries -> cri)
+
+  us   ss
+    do nothing
+
+  s
+    delete if the preceding word part contains a vowel not immediately before the
+    s (so gas and this retain the s, gaps and kiwis lose it)
+*/
+static bool step1A(string& word)
+{
+    if(!replaceIfExists(word, "sses", "ss", 0))
+    {
+        if(endsWith(word, "ied") || endsWith(word, "ies"))
+        {
+            // if preceded by only one letter
+            if(word.size() <= 4)
+                word = word.substr(0, word.size() - 1);
+            else
+                word = word.substr(0, word.size() - 2);
+        }
+        else if(endsWith(word, "s") && !endsWith(word, "us")
+                && !endsWith(word, "ss"))
+        {
+            if(word.size() > 2 && containsVowel(word, 0, word.size() - 2))
+                word = word.substr(0, word.size() - 1);
+        }
+    }
+
+    // special case after step 1a
+    return word == "inning" || word == "outing" || word == "canning" || word == "herring" ||
+           word == "earring" || word == "proceed" || word == "exceed" || word == "succeed";
+}
+
+/**
+  Step 1b:
+
+  eed   eedly
+      replace by ee if in R1
+
+  ed   edly   ing   ingly
+      delete if the preceding word part contains a vowel, and after the deletion:
+      if the word ends at, bl or iz add e (so luxuriat -> luxuriate), or
+      if the word ends with a double remove the last letter (so hopp -> hop), or
+      if the word is short, add e (so hop -> hope)
+*/
+static void step1B(string& word, size_t startR1)
+{
+    bool exists = endsWith(word, "eedly") || endsWith(word, "eed");
+
+    if(exists)
+    {
+        replaceIfExists(word, "eedly", "ee", startR1)
+        || replaceIfExists(word, "eed", "ee", startR1);
+    }
+    else
+    {
+        size_t size = word.size();
+        bool deleted = (containsVowel(word, 0, size - 2)
+                        && replaceIfExists(word, "ed", "", 0))
+                       || (containsVowel(word, 0, size - 4)
+                           && replaceIfExists(word, "edly", "", 0))
+                       || (containsVowel(word, 0, size - 3) && replaceIfExists(word, "ing", "", 0))
+                       || (containsVowel(word, 0, size - 5)
+                           && replaceIfExists(word, "ingly", "", 0));
+
+        if(deleted && (endsWith(word, "at") || endsWith(word, "bl")
+                       || endsWith(word, "iz")))
+            word = word + "e";
+        else if(deleted && endsInDouble(word))
+            word = word.substr(0, word.size() - 1);
+        else if(deleted && startR1 == word.size() && isShort(word))
+            word = word + "e";
+    }
+}
+
+/**
+  Step 1c:
+
+  Replace suffix y or Y by i if preceded by a non-vowel which is not the first
+  letter of the word (so cry -> cri, by -> by, say -> say)
+*/
+static void step1C(string& word)
+{
+    size_t size = word.size();
+    if(size > 2 && (word[size - 1] == 'y' || word[size - 1] == 'Y'))
+    {
+        if(!isVowel(word[size - 2]))
+            word[size - 1] = 'i';
+    }
+}
+
+/**
+  Step 2:
+
+  If found and in R1, perform the action indicated.
+
+  tional:               replace by tion
+  enci:                 replace by ence
+  anci:                 replace by ance
+  abli:                 replace by able
+  entli:                replace by ent
+  izer, ization:        replace by ize
+  ational, ation, ator: replace by ate
+  alism, aliti, alli:   replace by al
+  fulness:              replace by ful
+  ousli, ousness:       replace by ous
+  iveness, iviti:       replace by ive
+  biliti, bli:          replace by ble
+  fulli:                replace by ful
+  lessli:               replace by less
+  ogi:                  replace by og if preceded by l
+  li:                   delete if preceded by a valid li-ending
+*/
+static void step2(string& word, size_t startR1)
+{
+    static const std::vector<std::pair<string, string>> subs =
+    {
+        {"ational", "ate"}, {"tional", "tion"}, {"enci", "ence"}, {"anci", "ance"},
+        {"abli", "able"}, {"entli", "ent"}, {"izer", "ize"}, {"ization", "ize"},
+        {"ation", "ate"}, {"ator", "ate"}, {"alism", "al"}, {"aliti", "al"},
+        {"alli", "al"}, {"fulness", "ful"}, {"ousli", "ous"}, {"ousness", "ous"},
+        {"iveness", "ive"}, {"iviti", "ive"}, {"biliti", "ble"}, {"bli", "ble"},
+        {"fulli", "ful"}, {"lessli", "less"}
+    };
+
+    for(auto& sub : subs)
+    {
+        if(replaceIfExists(word, sub.first, sub.second, startR1))
+            return;
+    }
+
+    if(!replaceIfExists(word, "logi", "log", startR1 - 1))
+    {
+        // make sure we choose the longest suffix
+        if(endsWith(word, "li") && !endsWith(word, "abli")
+                && !endsWith(word, "entli")
+                && !endsWith(word, "aliti") && !endsWith(word, "alli")
+                && !endsWith(word, "ousli")
+                && !endsWith(word, "bli") && !endsWith(word, "fulli")
+                && !endsWith(word, "lessli"))
+            if(word.size() > 3 && word.size() - 2 >= startR1
+                    && isValidLIEnding(word[word.size() - 3]))
+            {
+                word = word.substr(0, word.size() - 2);
+            }
+    }
+}
+
+/**
+  Step 3:
+
+  If found and in R1, perform the action indicated.
+
+  ational:            replace by ate
+  tional:             replace by tion
+  alize:              replace by al
+  icate, iciti, ical: replace by ic
+  ful, ness:          delete
+  ative:              delete if in R2
+*/
+static void step3(string& word, size_t startR1, size_t startR2)
+{
+    static const std::vector<std::pair<string, string>> subs =
+    {
+        {"ational", "ate"}, {"tional", "tion"}, {"alize", "al"}, {"icate", "ic"},
+        {"iciti", "ic"}, {"ical", "ic"}, {"ful", ""}, {"ness", ""}
+    };
+
+    for(auto& sub : subs)
+    {
+        if(replaceIfExists(word, sub.first, sub.second, startR1))
+            return;
+    }
+
+    replaceIfExists(word, "ative", "", startR2);
+}
+
+/**
+  Step 4:
+
+  If found and in R2, perform the action indicated.
+
+  al ance ence er ic able ible ant ement ment ent ism ate
+    iti ous ive ize
+                              delete
+  ion
+                              delete if preceded by s or t
+*/
+static void step4(string& word, size_t startR2)
+{
+    static const std::vector<std::pair<string, string>> subs =
+    {
+        {"al", ""}, {"ance", ""}, {"ence", ""}, {"er", ""}, {"ic", ""},
+        {"able", ""}, {"ible", ""}, {"ant", ""}, {"ement", ""}, {"ment", ""},
+        {"ism", ""}, {"ate", ""}, {"iti", ""}, {"ous", ""}, {"ive", ""}, {"ize", ""}
+    };
+
+    for(auto& sub : subs)
+    {
+        if(replaceIfExists(word, sub.first, sub.second, startR2))
+            return;
+    }
+
+    // make sure we only choose the longest suffix
+    if(!endsWith(word, "ement") && !endsWith(word, "ment"))
+    {
+        if(replaceIfExists(word, "ent", "", startR2))
+            return;
+    }
+
+    // short circuit
+    replaceIfExists(word, "sion", "s", startR2 - 1)
+    || replaceIfExists(word, "tion", "t", startR2 - 1);
+}
+
+/**
+  Step 5:
+
+  e     delete if in R2, or in R1 and not preceded by a short syllable
+  l     delete if in R2 and preceded by l
+*/
+static void step5(string& word, size_t startR1, size_t startR2)
+{
+    size_t size = word.size();
+    if(word[size - 1] == 'e')
+    {
+        if(size - 1 >= startR2)
+            word = word.substr(0, size - 1);
+        else if(size - 1 >= startR1 && !isShort(word.substr(0, size - 1)))
+            word = word.substr(0, size - 1);
+    }
+    else if(word[word.size() - 1] == 'l')
+    {
+        if(word.size() - 1 >= startR2 && word[word.size() - 2] == 'l')
+            word = word.substr(0, word.size() - 1);
+    }
+}
+
+/**
+ * Determines whether a word ends in a short syllable.
+ * Define a short syllable in a word as either
+ *
+ * (a) a vowel followed by a non-vowel other than w, x or Y and preceded by a non-vowel
+ * (b) a vowel at the beginning of the word followed by a non-vowel.
+ */
+static bool isShort(const string& word)
+{
+    size_t size = word.size();
+
+    if(size >= 3)
+    {
+        if(!isVowelY(word[size - 3]) && isVowelY(word[size - 2])
+                && !isVowelY(word[size - 1]) && word[size - 1] != 'w'
+                && word[size - 1] != 'x' && word[size - 1] != 'Y')
+        {
+            return true;
+        }
+    }
+    return size == 2 && isVowelY(word[0]) && !isVowelY(word[1]);
+}
+
+static bool special(string& word)
+{
+    static const std::unordered_map<string, string> exceptions =
+    {
+        {"skis", "ski"}, {"skies", "sky"}, {"dying", "die"}, {"lying", "lie"},
+        {"tying", "tie"}, {"idly", "idl"}, {"gently", "gentl"}, {"ugly", "ugli"},
+        {"early", "earli"}, {"only", "onli"}, {"singly", "singl"}
+    };
+
+    // special cases
+    auto ex = exceptions.find(word);
+    if(ex != exceptions.end())
+    {
+        word = ex->second;
+        return true;
+    }
+
+    // invariants
+    return word == "sky" || word == "news" || word == "howe" ||
+           word == "atlas" || word == "cosmos" || word == "bias" ||
+           word == "andes";
+}
+
+// Static helper functions (not in namespace)
+static bool isVowelY(char ch)
+{
+    return ch == 'e' || ch == 'a' || ch == 'i' ||
+           ch == 'o' || ch == 'u' || ch == 'y';
+}
+
+static bool isVowel(char ch)
+{
+    return ch == 'e' || ch == 'a' || ch == 'i' ||
+           ch == 'o' || ch == 'u';
+}
+
+static bool endsWith(const string& word, const string& str)
+{
+    return word.size() >= str.size() &&
+           word.substr(word.size() - str.size()) == str;
+}
+
+static bool endsInDouble(const string& word)
+{
+    if(word.size() >= 2)
+    {
+        char a = word[word.size() - 1];
+        char b = word[word.size() - 2];
+
+        if(a == b)
+        {
+            return a == 'b' || a == 'd' || a == 'f' || a == 'g' ||
+                   a == 'm' || a == 'n' || a == 'p' || a == 'r' || a == 't';
+        }
+    }
+
+    return false;
+}
+
+static bool replaceIfExists(string& word, const string& suffix, const string& replacement, size_t start)
+{
+    if(!(start > word.size())
+            && endsWith(word.substr(start, word.size() - start), suffix))
+    {
+        word = word.substr(0, word.size() - suffix.size()) + replacement;
+        return true;
+    }
+    return false;
+}
+
+static bool isValidLIEnding(char ch)
+{
+    return ch == 'c' || ch == 'd' || ch == 'e' || ch == 'g' || ch == 'h'
+           || ch == 'k' || ch == 'm' || ch == 'n' || ch == 'r' || ch == 't';
+}
+
+static bool containsVowel(const string& word, size_t start, size_t end)
+{
+    if(start <= end && end < word.size())
+    {
+        for(size_t i = start; i < end; ++i)
+        {
+            if(isVowelY(word[i]))
+                return true;
+        }
+    }
+    return false;
+}
+
+} // namespace porter2_reference
@@ -0,0 +1,26 @@
+#pragma once
+
+// Random lowercase words shared by the dictionary index tests.
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace test_words {
+
+// count words of 1..max_len letters drawn from the first alphabet_size
+// letters; small alphabets give many near neighbours
+inline std::vector<std::string> random_words(std::mt19937& gen, size_t count, size_t max_len,
+                                             int alphabet_size) {
+    std::uniform_int_distribution<size_t> len_dist(1, max_len);
+    std::uniform_int_distribution<int> char_dist(0, alphabet_size - 1);
+    std::vector<std::string> words;
+    for (size_t i = 0; i < count; ++i) {
+        std::string w(len_dist(gen), 'a');
+        for (auto& c : w) c = static_cast<char>('a' + char_dist(gen));
+        words.push_back(w);
+    }
+    return words;
+}
+
+} // namespace test_words
@@ -0,0 +1,132 @@
+/**
+ * @file similarity_matrix_test.cpp
+ * @brief Tests for the all-pairs similarity engine
+ */
+
+#include <gtest/gtest.h>
+#include "parsers/similarity_matrix.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace alga;
+using namespace alga::similarity;
+
+namespace {
+    std::vector<std::string> random_records(std::mt19937& gen, size_t count) {
+        static const std::vector<std::string> names = {
+            "jonathan", "johnathan", "jon", "smith", "smyth", "martha", "marhta",
+            "catherine", "katherine", "kathryn", "", "a", "alexander", "alexandra"
+        };
+        std::uniform_int_distribution<size_t> pick(0, names.size() - 1);
+        std::uniform_int_distribution<int> edit(0, 5);
+        std::vector<std::string> records;
+        for (size_t i = 0; i < count; ++i) {
+            std::string r = names[pick(gen)];
+            // Sprinkle typos so there is a spread of distances
+            if (!r.empty() && edit(gen) == 0) r[gen() % r.size()] = 'x';
+            if (edit(gen) == 0) r += static_cast<char>('a' + gen() % 26);
+            records.push_back(r);
+        }
+        return records;
+    }
+
+    double pair_score(pair_metric metric, std::string_view a, std::string_view b) {
+        switch (metric) {
+            case pair_metric::levenshtein: return static_cast<double>(levenshtein_distance(a, b));
+            case pair_metric::damerau_levenshtein: return static_cast<double>(damerau_levenshtein_distance(a, b));
+            case pair_metric::jaro_winkler: return jaro_winkler_similarity(a, b);
+            case pair_metric::lcs: return lcs_similarity(a, b);
+        }
+        return 0;
+    }
+
+    std::vector<similar_pair> nested_loops(std::vector<std::string_view> const& strings,
+                                           pair_metric metric, double threshold) {
+        bool is_distance = metric == pair_metric::levenshtein || metric == pair_metric::damerau_levenshtein;
+        std::vector<similar_pair> pairs;
+        for (size_t i = 0; i < strings.size(); ++i) {
+            for (size_t j = i + 1; j < strings.size(); ++j) {
+                double score = pair_score(metric, strings[i], strings[j]);
+                if (is_distance ? score <= threshold : score >= threshold) {
+                    pairs.push_back({i, j, score});
+                }
+            }
+        }
+        return pairs;
+    }
+
+    void expect_same_pairs(std::vector<similar_pair> const& actual, std::vector<similar_pair> const& expected) {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t k = 0; k < actual.size(); ++k) {
+            ASSERT_EQ(actual[k].first, expected[k].first);
+            ASSERT_EQ(actual[k].second, expected[k].second);
+            ASSERT_DOUBLE_EQ(actual[k].score, expected[k].score);
+        }
+    }
+}
+
+TEST(SimilarityMatrixTest, EmptyAndSingleInput) {
+    std::vector<std::string_view> none;
+    EXPECT_TRUE(similarity_matrix(none, pair_metric::levenshtein, 2).empty());
+    std::vector<std::string_view> one = {"alone"};
+    EXPECT_TRUE(similarity_matrix(one, pair_metric::jaro_winkler, 0).empty());
+}
+
+TEST(SimilarityMatrixTest, SmallExample) {
+    std::vector<std::string_view> names = {"martha", "dwayne", "marhta", "duane", "martha"};
+    auto pairs = similarity_matrix(names, pair_metric::damerau_levenshtein, 1);
+    std::vector<similar_pair> expected = {{0, 2, 1}, {0, 4, 0}, {2, 4, 1}};
+    EXPECT_EQ(pairs, expected);
+
+    auto close = similarity_matrix(names, pair_metric::jaro_winkler, 0.8);
+    ASSERT_EQ(close.size(), 4UL);
+    EXPECT_EQ(close[2].first, 1UL);
+    EXPECT_EQ(close[2].second, 3UL);
+}
+
+TEST(SimilarityMatrixTest, NegativeDistanceThresholdKeepsNothing) {
+    std::vector<std::string_view> same = {"x", "x"};
+    EXPECT_TRUE(similarity_matrix(same, pair_metric::levenshtein, -1).empty());
+}
+
+TEST(SimilarityMatrixTest, LongRepetitiveStrings) {
+    // Buckets past 255 characters disable the histogram bound but not the result
+    std::vector<std::string> records = {std::string(300, 'a'), std::string(299, 'a') + "b",
+                                        std::string(300, 'b'), std::string(301, 'a')};
+    std::vector<std::string_view> strings(records.begin(), records.end());
+    for (auto metric : {pair_metric::levenshtein, pair_metric::lcs}) {
+        double threshold = metric == pair_metric::levenshtein ? 1 : 0.99;
+        expect_same_pairs(similarity_matrix(strings, metric, threshold), nested_loops(strings, metric, threshold));
+    }
+}
+
+struct MatrixCase {
+    pair_metric metric;
+    double threshold;
+};
+
+class SimilarityMatrixMetricTest : public ::testing::TestWithParam<MatrixCase> {};
+
+TEST_P(SimilarityMatrixMetricTest, MatchesNestedLoops) {
+    std::mt19937 gen(17);
+    auto records = random_records(gen, 400);
+    std::vector<std::string_view> strings(records.begin(), records.end());
+    auto expected = nested_loops(strings, GetParam().metric, GetParam().threshold);
+
+    auto sequential = similarity_matrix(strings, GetParam().metric, GetParam().threshold);
+    expect_same_pairs(sequential, expected);
+
+    thread_pool pool(3);
+    auto parallel = similarity_matrix(strings, GetParam().metric, GetParam().threshold,
+                                      {.pool = &pool, .tile = 7, .parallel_threshold = 1});
+    expect_same_pairs(parallel, expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(Metrics, SimilarityMatrixMetricTest, ::testing::Values(
+    MatrixCase{pair_metric::levenshtein, 0},
+    MatrixCase{pair_metric::levenshtein, 2},
+    MatrixCase{pair_metric::damerau_levenshtein, 1},
+    MatrixCase{pair_metric::jaro_winkler, 0.85},
+    MatrixCase{pair_metric::jaro_winkler, 0.0},
+    MatrixCase{pair_metric::lcs, 0.75}));
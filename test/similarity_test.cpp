@@ -6,6 +6,9 @@
 #include <gtest/gtest.h>
 #include "parsers/similarity.hpp"
 #include <string>
+#include <optional>
+#include <random>
+#include <vector>
 
 using namespace alga;
 using namespace alga::similarity;
@@ -219,6 +222,236 @@ TEST_F(DamerauLevenshteinTest, MultipleEdits) {
     EXPECT_EQ(damerau_levenshtein_distance("kitten", "sitting"), 3UL);
 }
 
+// ============================================================================
+// Bit-parallel Edit Distance Tests
+// ============================================================================
+
+namespace {
+    // Textbook DP, kept as the oracle for the bit-vector implementations
+    size_t reference_edit_distance(std::string_view a, std::string_view b, bool transpositions) {
+        std::vector<std::vector<size_t>> dp(a.size() + 1, std::vector<size_t>(b.size() + 1));
+        for (size_t i = 0; i <= a.size(); ++i) dp[i][0] = i;
+        for (size_t j = 0; j <= b.size(); ++j) dp[0][j] = j;
+        for (size_t i = 1; i <= a.size(); ++i) {
+            for (size_t j = 1; j <= b.size(); ++j) {
+                size_t cost = a[i - 1] == b[j - 1] ? 0 : 1;
+                dp[i][j] = std::min({dp[i - 1][j] + 1, dp[i][j - 1] + 1, dp[i - 1][j - 1] + cost});
+                if (transpositions && i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) {
+                    dp[i][j] = std::min(dp[i][j], dp[i - 2][j - 2] + cost);
+                }
+            }
+        }
+        return dp[a.size()][b.size()];
+    }
+
+    std::string random_string(std::mt19937& gen, size_t max_len, std::string_view alphabet) {
+        std::uniform_int_distribution<size_t> len_dist(0, max_len);
+        std::uniform_int_distribution<size_t> char_dist(0, alphabet.size() - 1);
+        std::string s(len_dist(gen), ' ');
+        for (auto& c : s) c = alphabet[char_dist(gen)];
+        return s;
+    }
+}
+
+class BitParallelEditDistanceTest : public ::testing::TestWithParam<size_t> {};
+
+TEST_P(BitParallelEditDistanceTest, MatchesDynamicProgramming) {
+    std::mt19937 gen(static_cast<unsigned>(GetParam()));
+    edit_distance_workspace workspace;
+    for (int trial = 0; trial < 300; ++trial) {
+        std::string a = random_string(gen, GetParam(), "abc");
+        std::string b = random_string(gen, GetParam(), "abc");
+        // Mutate a copy too, so near-identical pairs are well covered
+        std::string c = a;
+        if (!c.empty()) {
+            std::swap(c[trial % c.size()], c[(trial * 7) % c.size()]);
+            c.insert(c.begin() + static_cast<long>(trial % c.size()), 'd');
+        }
+
+        ASSERT_EQ(levenshtein_distance(a, b), reference_edit_distance(a, b, false)) << a << " / " << b;
+        ASSERT_EQ(levenshtein_distance(a, c, workspace), reference_edit_distance(a, c, false)) << a << " / " << c;
+        ASSERT_EQ(damerau_levenshtein_distance(a, b), reference_edit_distance(a, b, true)) << a << " / " << b;
+        ASSERT_EQ(damerau_levenshtein_distance(a, c, workspace), reference_edit_distance(a, c, true)) << a << " / " << c;
+    }
+}
+
+// Max lengths straddling the single-word and multi-word block boundaries
+INSTANTIATE_TEST_SUITE_P(Lengths, BitParallelEditDistanceTest,
+                         ::testing::Values(8, 63, 64, 65, 130, 200));
+
+TEST(BitParallelEditDistance, FullByteRange) {
+    std::string a, b;
+    for (int i = 0; i < 256; ++i) a += static_cast<char>(i);
+    for (int i = 255; i >= 0; i -= 2) b += static_cast<char>(i);
+    EXPECT_EQ(levenshtein_distance(a, b), reference_edit_distance(a, b, false));
+    EXPECT_EQ(damerau_levenshtein_distance(a, b), reference_edit_distance(a, b, true));
+}
+
+TEST(BitParallelEditDistance, WorkspaceReuseAcrossLengths) {
+    edit_distance_workspace workspace;
+    std::string long_a(300, 'x');
+    std::string long_b = long_a;
+    long_b[150] = 'y';
+    EXPECT_EQ(levenshtein_distance(long_a, long_b, workspace), 1UL);
+    EXPECT_EQ(levenshtein_distance("kitten", "sitting", workspace), 3UL);
+    EXPECT_EQ(damerau_levenshtein_distance(long_a + "ab", long_a + "ba", workspace), 1UL);
+    EXPECT_EQ(damerau_levenshtein_distance("ca", "abc", workspace), 3UL);  // OSA, not unrestricted DL
+}
+
+TEST(BoundedEditDistance, MatchesFullDistanceUnderCutoff) {
+    std::mt19937 gen(2024);
+    edit_distance_workspace workspace;
+    for (int trial = 0; trial < 2000; ++trial) {
+        std::string a = random_string(gen, trial < 1000 ? 12 : 90, "abcd");
+        std::string b = random_string(gen, trial < 1000 ? 12 : 90, "abcd");
+        size_t lev = reference_edit_distance(a, b, false);
+        size_t osa = reference_edit_distance(a, b, true);
+        for (size_t k : {0UL, 1UL, 2UL, 3UL, 5UL, 8UL, 40UL}) {
+            auto bounded_lev = levenshtein_distance_bounded(a, b, k, workspace);
+            auto bounded_osa = damerau_levenshtein_distance_bounded(a, b, k);
+            ASSERT_EQ(bounded_lev, lev <= k ? std::optional<size_t>(lev) : std::nullopt)
+                << a << " / " << b << " k=" << k;
+            ASSERT_EQ(bounded_osa, osa <= k ? std::optional<size_t>(osa) : std::nullopt)
+                << a << " / " << b << " k=" << k;
+        }
+    }
+}
+
+TEST(BoundedEditDistance, EarlyExits) {
+    EXPECT_FALSE(levenshtein_distance_bounded("a", "abcdef", 2).has_value());
+    EXPECT_EQ(levenshtein_distance_bounded("", "ab", 2), 2UL);
+    EXPECT_EQ(levenshtein_distance_bounded("kitten", "sitting", 3), 3UL);
+    EXPECT_FALSE(levenshtein_distance_bounded("kitten", "sitting", 2).has_value());
+    EXPECT_EQ(damerau_levenshtein_distance_bounded("form", "from", 1), 1UL);
+    EXPECT_FALSE(damerau_levenshtein_distance_bounded("abcdefgh", "hgfedcba", 3).has_value());
+
+    std::string long_a(5000, 'a');
+    std::string long_b = long_a;
+    long_b[2500] = 'b';
+    EXPECT_EQ(levenshtein_distance_bounded(long_a, long_b, 1), 1UL);
+}
+
+TEST(BoundedEditDistance, AreSimilarLengthPrefilter) {
+    // Length ratio alone rules these out without computing Jaro-Winkler
+    EXPECT_FALSE(are_similar("ab", "abcdefghijklmnop", 0.8));
+    for (auto [a, b] : {std::pair{"martha", "marhta"}, {"dwayne", "duane"}, {"dixon", "dicksonx"},
+                        {"a", "ab"}, {"abc", "abcdefgh"}}) {
+        for (double threshold : {0.5, 0.7, 0.8, 0.9}) {
+            EXPECT_EQ(are_similar(a, b, threshold), jaro_winkler_similarity(a, b) >= threshold)
+                << a << " / " << b << " @ " << threshold;
+        }
+    }
+}
+
+// ============================================================================
+// Bit-parallel LCS Tests
+// ============================================================================
+
+namespace {
+    size_t reference_lcs(std::string_view a, std::string_view b) {
+        std::vector<std::vector<size_t>> dp(a.size() + 1, std::vector<size_t>(b.size() + 1, 0));
+        for (size_t i = 1; i <= a.size(); ++i) {
+            for (size_t j = 1; j <= b.size(); ++j) {
+                dp[i][j] = a[i - 1] == b[j - 1] ? dp[i - 1][j - 1] + 1 : std::max(dp[i - 1][j], dp[i][j - 1]);
+            }
+        }
+        return dp[a.size()][b.size()];
+    }
+
+    // Strictly increasing in both strings and matching characters
+    bool is_common_subsequence(std::vector<std::pair<size_t, size_t>> const& pairs,
+                               std::string_view a, std::string_view b) {
+        for (size_t k = 0; k < pairs.size(); ++k) {
+            auto [i, j] = pairs[k];
+            if (i >= a.size() || j >= b.size() || a[i] != b[j]) return false;
+            if (k > 0 && (i <= pairs[k - 1].first || j <= pairs[k - 1].second)) return false;
+        }
+        return true;
+    }
+}
+
+class BitParallelLcsTest : public ::testing::TestWithParam<size_t> {};
+
+TEST_P(BitParallelLcsTest, MatchesDynamicProgramming) {
+    std::mt19937 gen(static_cast<unsigned>(GetParam()) + 100);
+    edit_distance_workspace workspace;
+    for (int trial = 0; trial < 200; ++trial) {
+        std::string a = random_string(gen, GetParam(), "abcd");
+        std::string b = random_string(gen, GetParam() + trial % 7, "abcd");
+        size_t expected = reference_lcs(a, b);
+        ASSERT_EQ(lcs_length(a, b, workspace), expected) << a << " / " << b;
+
+        auto pairs = lcs_alignment(a, b, workspace);
+        ASSERT_EQ(pairs.size(), expected) << a << " / " << b;
+        ASSERT_TRUE(is_common_subsequence(pairs, a, b)) << a << " / " << b;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Lengths, BitParallelLcsTest,
+                         ::testing::Values(8, 63, 64, 65, 130, 200));
+
+TEST(BitParallelLcs, DocumentRevisions) {
+    std::mt19937 gen(42);
+    std::string original = random_string(gen, 0, "x");
+    while (original.size() < 20000) original += random_string(gen, 12, "abcdefghij ");
+    std::string revised = original;
+    for (size_t k = 0; k < 200; ++k) {
+        size_t at = (k * 7919) % revised.size();
+        if (k % 2) revised.erase(at, 3); else revised.insert(at, "XYZ");
+    }
+
+    size_t length = lcs_length(original, revised);
+    auto pairs = lcs_alignment(original, revised);
+    EXPECT_EQ(pairs.size(), length);
+    EXPECT_TRUE(is_common_subsequence(pairs, original, revised));
+    EXPECT_GE(length, original.size() - 300);
+}
+
+// ============================================================================
+// Bitmask Jaro Tests
+// ============================================================================
+
+TEST(BitmaskJaro, MatchesScalarAlgorithm) {
+    std::mt19937 gen(12);
+    for (size_t max_len : {5UL, 20UL, 64UL}) {
+        for (int trial = 0; trial < 2000; ++trial) {
+            std::string a = random_string(gen, max_len, "abcd");
+            std::string b = random_string(gen, max_len, "abcd");
+            if (a.empty() || b.empty()) continue;
+            ASSERT_DOUBLE_EQ(jaro_similarity(a, b), detail::jaro_scalar(a, b)) << a << " / " << b;
+        }
+    }
+}
+
+TEST(BitmaskJaro, PatternMatchesPairwise) {
+    std::mt19937 gen(3);
+    for (int trial = 0; trial < 200; ++trial) {
+        std::string query = random_string(gen, trial % 2 ? 64 : 90, "abcde");
+        jaro_pattern pattern(query);
+        for (int c = 0; c < 20; ++c) {
+            std::string candidate = random_string(gen, c % 2 ? 64 : 80, "abcdef");
+            ASSERT_DOUBLE_EQ(pattern.jaro(candidate), jaro_similarity(query, candidate))
+                << query << " / " << candidate;
+            ASSERT_DOUBLE_EQ(pattern.jaro_winkler(candidate), jaro_winkler_similarity(query, candidate));
+        }
+    }
+}
+
+TEST(BitmaskJaro, BatchScoresEveryCandidate) {
+    std::vector<std::string_view> candidates = {"MARHTA", "MARTHA", "", "XYZ", "MARTHAS"};
+    std::vector<double> jaro(candidates.size());
+    std::vector<double> jw(candidates.size());
+    jaro_similarity_batch("MARTHA", candidates, jaro);
+    jaro_winkler_similarity_batch("MARTHA", candidates, jw);
+
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        EXPECT_DOUBLE_EQ(jaro[i], jaro_similarity("MARTHA", candidates[i]));
+        EXPECT_DOUBLE_EQ(jw[i], jaro_winkler_similarity("MARTHA", candidates[i]));
+    }
+    EXPECT_DOUBLE_EQ(jaro[1], 1.0);
+    EXPECT_DOUBLE_EQ(jaro[2], 0.0);
+}
+
 // ============================================================================
 // Convenience Functions
 // ============================================================================
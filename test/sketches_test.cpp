@@ -0,0 +1,323 @@
+/**
+ * @file sketches_test.cpp
+ * @brief Tests for streaming frequency and quantile sketches
+ */
+
+#include <gtest/gtest.h>
+#include "parsers/sketches.hpp"
+#include "parsers/numeric_parsers.hpp"
+#include <algorithm>
+#include <random>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace alga;
+using namespace alga::statistics;
+
+namespace {
+    // Zipf-distributed integers: a few heavy hitters and a long tail
+    std::vector<int> zipf_stream(size_t count, uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<double> u(0.0, 1.0);
+        std::vector<int> stream;
+        stream.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            stream.push_back(static_cast<int>(1.0 / (u(gen) + 1e-4)));
+        }
+        return stream;
+    }
+}
+
+TEST(SpaceSavingTest, ExactWhileUnderCapacity) {
+    SpaceSaving<std::string> tracker(10);
+    FrequencyCounter<std::string> exact;
+    for (auto w : {"a", "b", "a", "c", "a", "b"}) {
+        tracker.add(w);
+        exact.add(w);
+    }
+    EXPECT_EQ(tracker.most_common(), exact.most_common());
+    EXPECT_EQ(tracker.guaranteed_count("a"), 3UL);
+    EXPECT_EQ(tracker.mode(), std::optional<std::string>("a"));
+    EXPECT_EQ(tracker.total(), 6UL);
+    EXPECT_EQ(tracker.count("z"), 0UL);
+}
+
+TEST(SpaceSavingTest, HeavyHittersWithinErrorBounds) {
+    auto stream = zipf_stream(200000, 11);
+    const size_t capacity = 200;
+    SpaceSaving<int> tracker(capacity);
+    FrequencyCounter<int> exact;
+    for (size_t i = 0; i < stream.size(); ++i) {
+        tracker.add(stream[i]);
+        exact.add(stream[i]);
+        if (i == stream.size() / 2) {
+            // Answerable mid-stream
+            EXPECT_EQ(tracker.top_n(1)[0].first, exact.top_n(1)[0].first);
+        }
+    }
+
+    EXPECT_EQ(tracker.unique_count(), capacity);
+    const size_t threshold = stream.size() / capacity;
+    for (auto const& [item, count] : exact.get_counts()) {
+        if (count > threshold) {
+            ASSERT_TRUE(tracker.contains(item)) << item;
+        }
+    }
+    for (auto const& e : tracker.entries()) {
+        size_t truth = exact.count(e.item);
+        EXPECT_GE(e.count, truth);
+        EXPECT_LE(e.count - e.error, truth);
+    }
+
+    auto top = tracker.top_n(5);
+    auto expected = exact.top_n(5);
+    for (size_t i = 0; i < 5; ++i) EXPECT_EQ(top[i].first, expected[i].first);
+}
+
+TEST(SpaceSavingTest, StringViewItemsAreOwned) {
+    SpaceSaving<std::string_view> tracker(2);
+    std::string buffer;
+    for (auto w : {"x", "y", "x", "z", "x", "a-much-longer-token-than-sso"}) {
+        buffer = w;
+        tracker.add(buffer);
+    }
+    buffer = "garbage";
+
+    EXPECT_EQ(tracker.count("x"), 3UL);
+    auto copy = tracker;
+    tracker.clear();
+    auto entries = copy.entries();
+    ASSERT_EQ(entries.size(), 2UL);
+    // Both at 3, so in element order; the long token inherited z's 2
+    EXPECT_EQ(entries[0], (SpaceSaving<std::string_view>::entry{"a-much-longer-token-than-sso", 3, 2}));
+    EXPECT_EQ(entries[1], (SpaceSaving<std::string_view>::entry{"x", 3, 0}));
+}
+
+TEST(SpaceSavingTest, StringViewResultsSurviveEviction) {
+    SpaceSaving<std::string_view> tracker(2);
+    tracker.add("first-token-long-enough-to-allocate");
+    tracker.add("second-token-long-enough-to-allocate", 2);
+    auto top = tracker.top_n(2);
+    auto mode = tracker.mode();
+
+    // Evicts the first token's counter, then replaces every counter
+    tracker.add("third-token-long-enough-to-allocate");
+    SpaceSaving<std::string_view> other(2);
+    other.add("fourth-token-long-enough-to-allocate", 5);
+    tracker.merge(other);
+
+    ASSERT_EQ(top.size(), 2UL);
+    EXPECT_EQ(top[0].first, "second-token-long-enough-to-allocate");
+    EXPECT_EQ(top[1].first, "first-token-long-enough-to-allocate");
+    EXPECT_EQ(mode, std::optional<std::string>("second-token-long-enough-to-allocate"));
+}
+
+TEST(CountMinSketchTest, OverestimatesWithinBound) {
+    auto stream = zipf_stream(100000, 12);
+    CountMinSketch<int> sketch(1e-3, 1e-3);
+    CountMinSketch<int> left(1e-3, 1e-3);
+    CountMinSketch<int> right(1e-3, 1e-3);
+    FrequencyCounter<int> exact;
+    for (size_t i = 0; i < stream.size(); ++i) {
+        sketch.add(stream[i]);
+        (i % 2 ? left : right).add(stream[i]);
+        exact.add(stream[i]);
+    }
+    EXPECT_EQ(sketch.total(), stream.size());
+
+    const double bound = 1e-3 * static_cast<double>(stream.size());
+    size_t over_bound = 0;
+    for (auto const& [item, count] : exact.get_counts()) {
+        size_t estimate = sketch.count(item);
+        ASSERT_GE(estimate, count);
+        if (static_cast<double>(estimate - count) > bound) ++over_bound;
+    }
+    EXPECT_LE(over_bound, exact.unique_count() / 100);
+
+    // Merging halves gives the sketch of the whole stream
+    ASSERT_TRUE(left.merge(right));
+    for (int item : {1, 2, 3, 50, 9999}) EXPECT_EQ(left.count(item), sketch.count(item));
+    EXPECT_FALSE(left.merge(CountMinSketch<int>(0.1, 0.1)));
+}
+
+TEST(HyperLogLogTest, EstimatesDistinctCount) {
+    HyperLogLog<int> whole(12);
+    HyperLogLog<int> left(12);
+    HyperLogLog<int> right(12);
+    EXPECT_EQ(whole.unique_count(), 0UL);
+
+    const int distinct = 100000;
+    for (int i = 0; i < distinct; ++i) {
+        whole.add(i);
+        whole.add(i);  // Repeats do not count
+        (i % 3 ? left : right).add(i);
+    }
+    const double error = std::abs(static_cast<double>(whole.unique_count()) - distinct) / distinct;
+    EXPECT_LT(error, 3 * whole.relative_error());
+
+    ASSERT_TRUE(left.merge(right));
+    EXPECT_EQ(left.unique_count(), whole.unique_count());
+    EXPECT_FALSE(left.merge(HyperLogLog<int>(10)));
+
+    HyperLogLog<std::string> small = HyperLogLog<std::string>::for_error(0.02);
+    for (auto w : {"a", "b", "c", "a"}) small.add(w);
+    EXPECT_EQ(small.unique_count(), 3UL);  // Exact for tiny cardinalities
+}
+
+TEST(HyperLogLogTest, UnbiasedNearLinearCountingCrossover) {
+    // Around 2.5 * 2^p the raw HyperLogLog estimate is biased upward by
+    // several times its standard error; averaged over seeds it must vanish
+    for (unsigned p : {10u, 14u}) {
+        const size_t distinct = static_cast<size_t>(2.6 * static_cast<double>(size_t(1) << p));
+        const int seeds = 20;
+        double bias = 0.0;
+        double error = 0.0;
+        for (int s = 0; s < seeds; ++s) {
+            HyperLogLog<uint64_t> sketch(p, 1000 + s);
+            for (size_t i = 0; i < distinct; ++i) sketch.add(s * 1000000007ULL + i);
+            bias += (static_cast<double>(sketch.unique_count()) - distinct) / distinct / seeds;
+            error = sketch.relative_error();
+        }
+        EXPECT_LT(std::abs(bias), 0.5 * error) << "precision " << p;
+    }
+}
+
+TEST(SpaceSavingTest, MergeKeepsGuarantees) {
+    auto stream = zipf_stream(100000, 13);
+    auto left = SpaceSaving<int>::for_error(0.005);
+    auto right = SpaceSaving<int>::for_error(0.005);
+    FrequencyCounter<int> exact;
+    for (size_t i = 0; i < stream.size(); ++i) {
+        (i < stream.size() / 3 ? left : right).add(stream[i]);
+        exact.add(stream[i]);
+    }
+    left.merge(right);
+    EXPECT_EQ(left.total(), stream.size());
+    EXPECT_LE(left.unique_count(), left.capacity());
+    for (auto const& e : left.entries()) {
+        size_t truth = exact.count(e.item);
+        EXPECT_GE(e.count, truth);
+        EXPECT_LE(e.count - e.error, truth);
+    }
+    auto top = left.top_n(3);
+    auto expected = exact.top_n(3);
+    for (size_t i = 0; i < 3; ++i) EXPECT_EQ(top[i].first, expected[i].first);
+}
+
+TEST(FrequencySketchTest, ApproximatesExactAnalysis) {
+    auto stream = zipf_stream(200000, 14);
+    FrequencySketch<int> sketch({.epsilon = 1e-4, .heavy_hitters = 2000});
+    FrequencySketch<int> left({.epsilon = 1e-4, .heavy_hitters = 2000});
+    FrequencySketch<int> right({.epsilon = 1e-4, .heavy_hitters = 2000});
+    FrequencyCounter<int> exact;
+    for (size_t i = 0; i < stream.size(); ++i) {
+        sketch.add(stream[i]);
+        (i % 2 ? left : right).add(stream[i]);
+        exact.add(stream[i]);
+    }
+
+    EXPECT_EQ(sketch.total(), exact.total());
+    EXPECT_EQ(sketch.mode(), exact.mode());
+    EXPECT_GE(sketch.count(1), exact.count(1));
+    EXPECT_NEAR(sketch.frequency(1), exact.frequency(1), 1e-3);
+    EXPECT_NEAR(static_cast<double>(sketch.unique_count()), static_cast<double>(exact.unique_count()),
+                0.05 * static_cast<double>(exact.unique_count()));
+    EXPECT_NEAR(type_token_ratio(sketch), type_token_ratio(exact), 0.05 * type_token_ratio(exact));
+    EXPECT_NEAR(shannon_entropy(sketch), shannon_entropy(exact), 0.05 * shannon_entropy(exact));
+    EXPECT_NEAR(normalized_entropy(sketch), normalized_entropy(exact), 0.05);
+    EXPECT_NEAR(simpson_diversity(sketch), simpson_diversity(exact), 0.01);
+
+    ASSERT_TRUE(left.merge(right));
+    EXPECT_EQ(left.total(), sketch.total());
+    EXPECT_GE(left.count(1), exact.count(1));
+    EXPECT_EQ(left.unique_count(), sketch.unique_count());
+    EXPECT_FALSE(left.merge(FrequencySketch<int>({.precision = 10})));
+
+    sketch.clear();
+    EXPECT_EQ(sketch.total(), 0UL);
+    EXPECT_EQ(shannon_entropy(sketch), 0.0);
+    EXPECT_FALSE(sketch.mode().has_value());
+}
+
+TEST(QuantileSketchTest, RankErrorStaysSmall) {
+    std::mt19937 gen(15);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    QuantileSketch<double> whole;
+    QuantileSketch<double> left;
+    QuantileSketch<double> right;
+    std::vector<double> values;
+    for (int i = 0; i < 200000; ++i) {
+        double v = u(gen);
+        values.push_back(v);
+        whole.add(v);
+        (i % 4 ? left : right).add(v);
+    }
+    left.merge(right);
+    EXPECT_LT(whole.retained(), 2000UL);
+    EXPECT_EQ(left.count(), values.size());
+
+    std::sort(values.begin(), values.end());
+    auto rank_of = [&](double v) {
+        return static_cast<double>(std::upper_bound(values.begin(), values.end(), v) - values.begin()) /
+               static_cast<double>(values.size());
+    };
+    for (double q : {0.0, 0.01, 0.25, 0.5, 0.75, 0.99, 1.0}) {
+        EXPECT_NEAR(rank_of(*whole.quantile(q)), q, 0.02) << q;
+        EXPECT_NEAR(rank_of(*left.quantile(q)), q, 0.02) << q;
+    }
+    EXPECT_NEAR(whole.rank(0.3), 0.3, 0.02);
+}
+
+TEST(QuantileSketchTest, ExactWhenSmall) {
+    QuantileSketch<int> sketch;
+    EXPECT_FALSE(sketch.median().has_value());
+    sketch.add_all(std::vector<int>{5, 1, 4, 2, 3});
+    EXPECT_EQ(sketch.median(), 3);
+    EXPECT_EQ(sketch.quantile(0.0), 1);
+    EXPECT_EQ(sketch.quantile(1.0), 5);
+    sketch.clear();
+    EXPECT_TRUE(sketch.empty());
+}
+
+TEST(StreamingSummaryTest, MatchesNumericSummary) {
+    std::vector<int> data = {4, 8, 15, 16, 23, 42, 7};
+    StreamingSummary<int> streaming;
+    streaming.add_all(data);
+
+    auto exact = numeric_summary(data);
+    auto approx = streaming.summary();
+    ASSERT_TRUE(approx.has_value());
+    EXPECT_EQ(approx->count, exact->count);
+    EXPECT_EQ(approx->min, exact->min);
+    EXPECT_EQ(approx->max, exact->max);
+    EXPECT_DOUBLE_EQ(approx->mean, exact->mean);
+    EXPECT_NEAR(approx->variance, exact->variance, 1e-9);
+    EXPECT_EQ(approx->median, exact->median);
+
+    StreamingSummary<int> empty;
+    EXPECT_FALSE(empty.summary().has_value());
+}
+
+TEST(StreamingSummaryTest, IngestsParsedNumbersAndMerges) {
+    std::vector<std::string> tokens = {"1.5", "x", "2.5", "-4", "10", "", "3"};
+    auto parsed = tokens | std::views::transform([](std::string const& t) { return make_floating_point(t); });
+
+    StreamingSummary<double> first;
+    first.add_all(parsed);  // Failed parses are skipped
+    EXPECT_EQ(first.count(), 5UL);
+    EXPECT_DOUBLE_EQ(first.moments().min(), -4.0);
+
+    StreamingSummary<double> second;
+    second.add(make_signed_int("20"));
+    second.add(*make_unsigned_int("30"));
+    first.merge(second);
+
+    auto summary = first.summary();
+    ASSERT_TRUE(summary.has_value());
+    EXPECT_EQ(summary->count, 7UL);
+    EXPECT_DOUBLE_EQ(summary->max, 30.0);
+    EXPECT_DOUBLE_EQ(summary->mean, 63.0 / 7);
+    EXPECT_DOUBLE_EQ(summary->median, 3.0);
+}
@@ -8,8 +8,11 @@
 #include <gtest/gtest.h>
 #include "parsers/statistics.hpp"
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 #include <cmath>
+#include <random>
 
 using namespace alga;
 using namespace alga::statistics;
@@ -83,6 +86,22 @@ TEST_F(FrequencyCounterTest, MostCommon) {
     EXPECT_EQ(common[0].second, 3UL);
 }
 
+TEST_F(FrequencyCounterTest, LeastCommonBreaksTiesInElementOrder) {
+    FrequencyCounter<std::string> counter;
+    counter.add_all(std::vector<std::string>{"cherry", "banana", "apple", "date", "date"});
+
+    auto least = counter.least_common();
+    ASSERT_EQ(least.size(), 4UL);
+    EXPECT_EQ(least[0].first, "apple");
+    EXPECT_EQ(least[1].first, "banana");
+    EXPECT_EQ(least[2].first, "cherry");
+    EXPECT_EQ(least[3].first, "date");
+
+    auto most = counter.most_common();
+    EXPECT_EQ(most[1].first, "apple");
+    EXPECT_EQ(most[3].first, "cherry");
+}
+
 TEST_F(FrequencyCounterTest, TopN) {
     FrequencyCounter<int> counter;
     for (int i = 1; i <= 10; ++i) {
@@ -129,6 +148,50 @@ TEST_F(FrequencyCounterTest, Clear) {
     EXPECT_EQ(counter.unique_count(), 0UL);
 }
 
+TEST_F(FrequencyCounterTest, TopNAndModeAgreeWithFullSort) {
+    FrequencyCounter<int> counter;
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<int> dist(0, 300);
+    for (int i = 0; i < 5000; ++i) counter.add(dist(gen) % (1 + dist(gen)));
+
+    auto all = counter.most_common();
+    for (size_t n : {0UL, 1UL, 7UL, 50UL, all.size(), all.size() + 3}) {
+        auto top = counter.top_n(n);
+        ASSERT_EQ(top.size(), std::min(n, all.size()));
+        EXPECT_TRUE(std::equal(top.begin(), top.end(), all.begin())) << n;
+    }
+    EXPECT_EQ(counter.mode(), std::optional<int>(all[0].first));
+}
+
+TEST_F(FrequencyCounterTest, StringViewTokensFromReusedBuffer) {
+    FrequencyCounter<std::string_view> counter;
+    std::string buffer;
+    for (auto token : {"to", "be", "or", "not", "to", "be"}) {
+        buffer = token;
+        counter.add(buffer);
+    }
+    buffer.clear();
+
+    EXPECT_EQ(counter.count("to"), 2UL);
+    EXPECT_EQ(counter.count("not"), 1UL);
+    EXPECT_EQ(counter.unique_count(), 4UL);
+    EXPECT_EQ(counter.top_n(1)[0].second, 2UL);
+}
+
+TEST_F(FrequencyCounterTest, NodeBasedStoragePolicy) {
+    FrequencyCounter<int, std::unordered_map<int, size_t>> node_counter;
+    FrequencyCounter<int> flat_counter;
+    flat_counter.reserve(100);
+    for (int i = 0; i < 1000; ++i) {
+        node_counter.add(i % 37);
+        flat_counter.add(i % 37);
+    }
+    EXPECT_EQ(node_counter.unique_count(), flat_counter.unique_count());
+    EXPECT_DOUBLE_EQ(shannon_entropy(node_counter), shannon_entropy(flat_counter));
+    EXPECT_DOUBLE_EQ(gini_coefficient(node_counter), gini_coefficient(flat_counter));
+    EXPECT_EQ(hapax_legomena_count(node_counter), hapax_legomena_count(flat_counter));
+}
+
 // ============================================================================
 // Shannon Entropy Tests
 // ============================================================================
@@ -310,6 +373,39 @@ TEST_F(NumericSummaryTest, SingleValue) {
     EXPECT_DOUBLE_EQ(summary->variance, 0.0);
 }
 
+TEST_F(NumericSummaryTest, UnsortedInput) {
+    std::vector<int> data = {9, 1, 7, 3, 5, 8};
+
+    auto summary = numeric_summary(data);
+    ASSERT_TRUE(summary.has_value());
+
+    EXPECT_EQ(summary->min, 1);
+    EXPECT_EQ(summary->max, 9);
+    EXPECT_EQ(summary->median, 6);  // (5+7)/2
+    EXPECT_EQ(data.front(), 9);     // Input untouched
+}
+
+TEST_F(NumericSummaryTest, RunningStatsMergeMatchesSinglePass) {
+    // Large offset: a running sum of squares would lose the variance
+    RunningStats<double> whole;
+    RunningStats<double> left;
+    RunningStats<double> right;
+    for (int i = 0; i < 1000; ++i) {
+        double value = 1e9 + (i % 10);
+        whole.add(value);
+        (i < 300 ? left : right).add(value);
+    }
+    left.merge(right);
+    left.merge(RunningStats<double>{});
+
+    EXPECT_EQ(left.count(), 1000UL);
+    EXPECT_DOUBLE_EQ(left.min(), 1e9);
+    EXPECT_DOUBLE_EQ(left.max(), 1e9 + 9);
+    EXPECT_NEAR(left.mean(), whole.mean(), 1e-6);
+    EXPECT_NEAR(whole.variance(), 8.25, 1e-6);
+    EXPECT_NEAR(left.variance(), whole.variance(), 1e-6);
+}
+
 // ============================================================================
 // Gini Coefficient Tests
 // ============================================================================
@@ -0,0 +1,167 @@
+/**
+ * @file stem_batch_test.cpp
+ * @brief Tests for batch stemming and the thread pool behind it
+ */
+
+#include <gtest/gtest.h>
+#include "parsers/stem_batch.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace alga;
+
+namespace {
+    std::vector<std::string> make_tokens(size_t n)
+    {
+        static const std::vector<std::string> words = {
+            "running", "Connections", "generalizations", "happiness", "abc123",
+            "relational", "hopping", "", "skies", "nationalization", "it's", "DOGS"
+        };
+        std::vector<std::string> tokens;
+        for (size_t i = 0; i < n; ++i) {
+            tokens.push_back(words[i % words.size()] + (i % 5 == 0 ? "" : std::string(i % 3, 's')));
+        }
+        return tokens;
+    }
+
+    std::vector<string_view> views_of(std::vector<std::string> const& tokens)
+    {
+        return std::vector<string_view>(tokens.begin(), tokens.end());
+    }
+}
+
+// ============================================================================
+// thread_pool Tests
+// ============================================================================
+
+TEST(ThreadPoolTest, VisitsEveryIndexOnce) {
+    thread_pool pool(4);
+    std::vector<std::atomic<int>> visits(10007);
+    pool.parallel_for(visits.size(), 64, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) visits[i].fetch_add(1);
+    });
+    for (auto const& v : visits) ASSERT_EQ(v.load(), 1);
+}
+
+TEST(ThreadPoolTest, EmptyAndSingleChunkRunOnCaller) {
+    thread_pool pool(2);
+    int calls = 0;
+    pool.parallel_for(0, 16, [&](size_t, size_t) { ++calls; });
+    EXPECT_EQ(calls, 0);
+    pool.parallel_for(10, 16, [&](size_t begin, size_t end) {
+        ++calls;
+        EXPECT_EQ(begin, 0UL);
+        EXPECT_EQ(end, 10UL);
+    });
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(ThreadPoolTest, NoWorkersStillRunsEverything) {
+    thread_pool pool(0);
+    EXPECT_EQ(pool.concurrency(), 1UL);
+    size_t total = 0;
+    pool.parallel_for(1000, 7, [&](size_t begin, size_t end) { total += end - begin; });
+    EXPECT_EQ(total, 1000UL);
+}
+
+TEST(ThreadPoolTest, NestedLoopsComplete) {
+    thread_pool pool(3);
+    std::atomic<size_t> total{0};
+    pool.parallel_for(8, 1, [&](size_t, size_t) {
+        pool.parallel_for(100, 10, [&](size_t begin, size_t end) { total += end - begin; });
+    });
+    EXPECT_EQ(total.load(), 800UL);
+}
+
+TEST(ThreadPoolTest, ExceptionsReachTheCaller) {
+    thread_pool pool(3);
+    for (size_t throwing_chunk : {0UL, 5UL, 63UL}) {
+        std::atomic<size_t> ran{0};
+        EXPECT_THROW(pool.parallel_for(64, 1, [&](size_t begin, size_t) {
+            if (begin == throwing_chunk) throw std::runtime_error("chunk failed");
+            ++ran;
+        }), std::runtime_error);
+        EXPECT_LT(ran.load(), 64UL);
+    }
+
+    // The pool stays usable afterwards
+    std::atomic<size_t> total{0};
+    pool.parallel_for(100, 10, [&](size_t begin, size_t end) { total += end - begin; });
+    EXPECT_EQ(total.load(), 100UL);
+}
+
+// ============================================================================
+// stem_batch Tests
+// ============================================================================
+
+TEST(StemBatchTest, MatchesSingleWordStemming) {
+    auto tokens = make_tokens(500);
+    auto words = views_of(tokens);
+    std::vector<optional<porter2_stem>> out(words.size());
+
+    size_t stemmed = stem_batch(words, out);
+
+    size_t expected_valid = 0;
+    for (size_t i = 0; i < words.size(); ++i) {
+        auto expected = make_porter2_stem(words[i]);
+        expected_valid += expected.has_value();
+        ASSERT_EQ(out[i], expected) << "input: " << words[i];
+    }
+    EXPECT_EQ(stemmed, expected_valid);
+    EXPECT_LT(stemmed, words.size());
+}
+
+TEST(StemBatchTest, ParallelMatchesSequential) {
+    auto tokens = make_tokens(50000);
+    auto words = views_of(tokens);
+    std::vector<optional<porter2_stem>> sequential(words.size());
+    std::vector<optional<porter2_stem>> parallel(words.size());
+
+    thread_pool pool(4);
+    size_t a = stem_batch(words, sequential, {.parallel_threshold = words.size() + 1});
+    size_t b = stem_batch(words, parallel, {.pool = &pool, .parallel_threshold = 1, .grain = 333});
+
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(sequential, parallel);
+}
+
+TEST(StemBatchTest, InlineStorageWithCache) {
+    auto tokens = make_tokens(20000);
+    auto words = views_of(tokens);
+    std::vector<optional<inline_porter2_stem>> out(words.size());
+
+    stem_cache cache;
+    thread_pool pool(3);
+    stem_batch<inline_string<24>>(words, out, {.pool = &pool, .cache = &cache, .parallel_threshold = 1000});
+
+    for (size_t i = 0; i < words.size(); ++i) {
+        auto expected = make_porter2_stem(words[i]);
+        ASSERT_EQ(out[i].has_value(), expected.has_value());
+        if (expected) {
+            ASSERT_EQ(out[i]->view(), expected->view());
+        }
+    }
+    EXPECT_GT(cache.statistics().hit_rate(), 0.9);
+}
+
+TEST(StemBatchTest, OverwritesReusedOutput) {
+    std::vector<string_view> first = {"running", "jumps"};
+    std::vector<string_view> second = {"bad input", "walked"};
+    std::vector<optional<porter2_stem>> out(2);
+
+    stem_batch(first, out);
+    EXPECT_EQ(out[0]->view(), "run");
+    EXPECT_EQ(stem_batch(second, out), 1UL);
+    EXPECT_FALSE(out[0].has_value());
+    EXPECT_EQ(out[1]->view(), "walk");
+}
+
+TEST(StemBatchTest, RejectsShortOutput) {
+    std::vector<string_view> words = {"running", "jumps", "walked"};
+    std::vector<optional<porter2_stem>> out(2);
+    EXPECT_THROW(stem_batch(words, out), std::invalid_argument);
+    thread_pool pool(2);
+    EXPECT_THROW(stem_batch(words, out, {.pool = &pool, .parallel_threshold = 1}), std::invalid_argument);
+}
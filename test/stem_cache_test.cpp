@@ -0,0 +1,179 @@
+/**
+ * @file stem_cache_test.cpp
+ * @brief Tests for the memoizing CLOCK stem cache
+ */
+
+#include <gtest/gtest.h>
+#include "parsers/stem_cache.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace alga;
+
+namespace {
+    std::vector<std::string> sample_words(size_t n)
+    {
+        static const std::vector<std::string> suffixes = {
+            "", "s", "ing", "ed", "ation", "ness", "ful", "ly", "izer", "ement"
+        };
+        std::vector<std::string> words;
+        for (size_t i = 0; words.size() < n; ++i) {
+            std::string root;
+            for (size_t v = i; root.size() < 4 || v > 0; v /= 26) {
+                root += static_cast<char>('a' + v % 26);
+            }
+            words.push_back(root + suffixes[i % suffixes.size()]);
+        }
+        return words;
+    }
+}
+
+TEST(StemCacheTest, MatchesUncachedStemmer) {
+    stem_cache cache;
+    for (auto const& word : sample_words(2000)) {
+        // Second pass is served from the cache
+        for (int pass = 0; pass < 2; ++pass) {
+            auto cached = make_porter2_stem(word, cache);
+            auto direct = make_porter2_stem(word);
+            ASSERT_TRUE(cached.has_value());
+            ASSERT_EQ(*cached, *direct) << "input: " << word;
+        }
+    }
+}
+
+TEST(StemCacheTest, CountsHitsAndMisses) {
+    stem_cache cache;
+    make_porter2_stem("running", cache);
+    make_porter2_stem("Running", cache);
+    make_porter2_stem("RUNNING", cache);
+    make_porter2_stem("jumped", cache);
+
+    auto stats = cache.statistics();
+    EXPECT_EQ(stats.misses, 2U);
+    EXPECT_EQ(stats.hits, 2U);
+    EXPECT_EQ(stats.entries, 2UL);
+    EXPECT_DOUBLE_EQ(stats.hit_rate(), 0.5);
+}
+
+TEST(StemCacheTest, InvalidInputIsNotLookedUp) {
+    stem_cache cache;
+    EXPECT_FALSE(make_porter2_stem("hello123", cache).has_value());
+    EXPECT_FALSE(make_porter2_stem("two words", cache).has_value());
+    auto stats = cache.statistics();
+    EXPECT_EQ(stats.hits + stats.misses, 0U);
+}
+
+TEST(StemCacheTest, LongWordsUseStemmedPrefix) {
+    stem_cache cache;
+    std::string long_word(40, 'a');
+    auto cached = make_porter2_stem(long_word, cache);
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_EQ(*cached, *make_porter2_stem(long_word));
+    EXPECT_FALSE(make_porter2_stem(long_word + "1", cache).has_value());
+
+    // Direct calls with an over-long word stem its prefix too
+    std::string word = std::string(30, 'x') + "nationalization";
+    char out[64];
+    size_t length = cache.stem(word, out);
+    EXPECT_LE(length, porter2_max_word_length);
+    EXPECT_EQ(std::string_view(out, length), make_porter2_stem(word)->view());
+}
+
+TEST(StemCacheTest, StaysWithinByteBudget) {
+    stem_cache cache(16 * 1024, 4);
+    for (auto const& word : sample_words(5000)) {
+        make_porter2_stem(word, cache);
+    }
+    auto stats = cache.statistics();
+    EXPECT_LE(stats.bytes, cache.byte_budget());
+    EXPECT_GT(stats.evictions, 0U);
+    EXPECT_GT(stats.entries, 0UL);
+}
+
+TEST(StemCacheTest, ClockKeepsFrequentWords) {
+    // Roughly a hundred entries fit; far more one-off words stream through
+    stem_cache cache(8 * 1024, 1);
+    auto words = sample_words(3000);
+    std::vector<std::string> hot(words.begin(), words.begin() + 10);
+
+    for (size_t i = 10; i < words.size(); ++i) {
+        if (i % 10 == 0) {
+            for (auto const& w : hot) make_porter2_stem(w, cache);
+        }
+        make_porter2_stem(words[i], cache);
+    }
+    EXPECT_GT(cache.statistics().evictions, 1000U);
+
+    auto before = cache.statistics().hits;
+    for (auto const& w : hot) make_porter2_stem(w, cache);
+    EXPECT_EQ(cache.statistics().hits - before, hot.size());
+
+    cache.clear();
+    EXPECT_EQ(cache.statistics().entries, 0UL);
+    EXPECT_EQ(cache.statistics().hits, 0U);
+}
+
+TEST(StemCacheTest, ZeroBudgetCachesNothing) {
+    stem_cache cache(0);
+    EXPECT_EQ(*make_porter2_stem("running", cache), *make_porter2_stem("running"));
+    EXPECT_EQ(*make_porter2_stem("running", cache), *make_porter2_stem("running"));
+    EXPECT_EQ(cache.statistics().entries, 0UL);
+    EXPECT_EQ(cache.statistics().hits, 0U);
+}
+
+TEST(StemCacheTest, ConcurrentLookups) {
+    stem_cache cache(32 * 1024, 8);
+    auto words = sample_words(1000);
+    std::vector<std::string> expected;
+    for (auto const& w : words) {
+        expected.push_back(std::string(make_porter2_stem(w)->view()));
+    }
+
+    std::vector<int> mismatches(8, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < mismatches.size(); ++t) {
+        threads.emplace_back([&, t]() {
+            for (int round = 0; round < 5; ++round) {
+                for (size_t i = 0; i < words.size(); ++i) {
+                    auto stem = make_porter2_stem(words[(i * 7 + t) % words.size()], cache);
+                    if (!stem || stem->view() != expected[(i * 7 + t) % words.size()]) {
+                        ++mismatches[t];
+                    }
+                }
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    for (int m : mismatches) EXPECT_EQ(m, 0);
+    auto stats = cache.statistics();
+    EXPECT_EQ(stats.hits + stats.misses, 8U * 5U * words.size());
+    EXPECT_LE(stats.bytes, cache.byte_budget());
+}
+
+TEST(StemCacheTest, CachedStemmerInterface) {
+    stem_cache cache;
+    cached_porter2_stemmer stemmer(cache);
+    porter2_stemmer plain;
+
+    EXPECT_EQ(*stemmer("connections"), *plain("connections"));
+    EXPECT_EQ(*stemmer(*make_lc_alpha("connections")), *plain("connections"));
+    EXPECT_FALSE(stemmer("abc!").has_value());
+
+    std::string text = "Generalizations rest";
+    auto [rest, result] = stemmer.parse(text.begin(), text.end());
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->view(), "general");
+    EXPECT_EQ(*rest, ' ');
+
+    cached_inline_porter2_stemmer inline_stemmer(cache);
+    EXPECT_EQ(inline_stemmer("connections")->view(), "connect");
+    EXPECT_EQ(cache.statistics().hits, 2U);
+}
+
+TEST(StemCacheTest, DefaultsToGlobalCache) {
+    cached_porter2_stemmer stemmer;
+    EXPECT_EQ(stemmer.cache, &global_stem_cache());
+    EXPECT_EQ(stemmer("happiness")->view(), "happi");
+}
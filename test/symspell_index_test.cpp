@@ -0,0 +1,222 @@
+/**
+ * @file symspell_index_test.cpp
+ * @brief Tests for the symmetric-delete dictionary index and its matchers
+ */
+
+#include <gtest/gtest.h>
+#include "parsers/symspell_index.hpp"
+#include "parsers/fuzzy_parsers.hpp"
+#include "random_words.hpp"
+#include <array>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace alga;
+using namespace alga::similarity;
+using test_words::random_words;
+
+namespace {
+    size_t distance(std::string_view a, std::string_view b, edit_metric metric) {
+        return metric == edit_metric::levenshtein ? levenshtein_distance(a, b)
+                                                  : damerau_levenshtein_distance(a, b);
+    }
+
+    // Every distinct dictionary word within k, closest first then by position
+    std::vector<symspell_index::match> linear_within(std::vector<std::string> const& dictionary,
+                                                     std::string const& query, size_t k, edit_metric metric) {
+        std::vector<std::string> unique;
+        for (auto const& w : dictionary) {
+            if (std::find(unique.begin(), unique.end(), w) == unique.end()) unique.push_back(w);
+        }
+        std::vector<symspell_index::match> result;
+        for (size_t i = 0; i < unique.size(); ++i) {
+            size_t d = distance(query, unique[i], metric);
+            if (d <= k) result.push_back({i, d});
+        }
+        std::stable_sort(result.begin(), result.end(), [](auto const& a, auto const& b) {
+            return a.distance < b.distance;
+        });
+        return result;
+    }
+}
+
+TEST(SymSpellIndexTest, FindsWordsWithinDistance) {
+    symspell_index index({"hello", "help", "world", "word", "hello"}, 2);
+    EXPECT_EQ(index.size(), 4UL);
+    EXPECT_EQ(index[1], "help");
+
+    auto m = index.closest("helo", 2);
+    ASSERT_TRUE(m.has_value());
+    EXPECT_EQ(index[m->index], "hello");
+    EXPECT_EQ(m->distance, 1UL);
+
+    EXPECT_FALSE(index.closest("xyzzy", 2).has_value());
+    EXPECT_EQ(index.within("wrd", 1).size(), 1UL);
+}
+
+TEST(SymSpellIndexTest, TranspositionsWithDamerau) {
+    symspell_index index({"form", "from", "farm"}, 1);
+    auto lev = index.within("fomr", 1, edit_metric::levenshtein);
+    auto dl = index.within("fomr", 1, edit_metric::damerau_levenshtein);
+    EXPECT_TRUE(lev.empty());
+    ASSERT_EQ(dl.size(), 1UL);
+    EXPECT_EQ(index[dl[0].index], "form");
+}
+
+TEST(SymSpellIndexTest, DistanceCappedAtBuildDistance) {
+    symspell_index index({"abcdef"}, 1);
+    EXPECT_EQ(index.max_distance(), 1UL);
+    EXPECT_FALSE(index.closest("abcxyz", 5).has_value());
+    EXPECT_TRUE(index.closest("abcdez", 5).has_value());
+}
+
+TEST(SymSpellIndexTest, MatchesLinearScan) {
+    std::mt19937 gen(31);
+    auto dictionary = random_words(gen, 2000, 8, 5);
+    symspell_index index(dictionary, 2);
+
+    for (auto metric : {edit_metric::levenshtein, edit_metric::damerau_levenshtein}) {
+        for (auto const& q : random_words(gen, 200, 9, 5)) {
+            for (size_t k : {0UL, 1UL, 2UL}) {
+                auto expected = linear_within(dictionary, q, k, metric);
+                ASSERT_EQ(index.within(q, k, metric), expected) << q << " k=" << k;
+
+                auto best = index.closest(q, k, metric);
+                ASSERT_EQ(best.has_value(), !expected.empty());
+                if (best) {
+                    EXPECT_EQ(*best, expected.front()) << q << " k=" << k;
+                }
+            }
+        }
+    }
+}
+
+TEST(SymSpellIndexTest, SaveAndLoadRoundTrip) {
+    std::mt19937 gen(5);
+    auto dictionary = random_words(gen, 500, 7, 5);
+    symspell_index index(dictionary, 2);
+
+    std::stringstream buffer;
+    ASSERT_TRUE(index.save(buffer));
+    auto loaded = symspell_index::load(buffer);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->size(), index.size());
+    EXPECT_EQ(loaded->max_distance(), 2UL);
+
+    for (auto const& q : random_words(gen, 100, 8, 5)) {
+        EXPECT_EQ(loaded->within(q, 2), index.within(q, 2)) << q;
+    }
+}
+
+TEST(SymSpellIndexTest, SaveAndLoadFile) {
+    symspell_index index({"alpha", "beta", "gamma"}, 1);
+    std::string path = ::testing::TempDir() + "symspell_index_test.bin";
+    ASSERT_TRUE(index.save(path));
+    auto loaded = symspell_index::load(path);
+    std::remove(path.c_str());
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ((*loaded)[loaded->closest("gama", 1)->index], "gamma");
+    EXPECT_FALSE(symspell_index::load(path).has_value());
+}
+
+TEST(SymSpellIndexTest, SlotHashIsStable) {
+    // Saved files store these hashes, so a change here breaks old files
+    EXPECT_EQ(alga::detail::hash_bytes(""), 0xf52a15e9a9b5e89bULL);
+    EXPECT_EQ(alga::detail::hash_bytes("symspell"), 0x896a61915b7b194bULL);
+}
+
+TEST(SymSpellIndexTest, TableFieldsStayInThe32BitRange) {
+    // Word ids, word offsets and posting ranges are stored in 32 bits; a
+    // dictionary large enough to overflow them cannot be built in a test
+    constexpr size_t max = std::numeric_limits<uint32_t>::max();
+    EXPECT_EQ(similarity::detail::checked_u32(max, "words"), max);
+    EXPECT_EQ(similarity::detail::checked_u32(0, "words"), 0U);
+    EXPECT_THROW(similarity::detail::checked_u32(max + 1, "words"), std::length_error);
+}
+
+TEST(SymSpellIndexTest, LoadRejectsMalformedInput) {
+    std::stringstream garbage("not an index at all");
+    EXPECT_FALSE(symspell_index::load(garbage).has_value());
+
+    symspell_index index({"alpha", "beta"}, 1);
+    std::stringstream buffer;
+    index.save(buffer);
+    std::string bytes = buffer.str();
+    std::stringstream truncated(bytes.substr(0, bytes.size() / 2));
+    EXPECT_FALSE(symspell_index::load(truncated).has_value());
+}
+
+namespace {
+    template<typename T>
+    void put(std::string& out, T const& value) {
+        out.append(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    // A file in save()'s layout, with one word "a" and the given slot table
+    std::string handmade_index(uint32_t blob_size, std::vector<std::array<uint64_t, 2>> const& slots) {
+        std::string out;
+        put(out, uint64_t{0x314d5953'41474c41ULL});
+        put(out, uint32_t{1});
+        put(out, uint64_t{2});
+        put(out, uint32_t{0});
+        put(out, blob_size);
+        put(out, uint64_t{blob_size});
+        out += "a";
+        put(out, uint64_t{slots.size()});
+        for (auto const& [hash, begin_count] : slots) {
+            put(out, hash);
+            put(out, begin_count);
+        }
+        put(out, uint64_t{1});
+        put(out, uint32_t{0});
+        return out;
+    }
+}
+
+TEST(SymSpellIndexTest, LoadRejectsCorruptTables) {
+    // Well-formed apart from the corruption under test
+    const uint64_t one_posting = uint64_t{1} << 32;  // begin 0, count 1
+    std::stringstream valid(handmade_index(1, {{6, one_posting}, {0, 0}}));
+    EXPECT_TRUE(symspell_index::load(valid).has_value());
+
+    // No empty slot: find() would never stop probing
+    std::stringstream full(handmade_index(1, {{7, one_posting}, {8, one_posting}}));
+    EXPECT_FALSE(symspell_index::load(full).has_value());
+
+    // An occupied slot that its own probe chain cannot reach
+    std::stringstream unreachable(handmade_index(1, {{0, 0}, {8, one_posting}}));
+    EXPECT_FALSE(symspell_index::load(unreachable).has_value());
+
+    // A word blob far larger than the stream is rejected before allocating
+    std::stringstream huge(handmade_index(0xffffffffU, {{6, one_posting}, {0, 0}}));
+    EXPECT_FALSE(symspell_index::load(huge).has_value());
+}
+
+TEST(SymSpellIndexTest, MatcherBackends) {
+    auto index = std::make_shared<const symspell_index>(
+        std::vector<std::string>{"apple", "banana", "cherry"}, 2);
+
+    auto choice = fuzzy::fuzzy_choice(index, 2);
+    std::string input = "aple pie";
+    auto [pos, result] = choice.parse(input.begin(), input.end());
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(*result, "apple");
+    EXPECT_EQ(*pos, ' ');
+
+    auto dl = fuzzy::fuzzy_match_dl(index, 1);
+    std::string swapped = "bnaana";
+    auto [pos2, r2] = dl.parse(swapped.begin(), swapped.end());
+    ASSERT_TRUE(r2.has_value());
+    EXPECT_EQ(*r2, "banana");
+
+    std::string far = "grape";
+    auto [pos3, r3] = choice.parse(far.begin(), far.end());
+    EXPECT_FALSE(r3.has_value());
+    EXPECT_EQ(pos3, far.begin());
+}